@@ -5,18 +5,32 @@
 #include <rcl/error_handling.h>
 #include <rclc/rclc.h>
 #include <rclc/executor.h>
+#include <rclc/action_server.h>
 #include <std_msgs/msg/bool.h>
 #include <sensor_msgs/msg/nav_sat_fix.h>
+#include <diagnostic_msgs/msg/diagnostic_array.h>
+#include <beacon_interfaces/action/led_animation.h>
 #include "config.h"
+#include "StaticAllocator.h"
+#include "LEDAnimationController/LEDAnimationController.h"
 
 // Forward-Deklarationen
 class HatchManager;
 class GPSManager;
+class TimeSync;
+class TaskScheduler;
 
 // Error checking macros
 #define RCCHECK(fn)     { rcl_ret_t temp_rc = fn; if((temp_rc != RCL_RET_OK)){return false;}}
 #define RCSOFTCHECK(fn) { rcl_ret_t temp_rc = fn; if((temp_rc != RCL_RET_OK)){return false;}}
 
+// Schlüssel/Wert-Paare je Task in der Diagnosenachricht
+#define DIAGNOSTICS_VALUES 6
+#define DIAGNOSTICS_VALUE_LENGTH 192     // Reicht für ein Histogramm mit vollen 32-Bit-Zählern
+
+static_assert(LED_ANIMATION_GOAL_HANDLES > LED_LAYER_COUNT,
+              "LED_ANIMATION_GOAL_HANDLES: ein Ziel je Ebene plus ein nachfolgendes Ziel");
+
 class BeaconMicroROSInterface {
 public:
 
@@ -27,20 +41,39 @@ public:
         AGENT_DISCONNECTED
     } state;
 
-    BeaconMicroROSInterface(HatchManager* hatchManager, GPSManager* gpsManager);
+    BeaconMicroROSInterface(HatchManager* hatchManager, GPSManager* gpsManager, TimeSync* timeSync,
+                            LEDAnimationController* ledController, TaskScheduler* scheduler);
     
     void initialize();
-    void update();
+    void update();              // Wartet insgesamt höchstens ROS_BLOCKING_BUDGET_MS auf den Agenten
     bool processMessages();
     
     bool publishHatchStatus();
     bool publishGPSData();
+    bool publishAnimationFeedback();
+    bool publishDiagnostics();
     
     states getConnectionState() ;
+    bool isLinkDegraded() const;        // Verbunden, aber Pings zum Agenten schlagen fehl
+    
+    // Zeit, die loop() in blockierenden Agent-Aufrufen verbracht hat
+    struct BlockingStats {
+        uint32_t calls;
+        uint64_t total_us;
+        uint32_t max_us;
+        uint32_t last_us;
+    };
+    const BlockingStats& getBlockingStats() const;
+    
+    // Belegung der statischen rcl-Arena
+    const StaticAllocator& getArena() const;
     
 private:
     HatchManager* hatchManager;
     GPSManager* gpsManager;
+    TimeSync* timeSync;
+    LEDAnimationController* ledController;
+    TaskScheduler* scheduler;
     
    
     // MicroROS-Entitäten
@@ -48,23 +81,80 @@ private:
     rcl_node_t node;
     rclc_executor_t executor;
     rcl_allocator_t allocator;
+    StaticAllocator arena;
+    
+    // LED-Animation Action Server
+    rclc_action_server_t action_led_animation;
+    beacon_interfaces__action__LEDAnimation_SendGoal_Request goal_requests[LED_ANIMATION_GOAL_HANDLES];
+    // rclc sendet das Ergebnis erst auf Anfrage des Clients, bis dahin gehört die Nachricht dem Goal-Handle
+    beacon_interfaces__action__LEDAnimation_GetResult_Response goal_results[LED_ANIMATION_GOAL_HANDLES];
+    rclc_action_goal_handle_t* active_goals[LED_LAYER_COUNT];   // Laufendes Ziel je LED-Ebene
+    bool animation_accepted;            // Ergebnis des letzten startAnimation()-Aufrufs
+    float animation_progress[LED_LAYER_COUNT];    // Letzte Rückmeldung des Controllers je Ebene
+    AnimationStatus animation_status[LED_LAYER_COUNT];
     
     // Publishers
     rcl_publisher_t pub_hatch_is_open;
+    rcl_publisher_t pub_hatch_left;
+    rcl_publisher_t pub_hatch_right;
     rcl_publisher_t pub_gps;
+    rcl_publisher_t pub_diagnostics;
     
     // Messages
     std_msgs__msg__Bool msg_hatch_is_open;
+    std_msgs__msg__Bool msg_hatch_left;
+    std_msgs__msg__Bool msg_hatch_right;
     sensor_msgs__msg__NavSatFix msg_gps;
+    beacon_interfaces__action__LEDAnimation_FeedbackMessage msg_animation_feedback;
+    
+    // Diagnose: ein DiagnosticStatus je Nachricht, alle Texte in festen Puffern
+    diagnostic_msgs__msg__DiagnosticArray msg_diagnostics;
+    diagnostic_msgs__msg__DiagnosticStatus diagnostics_status;
+    diagnostic_msgs__msg__KeyValue diagnostics_values[DIAGNOSTICS_VALUES];
+    char diagnostics_name[24];
+    char diagnostics_message[48];
+    char diagnostics_text[DIAGNOSTICS_VALUES][DIAGNOSTICS_VALUE_LENGTH];
+    uint8_t diagnostics_task;                           // Als Nächstes gemeldeter Task
+    uint32_t diagnostics_faults[SCHEDULER_MAX_TASKS];   // Overruns + verpasste Deadlines bei der letzten Meldung
     
     // Status
-    int ping_timeout_ms;
+    elapsedMillis ping_timer;
+    elapsedMillis sync_timer;
+    uint32_t ping_interval_ms;
+    uint8_t ping_failures;
+    uint8_t create_step;            // Nächste anzulegende Entität in AGENT_AVAILABLE
+    BlockingStats blocking_stats;
+    uint32_t budget_start_us;       // Beginn des laufenden update(), ab hier zählt das Budget
     elapsedMillis last_publish_hatch;
     elapsedMillis last_publish_gps;
+    uint32_t last_hatch_sequence;   // Zuletzt gesendeter Klappenzustand
+    elapsedMillis last_publish_feedback;
+    uint32_t last_gps_sequence;     // Zuletzt gesendete GNSS-Epoche
+    elapsedMillis last_publish_diagnostics;
 
-    int64_t time_ms;
-    
     // Hilfsmethoden
-    bool createEntities();
+    static const uint8_t CREATE_STEPS = 9;
+    bool createNextEntity();
+    rcl_ret_t createPublisher(rcl_publisher_t& publisher, const rosidl_message_type_support_t* type_support,
+                              const char* topic_name);
     bool destroyEntities();
+    void resetEntities();
+    void reportArena(const char* label);
+    bool pingAgent();
+    void syncTime();
+    void recordBlocking(uint32_t start_us);
+    uint32_t remainingBudgetMs() const;
+    rcl_ret_t publishReliable(rcl_publisher_t& publisher, const void* message);
+    uint32_t timeSyncInterval() const;
+    static void setStamp(builtin_interfaces__msg__Time& stamp, int64_t time_ns);
+    static void setString(rosidl_runtime_c__String& string, char* buffer, size_t capacity);
+    void initDiagnosticsMessage();
+    void finishAnimationGoal(uint8_t layer, rcl_action_goal_state_t goal_state, AnimationStatus final_status);
+    
+    // Callbacks für rclc und den LEDAnimationController (ohne Kontextzeiger)
+    static BeaconMicroROSInterface* instance;
+    static rcl_ret_t onAnimationGoal(rclc_action_goal_handle_t* goal_handle, void* context);
+    static bool onAnimationCancel(rclc_action_goal_handle_t* goal_handle, void* context);
+    static void onAnimationFeedback(uint8_t layer, float progress, AnimationStatus status);
+    static void onAnimationResult(uint8_t layer, bool success, AnimationStatus finalStatus);
 };
@@ -1,29 +1,82 @@
 #pragma once
 #include <Arduino.h>
-#include <TinyGPSPlus.h>
 #include "config.h"
 #include "NavSatFixData.h"
+#include "SPSCRingBuffer.h"
+#include "NMEAParser.h"
+#include "UBXParser.h"
+#include "TimeSync.h"
 
 class GPSManager {
 public:
+    // Benachrichtigung bei jeder neuen GNSS-Epoche
+    typedef void (*NewFixCallback)(const NavSatFixData& data, uint32_t sequence);
+    
     GPSManager();
     void begin(HardwareSerial& serial, unsigned long baud);
+    // Empfangs-ISR starten, erst direkt bevor der Scheduler update() aufruft
+    void start();
     void update();
     bool hasValidFix() const;
     const NavSatFixData& getNavSatFixData() const;
     
+    // Monoton steigende Nummer der zuletzt abgeschlossenen Epoche
+    uint32_t getFixSequence() const;
+    // Lokaler Empfangsbeginn (micros()) der zuletzt abgeschlossenen Epoche
+    uint32_t getEpochArrivalMicros() const;
+    // PPS-Flanke, die beim Empfangsbeginn dieser Epoche zuletzt erfasst war
+    const TimeSync::PPSEdge& getEpochPPS() const;
+    void setNewFixCallback(NewFixCallback callback);
+    
+    // Statistik des Empfangspuffers
+    uint32_t getIngestOverflowCount() const;
+    uint32_t getIngestHighWaterMark() const;
+    uint32_t getBytesReceived() const;
+    uint32_t getChecksumErrorCount() const;
+    
 private:
-    TinyGPSPlus gps;
+    NMEAParser nmea;
+    UBXParser ubx;
     NavSatFixData navSatData;
+    bool fixValid;
+    
+    // Epochenerkennung
+    uint32_t fixSequence;
+    uint32_t lastEpochTime;
+    uint32_t epochArrivalMicros;
+    TimeSync::PPSEdge epochPPS;
+    NewFixCallback newFixCallback;
+    void commitEpoch(uint32_t epochTime);
+    void updateEpoch(uint8_t parsed, uint8_t ubxParsed);
     HardwareSerial* gpsSerial;
     
+    // Beginn eines Epochen-Bursts im Ringpuffer
+    struct IngestBurst {
+        uint32_t firstByte;         // Laufende Nummer des ersten Bytes (ingestBytes)
+        uint32_t startMicros;       // Lokaler Empfangsbeginn
+        TimeSync::PPSEdge pps;      // Zuletzt erfasste PPS-Flanke
+    };
+    
+    // Empfang: ISR (Producer) -> Ringpuffer -> update() (Consumer), dazu je Burst ein Eintrag
+    SPSCRingBuffer<uint8_t, GPS_INGEST_BUFFER_SIZE> ingestBuffer;
+    SPSCRingBuffer<IngestBurst, GPS_INGEST_BURSTS> burstQueue;
+    IntervalTimer ingestTimer;
+    static GPSManager* ingestInstance;
+    static void ingestISR();
+    volatile uint32_t ingestBytes;      // Bytes im Ringpuffer seit dem Start, nur die ISR schreibt
+    volatile uint32_t lastByteMicros;
+    IngestBurst currentBurst;           // Burst der gerade verarbeiteten Daten
+    
     void updateNavSatFixData();
+    void updateNavSatFixFromPVT();
     void checkSerialData();
     
+    // UBX-Konfiguration des Empfängers
+    bool configureUBX();
+    bool sendUBX(uint8_t msgClass, uint8_t msgId, const uint8_t* payload, uint16_t length);
+    bool waitForAck(uint8_t msgClass, uint8_t msgId, unsigned long timeout_ms);
+    
     unsigned long last_serial_check;
     uint32_t serial_bytes_received;
     uint32_t last_serial_bytes_count;
-    void handleNMEASentence(char c);
-    uint8_t nmea_idx = 0;
-    char nmea_buffer[100];
 };
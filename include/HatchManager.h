@@ -1,16 +1,53 @@
 #pragma once
 #include <Arduino.h>
 #include "config.h"
+#include "SPSCRingBuffer.h"
 
 class HatchManager {
 public:
+    enum Hatch {
+        HATCH_LEFT = 0,
+        HATCH_RIGHT = 1,
+        HATCH_COUNT = 2
+    };
+
     HatchManager(uint8_t leftPin, uint8_t rightPin);
     void begin();
     void update();
     bool isHatchOpen() const;
+    bool isHatchOpen(Hatch hatch) const;
+
+    // Wird bei jedem entprellten Zustandswechsel erhöht
+    uint32_t getChangeSequence() const;
+    // micros() der Flanke, die den letzten Wechsel ausgelöst hat
+    uint32_t getLastChangeMicros() const;
+
+    uint32_t getEventOverflowCount() const;
     
 private:
-    uint8_t leftPin;
-    uint8_t rightPin;
-    bool hatchOpen;
+    // Von der ISR erfasste Flanke
+    struct EdgeEvent {
+        uint32_t micros;
+        uint8_t hatch;
+        uint8_t level;
+    };
+
+    struct HatchState {
+        uint8_t pin;
+        bool open;                  // Entprellter Zustand
+        uint32_t lastChangeMicros;  // Beginn der Sperrzeit
+    };
+
+    HatchState hatches[HATCH_COUNT];
+    uint32_t changeSequence;
+    uint32_t lastChangeMicros;
+
+    SPSCRingBuffer<EdgeEvent, HATCH_EVENT_BUFFER_SIZE> events;
+
+    void applyLevel(Hatch hatch, bool open, uint32_t timestamp);
+
+    static HatchManager* isrInstance;
+    static void pushEdge(Hatch hatch);
+    static void leftISR();
+    static void rightISR();
 };
@@ -31,6 +31,17 @@ public:
      */
     virtual bool start() = 0;
     
+    /**
+     * @brief Startet die Animation zu einem vorgegebenen Zeitpunkt
+     * 
+     * Sequenzen starten Folgeschritte zum geplanten Zeitpunkt statt zum
+     * Zeitpunkt der Erkennung, damit sich Verspätungen nicht aufsummieren.
+     * 
+     * @param startTime Startzeitpunkt in Millisekunden (darf in der Vergangenheit liegen)
+     * @return true wenn der Start erfolgreich war
+     */
+    virtual bool startAt(uint32_t startTime) = 0;
+    
     /**
      * @brief Führt einen Animationsschritt aus
      * 
@@ -62,6 +73,15 @@ public:
      */
     virtual float getProgress() const = 0;
     
+    /**
+     * @brief Gibt den planmäßigen Endzeitpunkt zurück
+     * 
+     * Nur gültig, wenn isCompleted() true liefert.
+     * 
+     * @return Endzeitpunkt in Millisekunden
+     */
+    virtual uint32_t getEndTime() const = 0;
+    
     /**
      * @brief Gibt den Typ der Animation zurück
      * 
@@ -18,6 +18,11 @@ protected:
     float progress;              // Fortschritt der Animation (0.0 - 1.0)
     uint32_t lastUpdateTime;     // Zeitpunkt des letzten Updates
     uint32_t stepDuration;       // Dauer eines Animationsschritts
+    uint32_t startTime;          // Startzeitpunkt, Bezug für die zeitbasierten Schritte
+    uint32_t endTime;            // Planmäßiger Endzeitpunkt, gesetzt beim Abschluss
+    
+private:
+    static bool frameDirty;      // Gemeinsam für alle Animationen, auch bei kopiertem Kontext
 
     
 public:
@@ -34,6 +39,8 @@ public:
         , progress(0.0f)
         , lastUpdateTime(0)
         , stepDuration(20) 
+        , startTime(0)
+        , endTime(0)
         
 
     {
@@ -61,12 +68,25 @@ public:
      * @return true wenn der Start erfolgreich war
      */
     bool start() override {
+        return startAt(millis());
+    }
+    
+    /**
+     * @brief Startet die Animation zu einem vorgegebenen Zeitpunkt
+     * 
+     * @param time Startzeitpunkt in Millisekunden
+     * @return true wenn der Start erfolgreich war
+     */
+    bool startAt(uint32_t time) override {
         completed = false;
         cancelRequested = false;
         progress = 0.0f;
         // Setze die Schrittdauer basierend auf dem Geschwindigkeitsparameter
         stepDuration = context->cmd.speed > 0 ? context->cmd.speed : 20;
-        lastUpdateTime = millis();
+        lastUpdateTime = time;
+        startTime = time;
+        // Sofort abgeschlossene Animationen enden zum Startzeitpunkt
+        endTime = time;
         
         // Rufe die spezifische Start-Methode der abgeleiteten Klasse auf
         onStart();
@@ -102,6 +122,39 @@ public:
         return progress;
     }
     
+    /**
+     * @brief Gibt den planmäßigen Endzeitpunkt zurück
+     * 
+     * @return Endzeitpunkt in Millisekunden
+     */
+    uint32_t getEndTime() const override {
+        return endTime;
+    }
+    
+    /**
+     * @brief Prüft, ob seit der letzten Ausgabe in das LED-Array gezeichnet wurde
+     * 
+     * Animationen rufen FastLED.show() nicht selbst auf, der Controller gibt
+     * einen geänderten Frame einmal pro Frame-Takt aus.
+     */
+    static bool isFrameDirty() {
+        return frameDirty;
+    }
+    
+    /**
+     * @brief Wird vom Controller nach der Ausgabe aufgerufen
+     */
+    static void clearFrameDirty() {
+        frameDirty = false;
+    }
+    
+    /**
+     * @brief Markiert das LED-Array als geändert
+     */
+    static void markFrameDirty() {
+        frameDirty = true;
+    }
+    
 protected:
     /**
      * @brief Wird von setup() aufgerufen, kann in abgeleiteten Klassen überschrieben werden
@@ -118,6 +171,20 @@ protected:
      */
     virtual void onCancel() {}
     
+    /**
+     * @brief Schritt, der zum Zeitpunkt currentTime fällig ist
+     * 
+     * Die Schritte ergeben sich aus der Zeit seit dem Start, nicht aus der
+     * Anzahl der Aufrufe. Nach einer Verzögerung springt die Animation auf
+     * den fälligen Schritt, Dauer und Fortschritt bleiben exakt.
+     * 
+     * @param currentTime Aktuelle Zeit in Millisekunden
+     * @return Anzahl der seit dem Start vergangenen Schrittdauern
+     */
+    uint32_t dueStep(uint32_t currentTime) const {
+        return (currentTime - startTime) / stepDuration;
+    }
+    
     /**
      * @brief Hilfsmethode zum Dimmen aller LEDs
      * 
@@ -0,0 +1,265 @@
+#ifndef ANIMATION_LAYER_H
+#define ANIMATION_LAYER_H
+
+#include "AnimationRegistry.h"
+
+/**
+ * @brief Mischarten einer Überlagerung
+ */
+enum LayerBlendMode : uint8_t {
+    LAYER_BLEND_KEY = 0,   // Schwarz ist durchsichtig, die Deckkraft folgt der Helligkeit des Pixels
+    LAYER_BLEND_NORMAL     // Gleichmäßige Deckkraft, auch schwarze Pixel decken ab
+};
+
+/**
+ * @brief Eine Ebene des LED-Streifens
+ *
+ * Jede Ebene hat eigene Animationsobjekte, einen eigenen Kontext und
+ * zeichnet in einen eigenen Puffer. Der Controller legt die Ebenen vor jeder
+ * Ausgabe übereinander: die Basisebene wird kopiert, die Überlagerungen
+ * werden in aufsteigender Reihenfolge mit ihrer Deckkraft und Mischart
+ * darüber gemischt. Höhere Ebenen haben Vorrang.
+ *
+ * Eine Überlagerung verschwindet, sobald ihre Animation abgeschlossen oder
+ * abgebrochen ist. Die Basisebene läuft währenddessen weiter und ist danach
+ * ohne Neustart wieder sichtbar.
+ *
+ * Welche Animationen eine Ebene hat und ob sie Frames für ihre Befehle
+ * besitzt, legen BaseAnimationLayer und OverlayAnimationLayer fest.
+ */
+class AnimationLayer {
+public:
+    virtual ~AnimationLayer() = default;
+
+    // Initial Setup of all animations of this layer
+    virtual void setup() = 0;
+
+    // Animation dieser Ebene zu einem Befehl, nullptr wenn nicht unterstützt
+    virtual Animation* find(uint32_t cmd) const = 0;
+
+    // Freier Frame für einen neuen Befehl, nullptr wenn die Ebene keine Frames hat
+    virtual CRGB* nextFrame() = 0;
+
+    virtual void printFootprint(Print& out) const = 0;
+
+    // Kontext der Ebene, wird vom Controller mit dem neuen Befehl gefüllt
+    AnimationContext& getContext() {
+        return context;
+    }
+
+    /**
+     * @brief Übernimmt eine neue Animation, sie startet im nächsten Frame-Takt
+     *
+     * @return true wenn dabei eine laufende Animation abgebrochen wurde
+     */
+    bool replace(Animation* next) {
+        bool replaced = active;
+        if (replaced) {
+            animation->cancel();
+        }
+        animation = next;
+        pending = true;
+        active = true;
+        return replaced;
+    }
+
+    /**
+     * @brief Führt einen Schritt der Animation aus
+     *
+     * Einmalige Animationen werden nach ihrem Abschluss nicht mehr ausgeführt,
+     * ihr letzter Frame bleibt im Puffer der Ebene.
+     */
+    void run(uint32_t currentTime) {
+        if (!active) {
+            return;
+        }
+        if (pending) {
+            animation->startAt(currentTime);
+            pending = false;
+        }
+        animation->run(currentTime);
+        if (animation->isCompleted() && animation->getType() != ANIMATION_CONTINUOUS) {
+            deactivate();
+        }
+    }
+
+    // Bricht die Animation ab, die Ebene behält ihren letzten Frame
+    void cancel() {
+        if (active) {
+            animation->cancel();
+            deactivate();
+        }
+    }
+
+    // Bricht die Animation ab und löscht die Ebene
+    void stop() {
+        cancel();
+        clear();
+    }
+
+    // Löscht den Puffer der Ebene
+    void clear() {
+        fill_solid(pixels, NUM_LEDS, CRGB::Black);
+        AnimationBase::markFrameDirty();
+    }
+
+    void setBlend(LayerBlendMode mode, uint8_t opacity) {
+        blendMode = mode;
+        alpha = opacity;
+    }
+
+    bool isActive() const {
+        return active;
+    }
+
+    // Status des zuletzt auf dieser Ebene gestarteten Befehls, wird vom Controller gesetzt
+    AnimationStatus getStatus() const {
+        return status;
+    }
+
+    void setStatus(AnimationStatus newStatus) {
+        status = newStatus;
+    }
+
+    bool isRunning() const {
+        return status == STATUS_STARTED || status == STATUS_RUNNING || status == STATUS_RUNNING_CONTINUOUS;
+    }
+
+    AnimationType getType() const {
+        return animation != nullptr ? animation->getType() : ANIMATION_NONE;
+    }
+
+    float getProgress() const {
+        return animation != nullptr ? animation->getProgress() : 0.0f;
+    }
+
+    const CRGB* getPixels() const {
+        return pixels;
+    }
+
+    /**
+     * @brief Mischt die Ebene über out, solange ihre Animation läuft
+     *
+     * Eine Überlagerung, deren Animation noch nicht gestartet ist, bleibt
+     * unsichtbar, damit kein alter Frame aufblitzt.
+     */
+    void drawOver(CRGB* out, uint16_t count) const {
+        if (!active || pending || alpha == 0) {
+            return;
+        }
+        if (blendMode == LAYER_BLEND_NORMAL) {
+            for (uint16_t i = 0; i < count; i++) {
+                nblend(out[i], pixels[i], alpha);
+            }
+            return;
+        }
+        for (uint16_t i = 0; i < count; i++) {
+            const CRGB& p = pixels[i];
+            // Helligkeit als größter Kanal, wie der V-Wert in HSV
+            uint8_t level = max(p.r, max(p.g, p.b));
+            if (level != 0) {
+                nblend(out[i], p, scale8(level, alpha));
+            }
+        }
+    }
+
+protected:
+    AnimationLayer()
+        : animation(nullptr)
+        , pending(false)
+        , active(false)
+        , status(STATUS_IDLE)
+        , blendMode(LAYER_BLEND_KEY)
+        , alpha(255) {
+        fill_solid(pixels, NUM_LEDS, CRGB::Black);
+    }
+
+    CRGB pixels[NUM_LEDS];        // Puffer, in den die Animationen dieser Ebene zeichnen
+    AnimationContext context;     // Kontext der Ebene
+
+private:
+    // Eine Überlagerung verschwindet, die Ebenen darunter werden neu gemischt
+    void deactivate() {
+        active = false;
+        AnimationBase::markFrameDirty();
+    }
+
+    Animation* animation;         // Animation der Ebene, nullptr bis zum ersten Befehl
+    bool pending;                 // Animation wartet auf den Start im nächsten Frame-Takt
+    bool active;                  // Animation läuft, Überlagerung ist sichtbar
+    AnimationStatus status;       // Status des Befehls dieser Ebene für Rückmeldung und Ergebnis
+    LayerBlendMode blendMode;
+    uint8_t alpha;                // Deckkraft der Überlagerung
+};
+
+/**
+ * @brief Basisebene mit allen Animationen
+ *
+ * Die Befehle der Basisebene referenzieren die beiden Frames des FrameStore,
+ * Überblendungen laufen vom Frame des gesicherten zum Frame des neuen Befehls.
+ */
+class BaseAnimationLayer : public AnimationLayer {
+public:
+    BaseAnimationLayer()
+        : animations(pixels, &context) {
+        fill_solid(frameStore.buffer[0], NUM_LEDS, CRGB::Black);
+        fill_solid(frameStore.buffer[1], NUM_LEDS, CRGB::Black);
+        context.cmd.Frame = frameStore.buffer[0];
+        context.saved.Frame = frameStore.buffer[1];
+    }
+
+    void setup() override {
+        animations.setup();
+    }
+
+    Animation* find(uint32_t cmd) const override {
+        return animations.find(cmd);
+    }
+
+    // Der Frame des gesicherten Befehls bleibt erhalten
+    CRGB* nextFrame() override {
+        return frameStore.other(context.saved.Frame);
+    }
+
+    void printFootprint(Print& out) const override {
+        animations.printFootprint(out);
+    }
+
+private:
+    FrameStore frameStore;
+    AnimationRegistry animations; // Eigene Animationsobjekte, zeichnen in pixels
+};
+
+/**
+ * @brief Überlagerung mit den Animationen der OverlayRegistry
+ *
+ * Diese Animationen zeichnen nur in den Puffer der Ebene, die Befehle einer
+ * Überlagerung haben daher keine Frames und die Ebene keinen FrameStore.
+ */
+class OverlayAnimationLayer : public AnimationLayer {
+public:
+    OverlayAnimationLayer()
+        : animations(pixels, &context) {
+    }
+
+    void setup() override {
+        animations.setup();
+    }
+
+    Animation* find(uint32_t cmd) const override {
+        return animations.find(cmd);
+    }
+
+    CRGB* nextFrame() override {
+        return nullptr;
+    }
+
+    void printFootprint(Print& out) const override {
+        animations.printFootprint(out);
+    }
+
+private:
+    OverlayRegistry animations;
+};
+
+#endif // ANIMATION_LAYER_H
@@ -18,36 +18,221 @@
 // Composite-Animationen
 #include "animations/WaitAnimation.h"
 #include "animations/CompositeAnimation.h"
-#include "animations/BlinkAnimation.h" 
-#include "animations/FadeBlinkAnimation.h" 
+#include "animations/BlinkAnimation.h"
+#include "animations/FadeBlinkAnimation.h"
 
+/**
+ * @brief Plätze der Animationen in der Registry
+ *
+ * Neue Animationen bekommen hier einen Platz, ein Member in AnimationRegistry
+ * und ihre Befehle in ANIMATION_BINDINGS.
+ */
+enum AnimationSlot : uint8_t {
+  SLOT_SET_COLOR = 0,
+  SLOT_ALL_OFF,
+  SLOT_CYCLONE,
+  SLOT_RGB_NOISE,
+  SLOT_BLINK,
+  SLOT_ALL_FADE_IN,
+  SLOT_RGB_RAINBOW,
+  SLOT_FADE_BLINK,
+  SLOT_COUNT,
+  SLOT_NONE = 0xFF
+};
+
+// Zuordnung Befehl -> Animation
+struct AnimationBinding {
+  AnimationCommand cmd;
+  AnimationSlot slot;
+};
+
+#define ANIMATION_BINDINGS                          \
+  {CMD_ALL_OFF,            SLOT_ALL_OFF},           \
+  {CMD_SET_COLOR,          SLOT_SET_COLOR},         \
+  {CMD_ALL_FADE_IN,        SLOT_ALL_FADE_IN},       \
+  {CMD_CYCLONE,            SLOT_CYCLONE},           \
+  {CMD_CONTINUOUS_CYCLONE, SLOT_CYCLONE},           \
+  {CMD_BLINK,              SLOT_BLINK},             \
+  {CMD_FADE_BLINK,         SLOT_FADE_BLINK},        \
+  {CMD_RGB_NOISE,          SLOT_RGB_NOISE},         \
+  {CMD_RGB_RAINBOW,        SLOT_RGB_RAINBOW}
+
+/**
+ * @brief Zur Übersetzungszeit aufgebaute Tabelle Befehl -> Platz
+ *
+ * Der Befehl kommt als ein Byte aus der Action, daher genügt eine Tabelle
+ * mit 256 Einträgen. Nicht belegte Befehle zeigen auf SLOT_NONE.
+ */
+struct AnimationCommandTable {
+  uint8_t slot[256];
+
+  constexpr AnimationCommandTable() : slot() {
+    constexpr AnimationBinding bindings[] = { ANIMATION_BINDINGS };
+    for (uint16_t i = 0; i < 256; i++) {
+      slot[i] = SLOT_NONE;
+    }
+    for (const AnimationBinding& b : bindings) {
+      slot[b.cmd] = b.slot;
+    }
+  }
+};
+
+// RAM-Bedarf einer Animation
+struct AnimationFootprint {
+  const char* name;
+  uint16_t bytes;
+};
+
+/**
+ * @brief Registry aller verfügbaren Animationen
+ *
+ * Alle Animation-Objekte sind Member der Registry und liegen damit statisch
+ * im Controller, der Heap wird nicht benutzt. Die Auswahl zu einem Befehl
+ * ist ein Tabellenzugriff statt einer Suche über supportsCommand().
+ *
+ * Mit -D LED_REPORT_ANIMATION_SIZES gibt der Compiler für jede Animation
+ * eine Warnung mit ihrer Größe aus, mit -D LED_ANIMATION_RAM_BUDGET=<Bytes>
+ * bricht der Build ab, wenn die Registry größer wird.
+ */
+class AnimationRegistry {
+public:
+  AnimationRegistry(CRGB* leds, AnimationContext* context)
+      : setColor(leds, context)
+      , allOff(leds, context)
+      , cyclone(leds, context)
+      , rgbNoise(leds, context)
+      , blink(leds, context)
+      , allFadeIn(leds, context)
+      , rgbRainbow(leds, context)
+      , fadeBlink(leds, context)
+      , slots{&setColor, &allOff, &cyclone, &rgbNoise, &blink, &allFadeIn, &rgbRainbow, &fadeBlink}
+  {
+  }
+
+  // Initial Setup of all animations... e.g. Animation pre-calculation or filling patternArray etc.
+  void setup() {
+    for (Animation* anim : slots) {
+      anim->setup();
+    }
+  }
+
+  // Animation zu einem Befehl, nullptr wenn keine Animation den Befehl unterstützt
+  Animation* find(uint32_t cmd) const {
+    if (cmd >= 256 || commandTable.slot[cmd] == SLOT_NONE) {
+      return nullptr;
+    }
+    return slots[commandTable.slot[cmd]];
+  }
+
+  void printFootprint(Print& out) const {
+    uint32_t total = 0;
+    for (const AnimationFootprint& f : footprint) {
+      out.printf("  %-12s %5u B\n", f.name, f.bytes);
+      total += f.bytes;
+    }
+    out.printf("  %-12s %5lu B (Registry %u B)\n", "Summe", (unsigned long)total, (unsigned)sizeof(AnimationRegistry));
+  }
+
+  static constexpr AnimationCommandTable commandTable{};
+  static constexpr AnimationFootprint footprint[SLOT_COUNT] = {
+    {"SetColor",   sizeof(SetColorAnimation)},
+    {"AllOff",     sizeof(AllOffAnimation)},
+    {"Cyclone",    sizeof(CycloneAnimation)},
+    {"RGBNoise",   sizeof(RGBNoiseAnimation)},
+    {"Blink",      sizeof(BlinkAnimation)},
+    {"AllFadeIn",  sizeof(AllFadeInAnimation)},
+    {"RGBRainbow", sizeof(RGBRainbowAnimation)},
+    {"FadeBlink",  sizeof(FadeBlinkAnimation)},
+  };
+
+private:
+  SetColorAnimation setColor;
+  AllOffAnimation allOff;
+  CycloneAnimation cyclone;
+  RGBNoiseAnimation rgbNoise;
+  BlinkAnimation blink;
+  AllFadeInAnimation allFadeIn;
+  RGBRainbowAnimation rgbRainbow;
+  FadeBlinkAnimation fadeBlink;
+
+  Animation* const slots[SLOT_COUNT];
+};
 
 /**
- * @brief Registriert alle verfügbaren Animationen beim Controller
- * 
- * Diese Funktion erzeugt alle Animation-Objekte und fügt sie
- * zur Registry des Controllers hinzu. Neue Animationen sollten
- * hier hinzugefügt werden.
- * 
- * @param controller Referenz auf den LED-AnimationController
- * @param leds Zeiger auf das LED-Array
- * @param context current Animation context
+ * @brief Animationen der Überlagerungen
+ *
+ * Überlagerungen bekommen nur die Animationen, die allein in den Puffer der
+ * Ebene zeichnen und keinen Frame aus dem FrameStore brauchen. Die Auswahl
+ * nutzt die Tabelle der AnimationRegistry, Plätze ohne Animation bleiben
+ * nullptr und der Befehl wird auf einer Überlagerung abgelehnt.
  */
-inline void registerAnimations(std::vector<Animation*>& animationRegistry, CRGB* leds, AnimationContext* context) {
-    animationRegistry.push_back(new SetColorAnimation(leds,context));
-    animationRegistry.push_back(new AllOffAnimation(leds, context));
-    animationRegistry.push_back(new CycloneAnimation(leds, context));
-    animationRegistry.push_back(new RGBNoiseAnimation(leds, context));
-    animationRegistry.push_back(new BlinkAnimation(leds, context)); 
-    animationRegistry.push_back(new AllFadeInAnimation(leds, context));
-    animationRegistry.push_back(new RGBRainbowAnimation(leds, context));
-    animationRegistry.push_back(new FadeBlinkAnimation(leds, context)); 
-       
-
-    /*
-    Knightrider AllFadeInAnimation with pixerl Start end offset?
-    
-    */
+class OverlayRegistry {
+public:
+  OverlayRegistry(CRGB* leds, AnimationContext* context)
+      : setColor(leds, context)
+      , allOff(leds, context)
+      , cyclone(leds, context)
+      , blink(leds, context)
+  {
+    slots[SLOT_SET_COLOR] = &setColor;
+    slots[SLOT_ALL_OFF] = &allOff;
+    slots[SLOT_CYCLONE] = &cyclone;
+    slots[SLOT_BLINK] = &blink;
+  }
+
+  void setup() {
+    for (Animation* anim : slots) {
+      if (anim != nullptr) {
+        anim->setup();
+      }
+    }
+  }
+
+  Animation* find(uint32_t cmd) const {
+    if (cmd >= 256 || AnimationRegistry::commandTable.slot[cmd] == SLOT_NONE) {
+      return nullptr;
+    }
+    return slots[AnimationRegistry::commandTable.slot[cmd]];
+  }
+
+  void printFootprint(Print& out) const {
+    out.printf("  %-12s %5u B (SetColor, AllOff, Cyclone, Blink)\n", "Overlay", (unsigned)sizeof(OverlayRegistry));
+  }
+
+private:
+  SetColorAnimation setColor;
+  AllOffAnimation allOff;
+  CycloneAnimation cyclone;
+  BlinkAnimation blink;
+
+  Animation* slots[SLOT_COUNT] = {};
+};
+
+#ifdef LED_ANIMATION_RAM_BUDGET
+static_assert(sizeof(AnimationRegistry) <= LED_ANIMATION_RAM_BUDGET,
+              "AnimationRegistry: RAM-Budget der Animationen überschritten");
+#endif
+
+#ifdef LED_REPORT_ANIMATION_SIZES
+// Die Warnung nennt den Typ und seine Größe, z.B. "ReportAnimationSize<CycloneAnimation, 64>"
+template <typename T, size_t BYTES = sizeof(T)>
+struct ReportAnimationSize {
+  __attribute__((deprecated("RAM-Bedarf der Animation, siehe BYTES")))
+  static constexpr size_t report() { return BYTES; }
+};
+
+inline void reportAnimationSizes() {
+  (void)ReportAnimationSize<SetColorAnimation>::report();
+  (void)ReportAnimationSize<AllOffAnimation>::report();
+  (void)ReportAnimationSize<CycloneAnimation>::report();
+  (void)ReportAnimationSize<RGBNoiseAnimation>::report();
+  (void)ReportAnimationSize<BlinkAnimation>::report();
+  (void)ReportAnimationSize<AllFadeInAnimation>::report();
+  (void)ReportAnimationSize<RGBRainbowAnimation>::report();
+  (void)ReportAnimationSize<FadeBlinkAnimation>::report();
+  (void)ReportAnimationSize<AnimationRegistry>::report();
+  (void)ReportAnimationSize<OverlayRegistry>::report();
 }
+#endif
 
 #endif // ANIMATIONSREGISTRY_H
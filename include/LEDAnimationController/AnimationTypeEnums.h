@@ -29,9 +29,20 @@ enum ParameterBits {
   // Animation Start with LED's off
   PAR_START_FROM_BLACK = 0x2,
   // Color specific
-  PAR_USE_HSV_COLOR = 0x4
+  PAR_USE_HSV_COLOR = 0x4,
+  // Transitions: ease in/out instead of linear
+  PAR_EASE_IN_OUT = 0x8,
+  // Transitions: blend in linear light (gamma corrected)
+  PAR_GAMMA_BLEND = 0x10,
+  // Layer of the animation, bits 5..6: 0 = base layer, 1..2 = overlays (higher on top), 3 is revoked
+  PAR_LAYER_LOW = 0x20,
+  PAR_LAYER_HIGH = 0x40,
+  // Overlays: uniform opacity, black pixels cover the layers below
+  PAR_LAYER_OPAQUE = 0x80
 };
 
+#define PAR_LAYER_SHIFT 5  // Shift of the layer index within the modifier
+
 // Enum for animation parameter indices
 enum AnimationParams {
   PARAM_RED = 0,
@@ -95,6 +106,20 @@ struct CMD_para {
    * When false, uses RGB color space (default)
    */
   bool useHue = false;
+  
+  /**
+   * Controls the curve of transitions (e.g. fades)
+   * When true, transitions ease in and out (cubic)
+   * When false, transitions are linear (default)
+   */
+  bool easeInOut = false;
+  
+  /**
+   * Controls how transitions mix colors
+   * When true, colors are blended in linear light (gamma corrected)
+   * When false, the 8-bit values are blended directly (default)
+   */
+  bool gammaBlend = false;
 };
 
 /**
@@ -107,8 +132,11 @@ struct CMD_struct {
   /** RGB color value for the animation */
   CRGB Color = CRGB::Black;
   
-  /** Array of RGB values for each LED in the animation sequence */
-  CRGB Frame[NUM_LEDS] = {CRGB::Black};
+  /**
+   * RGB values for each LED in the animation sequence
+   * Points into the shared FrameStore, the command itself holds no frame
+   */
+  CRGB* Frame = nullptr;
   
   /** Animation parameters (direction, starting state, color mode) */
   CMD_para para;
@@ -123,7 +151,22 @@ struct CMD_struct {
    * Multi-purpose tag that has different functions for different animations
    * Check specific animation documentation for usage details
    */
-  uint8_t MultiUseTag1;
+  uint8_t MultiUseTag1 = 0;
+};
+
+/**
+ * Shared frame storage for the animation commands
+ * Holds the target frame of the current command and of the saved command.
+ * A new command reuses the buffer the saved command no longer references,
+ * so commands and contexts can be copied without copying any frame.
+ */
+struct FrameStore {
+  CRGB buffer[2][NUM_LEDS];
+
+  /** Returns the buffer that is not referenced by inUse */
+  CRGB* other(const CRGB* inUse) {
+    return inUse == buffer[0] ? buffer[1] : buffer[0];
+  }
 };
 
 /**
@@ -140,6 +183,7 @@ struct AnimationContext {
   /**
    * Backup of animation state saved at initialization
    * Used to restore settings or as reference for transitions
+   * Its Frame is the previous command's frame, not a copy of it
    */
   CMD_struct saved;
   
@@ -147,7 +191,7 @@ struct AnimationContext {
    * Total number of LEDs in the array
    * Used for bounds checking and iteration
    */
-  uint8_t numLeds = NUM_LEDS;
+  uint16_t numLeds = NUM_LEDS;
 };
 
 #endif // ANIMATION_TYPEENUM_H
\ No newline at end of file
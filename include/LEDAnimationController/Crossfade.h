@@ -0,0 +1,106 @@
+#ifndef CROSSFADE_H
+#define CROSSFADE_H
+
+#include <Arduino.h>
+#include <FastLED.h>
+
+/**
+ * @brief Verlaufskurven für Überblendungen
+ */
+enum CrossfadeEasing : uint8_t {
+    EASE_LINEAR = 0,
+    EASE_IN_OUT_QUAD,
+    EASE_IN_OUT_CUBIC
+};
+
+/**
+ * @brief Festkomma-Überblendung zwischen zwei Frames
+ *
+ * Pro Frame wird einmal der Überblendanteil als Q16 berechnet (eine
+ * Division), danach werden alle LEDs mit 8-Bit-Skalierung gemischt.
+ * Optional wird im linearen Lichtraum gemischt (Gamma 2.0: Quadrat beim
+ * Dekodieren, sqrt16 beim Kodieren), damit dunkle Zwischenstufen nicht
+ * zu früh hell werden.
+ *
+ * Kann von jeder Animation für Übergänge verwendet werden.
+ */
+class Crossfade {
+public:
+    Crossfade()
+        : easing(EASE_LINEAR)
+        , gammaCorrect(false) {
+    }
+
+    void setEasing(CrossfadeEasing curve) {
+        easing = curve;
+    }
+
+    void setGammaCorrect(bool enable) {
+        gammaCorrect = enable;
+    }
+
+    /**
+     * @brief Überblendanteil für Schritt step von total als Q16, inkl. Verlaufskurve
+     *
+     * 0 = nur Quelle, 0xFFFF = Ziel (bzw. total == 0 oder step >= total)
+     */
+    uint16_t fraction(uint16_t step, uint16_t total) const {
+        if (total == 0 || step >= total) {
+            return 0xFFFF;
+        }
+        uint16_t f = ((uint32_t)step << 16) / total;
+        switch (easing) {
+            case EASE_IN_OUT_QUAD:
+                return ease16InOutQuad(f);
+            case EASE_IN_OUT_CUBIC:
+                return ease16InOutCubic(f);
+            default:
+                return f;
+        }
+    }
+
+    /**
+     * @brief Mischt from und to mit dem Anteil amount (Q16) nach out
+     *
+     * out darf mit from oder to identisch sein.
+     */
+    void apply(CRGB* out, const CRGB* from, const CRGB* to, uint16_t count, uint16_t amount) const {
+        if (amount == 0xFFFF) {
+            memmove(out, to, count * sizeof(CRGB));
+            return;
+        }
+        if (gammaCorrect) {
+            blendLinearLight(out, from, to, count, amount);
+        } else {
+            blend(from, to, out, count, amount >> 8);
+        }
+    }
+
+private:
+    CrossfadeEasing easing;
+    bool gammaCorrect;
+
+    // Kubische Verlaufskurve 3x^2 - 2x^3 = x^2 (3 - 2x) in Q16
+    // In 64 Bit ohne Zwischenrundung: monoton und höchstens 0xFFFF, auch für x nahe 0xFFFF
+    static uint16_t ease16InOutCubic(uint16_t x) {
+        uint64_t y = (uint64_t)((uint32_t)x * x) * (3 * 0x10000 - 2 * (uint32_t)x);
+        return (uint16_t)(y >> 32);
+    }
+
+    static uint8_t mixLinear(uint8_t a, uint8_t b, uint16_t amount) {
+        int32_t la = (uint16_t)a * a;
+        int32_t lb = (uint16_t)b * b;
+        // Q15, damit das Produkt in 32 Bit passt
+        return sqrt16((uint16_t)(la + (((lb - la) * (int32_t)(amount >> 1)) >> 15)));
+    }
+
+    static void blendLinearLight(CRGB* out, const CRGB* from, const CRGB* to, uint16_t count, uint16_t amount) {
+        for (uint16_t i = 0; i < count; i++) {
+            out[i].r = mixLinear(from[i].r, to[i].r, amount);
+            out[i].g = mixLinear(from[i].g, to[i].g, amount);
+            out[i].b = mixLinear(from[i].b, to[i].b, amount);
+        }
+    }
+};
+
+#endif // CROSSFADE_H
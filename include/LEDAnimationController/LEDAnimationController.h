@@ -3,19 +3,22 @@
 
 #include <Arduino.h>
 #include <WS2812Serial.h>
-#define USE_WS2812SERIAL
 #include <FastLED.h>
-#include <vector>
 
 // LED-Konfiguration
 #define NUM_LEDS 36 
 #define DATA_PIN 1
+#define LED_FRAME_INTERVAL_US 10000  // Frame-Takt der Ausgabe (100 Hz)
+#define LED_OVERLAY_LAYERS 2         // Überlagerungen über der Basisebene
+#define LED_LAYER_COUNT (1 + LED_OVERLAY_LAYERS)
 
 #define PARAM_COUNT  8  // Gesamtzahl der Parameter
 
 // Einbinden der gemeinsamen Typen und Definitionen
 #include "LEDAnimationController/AnimationTypeEnums.h"
 #include "LEDAnimationController/AnimationRegistry.h"
+#include "LEDAnimationController/AnimationLayer.h"
+#include "LEDAnimationController/WS2812SerialController.h"
 
 // Forward declare Animation class to avoid circular dependency
 class Animation;
@@ -24,8 +27,19 @@ class Animation;
  * @brief Controller für LED-Animationen
  * 
  * Diese Klasse verwaltet LED-Animationen über ein objektorientiertes Framework.
- * Sie verwendet eine Registry von Animationsobjekten und delegiert die
+ * Sie verwendet eine statische Registry von Animationsobjekten und delegiert die
  * Animationslogik an spezialisierte Klassen.
+ *
+ * Die Animationen laufen in Ebenen: eine Basisebene und LED_OVERLAY_LAYERS
+ * Überlagerungen, ausgewählt über die Bits PAR_LAYER_* im Modifier. Bei einer
+ * Überlagerung gibt PARAM_BRIGHTNESS die Deckkraft an statt der globalen
+ * Helligkeit. Ein Befehl ersetzt nur die Animation seiner Ebene. Auf den
+ * Überlagerungen laufen nur SetColor, AllOff, Cyclone und Blink, andere
+ * Befehle werden dort abgelehnt.
+ *
+ * Jede Ebene hat ihren eigenen Status, Rückmeldung und Ergebnis nennen die
+ * Ebene. getStatus(), getCurrentProgress() und der Event-Callback beziehen
+ * sich auf den zuletzt gestarteten Befehl.
  */
 class LEDAnimationController {
 public:
@@ -33,11 +47,10 @@ public:
   typedef void (*AnimationEventCallback)(AnimationStatus);
   
   // Action Server callback support
-  typedef void (*AnimationFeedbackCallback)(float progress, AnimationStatus status);
-  typedef void (*AnimationResultCallback)(bool success, AnimationStatus finalStatus);
+  typedef void (*AnimationFeedbackCallback)(uint8_t layer, float progress, AnimationStatus status);
+  typedef void (*AnimationResultCallback)(uint8_t layer, bool success, AnimationStatus finalStatus);
 
   LEDAnimationController();
-  ~LEDAnimationController(); // Add destructor to clean up
   
   // Main methods
   void begin();               // Setup of the Controller, sets all LED's to Black
@@ -45,6 +58,7 @@ public:
   void update();                    // Call this in every loop iteration
   bool cancelCurrentAnimation();    // Aborts the current Animation
   bool stopCurrentAnimation();      // Aborts the current Animation but sets all LED's to Black
+  bool cancelAnimation(uint8_t layer); // Aborts the Animation of one layer
   
   
   // Status getters for action server integration
@@ -52,6 +66,9 @@ public:
   bool isAnimationRunning();
   bool isAnimationComplete();
   float getCurrentProgress() const;
+  AnimationStatus getStatus(uint8_t layer) const;   // Status of one layer, STATUS_ERROR for unknown layers
+  float getProgress(uint8_t layer) const;
+  static uint8_t layerOf(const uint8_t* params);     // Layer selected by the modifier of a command
   
    
   // Set callback for animation events
@@ -68,26 +85,41 @@ public:
   
   // Additional helper function to check parameter state
   bool getParaValue(uint8_t parabyte, ParameterBits parameter);
+  
+  // Output statistics
+  uint32_t getFrameCount() const;         // Frames sent to the strip
+  uint32_t getDeferredFrameCount() const; // Frame ticks where both frame buffers were still in use
+  void printAnimationFootprint(Print& out) const; // RAM used by each registered animation and layer
 
 private:
 
   CRGB leds[NUM_LEDS];       // Define the array of leds
+  
+  // LED output: one show() per dirty frame, encoded while the previous frame is still on the wire
+  WS2812SerialController<DATA_PIN, NUM_LEDS, RGB> ledDriver;
+  elapsedMicros frameTimer;
+  uint32_t frameCount;
+  uint32_t deferredFrameCount;
+  
+  void runAnimation();
+  void runLayer(uint8_t index, uint32_t currentTime);
+  bool cancelLayer(uint8_t index, bool clear);
+  void composeFrame();
+  void presentFrame(bool frameTick);
 
   // Event callbacks
   AnimationEventCallback eventCallback;
   AnimationFeedbackCallback feedbackCallback;
   AnimationResultCallback resultCallback;
     
-  // The animation context as a class member
-  AnimationContext context;
   AnimationStatus status;          // Current animation status
   
-  // Animation registry and current animation
-  std::vector<Animation*> animationRegistry;
-  Animation* currentAnimation;
-  
-  // Register all animations
-  void registerAnimations();
+  // Layer stack, layers[0] is the base layer. Each layer has its own animations and context,
+  // only the base layer holds frames and all animations, overlays get the OverlayRegistry
+  BaseAnimationLayer baseLayer;
+  OverlayAnimationLayer overlayLayers[LED_OVERLAY_LAYERS];
+  AnimationLayer* layers[LED_LAYER_COUNT];
+  uint8_t currentLayer;            // Layer of the last started command, LED_LAYER_COUNT before the first
 
   // Then create a helper method to call the callback and handle the status
 
@@ -100,10 +132,15 @@ private:
       if (eventCallback != nullptr) { eventCallback(status); }
   }
 
+ // Status of one layer, the global status follows the layer of the last started command
+ void UpdateStatus(uint8_t index, AnimationStatus newStatus) {
+      layers[index]->setStatus(newStatus);
+      if (index == currentLayer) { UpdateStatus(status, newStatus); }
+  }
 
- void ReportStatus(CmdFeedback value) {   
+ void ReportStatus(uint8_t index, CmdFeedback value) {   
       if (resultCallback != nullptr) { 
-        resultCallback(value == STATUS_ACCEPTED, status);
+        resultCallback(index, value == STATUS_ACCEPTED, index < LED_LAYER_COUNT ? layers[index]->getStatus() : STATUS_ERROR);
       }
   }
  
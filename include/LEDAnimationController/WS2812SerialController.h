@@ -0,0 +1,72 @@
+#ifndef WS2812SERIAL_CONTROLLER_H
+#define WS2812SERIAL_CONTROLLER_H
+
+#include <Arduino.h>
+#include <WS2812Serial.h>
+#include <FastLED.h>
+
+/**
+ * @brief FastLED-Controller für WS2812Serial mit statischen Puffern
+ *
+ * Ersetzt den FastLED-eigenen WS2812Serial-Controller, der seine Puffer per
+ * malloc anlegt und bei laufendem DMA in show() wartet. WS2812Serial läuft
+ * doppelt gepuffert: der nächste Frame wird kodiert, während der vorherige
+ * noch übertragen wird. Der Aufrufer prüft vor FastLED.show() mit isBusy(),
+ * ob ein Frame-Puffer frei ist, und ruft poll() regelmäßig auf.
+ *
+ * @tparam OUTPUT_PIN Ausgangspin (TX eines UARTs)
+ * @tparam LED_COUNT Anzahl der LEDs
+ * @tparam RGB_ORDER Farbreihenfolge, in der FastLED die Pixel liefert
+ */
+template <uint8_t OUTPUT_PIN, uint16_t LED_COUNT, EOrder RGB_ORDER>
+class WS2812SerialController : public CPixelLEDController<RGB_ORDER, 8, 0xFF> {
+public:
+    WS2812SerialController()
+        : serial(LED_COUNT, frameBuffer, frameBuffer2, drawBuffer, OUTPUT_PIN, WS2812_RGB)
+        , started(false)
+    {
+    }
+
+    void init() override {
+        if (!started) {
+            started = serial.begin();
+        }
+    }
+
+    // true, solange noch ein kodierter Frame auf den freien Bus wartet
+    bool isBusy() {
+        return started && serial.framePending();
+    }
+
+    // Startet einen wartenden Frame, sobald DMA und Reset-Pause beendet sind
+    void poll() {
+        if (started) {
+            serial.poll();
+        }
+    }
+
+protected:
+    void showPixels(PixelController<RGB_ORDER, 8, 0xFF>& pixels) override {
+        init();
+
+        uint8_t* p = drawBuffer;
+        while (pixels.has(1)) {
+            *p++ = pixels.loadAndScale0();
+            *p++ = pixels.loadAndScale1();
+            *p++ = pixels.loadAndScale2();
+            pixels.stepDithering();
+            pixels.advanceData();
+        }
+        serial.tryShow();
+    }
+
+private:
+    WS2812Serial serial;
+    bool started;
+
+    uint8_t drawBuffer[LED_COUNT * 3];
+    uint8_t frameBuffer[LED_COUNT * 12];
+    uint8_t frameBuffer2[LED_COUNT * 12];
+};
+
+#endif // WS2812SERIAL_CONTROLLER_H
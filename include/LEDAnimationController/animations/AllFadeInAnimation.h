@@ -2,6 +2,7 @@
 #define ALLFADEIN_ANIMATION_H
 
 #include "../AnimationBase.h"
+#include "../Crossfade.h"
 
 /**
  * @brief All fade in Animation
@@ -9,13 +10,17 @@
  * Diese Animation Faded alle LEDS bis zu RGB
  * Wahlweise von schwarz beginnend
  * 
- * @note Wichtig: Der OLDAnimationContext muss zwei 2D-Arrays enthalten:
- * old_frame und new_frame, die mit [led_index][color_component] zugreifbar sind
+ * Blendet vom Frame des gespeicherten Befehls (saved.Frame) zum Frame des
+ * aktuellen Befehls (cmd.Frame) über. Verlaufskurve und Gamma-Korrektur
+ * kommen aus PAR_EASE_IN_OUT und PAR_GAMMA_BLEND.
  */
 class AllFadeInAnimation : public AnimationBase {
 private:
-    uint8_t currentStep;     // Aktueller Schritt der Animation
+    uint8_t currentStep;     // Zuletzt gezeichneter Schritt der Animation
+    bool stepDrawn;          // currentStep wurde bereits gezeichnet
     uint8_t totalSteps;      // Gesamtzahl der Schritte
+    float progressScale;     // 1 / totalSteps
+    Crossfade crossfade;     // Festkomma-Überblendung
     
 public:
     /**
@@ -27,7 +32,9 @@ public:
     AllFadeInAnimation(CRGB* leds, AnimationContext* context) 
     : AnimationBase(leds,  context)
         , currentStep(0)
+        , stepDrawn(false)
         , totalSteps(100)
+        , progressScale(0.01f)
    {
     }
     
@@ -55,13 +62,17 @@ public:
      */
     void onStart() override {
         currentStep = 0;
+        stepDrawn = false;
         totalSteps = context->cmd.MultiUseTag1;
+        progressScale = totalSteps > 0 ? 1.0f / totalSteps : 1.0f;
+        crossfade.setEasing(context->cmd.para.easeInOut ? EASE_IN_OUT_CUBIC : EASE_LINEAR);
+        crossfade.setGammaCorrect(context->cmd.para.gammaBlend);
         if (context->cmd.para.startFromBlack) {
             // Lösche alle LEDs zu Beginn
             context->saved.Color = CRGB::Black;
             fill_solid(context->saved.Frame, context->numLeds, CRGB::Black);
             fill_solid(leds, context->numLeds, CRGB::Black);
-            FastLED.show();
+            markFrameDirty();
         }
     }
     
@@ -77,39 +88,32 @@ public:
             return true;
         }
         
-        // Prüfe, ob es Zeit für den nächsten Schritt ist
-        if (currentTime - lastUpdateTime < stepDuration) {
+        // Fälligen Schritt aus der Zeit seit dem Start bestimmen, verspätete Schritte entfallen
+        uint32_t step = dueStep(currentTime);
+        if (step > totalSteps) {
+            step = totalSteps;
+        }
+        if (stepDrawn && step == currentStep) {
             return true; // Noch nicht Zeit für Update, aber erfolgreich
         }
+        currentStep = step;
+        stepDrawn = true;
+        
+        // Anteil einmal pro Frame berechnen, dann alle LEDs überblenden
+        uint16_t amount = crossfade.fraction(currentStep, totalSteps);
+        crossfade.apply(leds, context->saved.Frame, context->cmd.Frame, context->numLeds, amount);
+        markFrameDirty();
         
-        // Prüfe, ob alle Schritte abgeschlossen sind
+        // Der letzte Schritt zeigt genau den Ziel-Frame
         if (currentStep >= totalSteps) {
             completed = true;
             progress = 1.0f;
+            endTime = startTime + totalSteps * stepDuration;
             return true;
         }
         
-          
-        if (currentStep < totalSteps ) {
-            // Match the original array access style from LEDAnimationController.cpp
-            for(int b = 0; b < context->numLeds; b++) { 
-                // Überprüfen ob OLDcontext nicht null ist
-                    leds[b].r = context->saved.Frame[b].r + (context->cmd.Frame[b].r - context->saved.Frame[b].r) * currentStep / (totalSteps );
-                    leds[b].g = context->saved.Frame[b].g + (context->cmd.Frame[b].g - context->saved.Frame[b].g) * currentStep / (totalSteps );
-                    leds[b].b = context->saved.Frame[b].b + (context->cmd.Frame[b].b - context->saved.Frame[b].b) * currentStep / (totalSteps );
-            }
-        } else {
-            // Verwende context->numLeds anstatt NUM_LEDS und überprüfe OLDcontext
-            fill_solid(leds, context->numLeds, context->cmd.Color);
-        }
-        FastLED.show();  
-        
         // Aktualisiere den Fortschritt
-        currentStep++;
-        progress = (float)currentStep / totalSteps;
-        
-        // Aktualisiere die Zeit für den nächsten Schritt
-        lastUpdateTime = currentTime;
+        progress = currentStep * progressScale;
         
         return true;
     }
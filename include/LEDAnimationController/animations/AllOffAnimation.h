@@ -53,7 +53,7 @@ public:
         fill_solid(leds, context->numLeds, CRGB::Black);
         
         // Zeige die Änderung an
-        FastLED.show();
+        markFrameDirty();
         
         // Markiere die Animation als abgeschlossen
         completed = true;
@@ -18,9 +18,12 @@
  */
 class BlinkAnimation : public AnimationBase {
 private:
-    CompositeAnimation* sequence;  // Composite-Animation für einen Blink-Zyklus
+    CompositeAnimation sequence;   // Composite-Animation für einen Blink-Zyklus
+    SetColorAnimation onStep;      // Schritte der Sequenz, gehören der Blink-Animation
+    AllOffAnimation offStep;
     int repeatCount;               // Anzahl der Wiederholungen
     int currentRepeat;             // Aktuelle Wiederholung
+    uint32_t cycleDuration;        // Dauer eines Blink-Zyklus in Millisekunden
     
 public:
     /**
@@ -31,20 +34,14 @@ public:
      */
     BlinkAnimation(CRGB* leds, AnimationContext* context) 
         : AnimationBase(leds,  context)
+        , onStep(leds, context)
+        , offStep(leds, context)
         , repeatCount(1)
-        , currentRepeat(0) {
+        , currentRepeat(0)
+        , cycleDuration(0) {
         
     }
     
-    /**
-     * @brief Destruktor
-     * 
-     * Gibt die Composite-Animation frei.
-     */
-    ~BlinkAnimation() {
-        delete sequence;
-    }
-    
     /**
      * @brief Gibt den Typ der Animation zurück
      * 
@@ -74,16 +71,16 @@ public:
         } else {
             repeatCount = 1;
         }      
+        // Einschalten + Warten + Ausschalten + Warten
+        cycleDuration = 2 * context->cmd.speed * 5;
 
-        // Erstelle die Composite-Sequenz
-        sequence = new CompositeAnimation(leds, context);
-        
-        // Baue das Blink-Muster auf
-        sequence->addAnimation(new SetColorAnimation(leds, context));  // Einschalten
-        sequence->addWait(context->cmd.speed*5);                      // Warten
-        sequence->addAnimation(new AllOffAnimation(leds,  context));    // Ausschalten
-        sequence->addWait(context->cmd.speed*5);                      // Warten
-        sequence->start();
+        // Baue das Blink-Muster auf, die Wartezeit hängt von der Geschwindigkeit ab
+        sequence.clear();
+        sequence.addAnimation(&onStep);               // Einschalten
+        sequence.addWait(context->cmd.speed*5);       // Warten
+        sequence.addAnimation(&offStep);              // Ausschalten
+        sequence.addWait(context->cmd.speed*5);       // Warten
+        sequence.startAt(startTime);
 
     }
     
@@ -91,7 +88,7 @@ public:
      * @brief Bricht die Animation ab
      */
     void onCancel() override {
-        sequence->cancel();
+        sequence.cancel();
     }
     
     /**
@@ -109,25 +106,29 @@ public:
         }
         
         // Führe die Sequenz aus
-        sequence->run(currentTime);
+        sequence.run(currentTime);
         
-        // Wenn die Sequenz abgeschlossen ist, aber noch Wiederholungen übrig sind
-        if (sequence->isCompleted()) {
+        // Wenn die Sequenz abgeschlossen ist, aber noch Wiederholungen übrig sind.
+        // Nach einer Verzögerung können mehrere Wiederholungen fällig sein.
+        while (sequence.isCompleted()) {
             currentRepeat++;
             
-            // Aktualisiere den Fortschritt
-            progress = (float)currentRepeat / repeatCount;
-            
             if (currentRepeat < repeatCount) {
-                // Starte die Sequenz neu
-                sequence->start();
+                // Starte die Sequenz zum planmäßigen Ende der vorherigen neu
+                sequence.startAt(sequence.getEndTime());
+                sequence.run(currentTime);
             } else {
                 // Alle Wiederholungen abgeschlossen
                 completed = true;
                 progress = 1.0f;
+                endTime = sequence.getEndTime();
+                return true;
             }
         }
         
+        // Aktualisiere den Fortschritt anhand der Zeit seit dem Start
+        progress = min(1.0f, (float)(currentTime - startTime) / (repeatCount * cycleDuration));
+        
         return true;
     }
 };
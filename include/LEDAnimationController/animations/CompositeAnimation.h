@@ -2,133 +2,168 @@
 #define COMPOSITE_ANIMATION_H
 #include "../AnimationTypeEnums.h"
 #include "../Animation.h"
-#include "WaitAnimation.h"
-#include <vector>
+
+#define COMPOSITE_MAX_STEPS 8  // Maximale Anzahl Schritte einer Sequenz
 
 /**
  * @brief Composite-Animation
- * 
+ *
  * Diese Klasse ermöglicht die Kombination mehrerer Animationen zu einer Sequenz.
  * Die Animationen werden nacheinander ausgeführt.
  * Sie ist vom Typ ONETIME und wird abgeschlossen, wenn alle Teilanimationen abgeschlossen sind.
+ *
+ * Jeder Schritt startet zum planmäßigen Ende des vorherigen. Sofortige
+ * Schritte und bereits verstrichene Wartezeiten werden im selben Aufruf
+ * weitergeschaltet, Verzögerungen der Hauptschleife verlängern die
+ * Sequenz daher nicht.
+ *
+ * Die Schritte liegen in einem Array fester Größe in der Sequenz selbst.
+ * Animationen werden nur referenziert und gehören dem Aufrufer, Wartezeiten
+ * sind eigene Schritte ohne Animationsobjekt. Eine Sequenz wird mit start()
+ * beliebig oft neu gestartet oder mit clear() neu aufgebaut, ohne dass
+ * dabei Speicher angefordert wird.
  */
 class CompositeAnimation : public Animation {
 private:
-    std::vector<Animation*> sequence;  // Sequenz von Animationen
-    size_t currentIndex;               // Index der aktuellen Animation
-    bool ownsAnimations;               // Flag, ob die Animationen beim Zerstören freigegeben werden sollen
-    CRGB* leds;                        // Zeiger auf das LED-Array
-    AnimationContext* context;         // Zeiger auf den Animations-Kontext
-    bool completed;                    // Flag für Animationsabschluss
-    bool cancelRequested;              // Flag für Abbruchanforderung
-    float progress;                    // Fortschritt der Animation (0.0 - 1.0)
-    
+    // Ein Schritt der Sequenz: Animation oder Wartezeit (animation == nullptr)
+    struct Step {
+        Animation* animation;
+        uint32_t waitTime;
+    };
+
+    Step sequence[COMPOSITE_MAX_STEPS]; // Sequenz von Schritten
+    uint8_t stepCount;                  // Anzahl belegter Schritte
+    uint8_t currentIndex;               // Index des aktuellen Schritts
+    uint32_t stepStartTime;             // Planmäßige Startzeit des aktuellen Schritts
+    uint32_t endTime;                   // Planmäßiges Ende der Sequenz
+    float stepProgress;                 // Fortschritt des aktuellen Warteschritts
+    bool completed;                     // Flag für Animationsabschluss
+    bool cancelRequested;               // Flag für Abbruchanforderung
+    float progress;                     // Fortschritt der Animation (0.0 - 1.0)
+
 public:
     /**
      * @brief Konstruktor
-     * 
-     * @param ledArray Zeiger auf das LED-Array
-     * @param ownsAnimationObjects Flag, ob die Animationen beim Zerstören freigegeben werden sollen
      */
-    CompositeAnimation(CRGB* ledArray, AnimationContext* ctx, bool ownsAnimationObjects = true) 
-        : currentIndex(0)
-        , ownsAnimations(ownsAnimationObjects)
-        , leds(ledArray)
-        , context(ctx)
+    CompositeAnimation()
+        : stepCount(0)
+        , currentIndex(0)
+        , stepStartTime(0)
+        , endTime(0)
+        , stepProgress(0.0f)
         , completed(false)
         , cancelRequested(false)
         , progress(0.0f) {
     }
-    
+
     /**
-     * @brief Destruktor
-     * 
-     * Gibt die Animationen frei, wenn ownsAnimations true ist.
+     * @brief Entfernt alle Schritte
      */
-    ~CompositeAnimation() {
-        if (ownsAnimations) {
-            for (Animation* anim : sequence) {
-                delete anim;
-            }
-        }
+    void clear() {
+        stepCount = 0;
+        currentIndex = 0;
     }
-   
+
     /**
      * @brief Fügt eine Animation zur Sequenz hinzu
-     * 
-     * @param anim Zeiger auf die hinzuzufügende Animation
+     *
+     * @param anim Zeiger auf die hinzuzufügende Animation, bleibt im Besitz des Aufrufers
+     * @return false wenn die Sequenz voll ist
      */
-    void addAnimation(Animation* anim) {
-        sequence.push_back(anim);
+    bool addAnimation(Animation* anim) {
+        if (stepCount >= COMPOSITE_MAX_STEPS) {
+            return false;
+        }
+        sequence[stepCount].animation = anim;
+        sequence[stepCount].waitTime = 0;
+        stepCount++;
+        return true;
     }
-    
+
     /**
      * @brief Fügt eine Wartezeit zur Sequenz hinzu
-     * 
+     *
      * @param waitTime Wartezeit in Millisekunden
+     * @return false wenn die Sequenz voll ist
      */
-    void addWait(uint32_t waitTime) {
-        sequence.push_back(new WaitAnimation(leds, context, waitTime));
+    bool addWait(uint32_t waitTime) {
+        if (stepCount >= COMPOSITE_MAX_STEPS) {
+            return false;
+        }
+        sequence[stepCount].animation = nullptr;
+        sequence[stepCount].waitTime = waitTime;
+        stepCount++;
+        return true;
     }
-    
+
     /**
      * @brief Gibt den Typ der Animation zurück
-     * 
+     *
      * @return ANIMATION_ONETIME
      */
     AnimationType getType() const override {
         return ANIMATION_ONETIME;
     }
-    
+
     /**
      * @brief Prüft, ob die Animation einen bestimmten Befehl unterstützt
-     * 
+     *
      * Die CompositeAnimation wird normalerweise nicht direkt durch Befehle ausgelöst,
      * sondern durch spezialisierte Wrapper-Klassen.
-     * 
+     *
      * @param cmd Der zu prüfende Befehl
      * @return false (unterstützt keine direkten Befehle)
      */
     bool supportsCommand(AnimationCommand cmd) const override {
         return false;
     }
-    
+
     /**
      * @brief Initialisiert die Animation mit Parametern
-     * 
+     *
      * @return true wenn die Initialisierung erfolgreich war
      */
     bool setup() override {
 
         return true;
     }
-    
+
     /**
      * @brief Startet die Animation
-     * 
-     * @param newParams Array von Parametern für die Animation
+     *
      * @return true wenn der Start erfolgreich war
      */
     bool start() override {
+        return startAt(millis());
+    }
+
+    /**
+     * @brief Startet die Animation zu einem vorgegebenen Zeitpunkt
+     *
+     * @param time Startzeitpunkt in Millisekunden
+     * @return true wenn der Start erfolgreich war
+     */
+    bool startAt(uint32_t time) override {
         currentIndex = 0;
         completed = false;
         cancelRequested = false;
         progress = 0.0f;
-        
-        // Starte die erste Animation, wenn vorhanden
-        if (!sequence.empty()) {
-            sequence[0]->start();
+        endTime = time;
+
+        // Starte den ersten Schritt, wenn vorhanden
+        if (stepCount > 0) {
+            startStep(time);
         }
-        
+
         return true;
     }
-    
+
     /**
      * @brief Führt einen Animationsschritt aus
-     * 
+     *
      * Führt einen Schritt der aktuellen Animation aus und wechselt zur nächsten,
      * wenn die aktuelle abgeschlossen ist.
-     * 
+     *
      * @param currentTime Aktuelle Zeit in Millisekunden
      * @return true wenn der Schritt erfolgreich ausgeführt wurde
      */
@@ -139,81 +174,120 @@ public:
             progress = 1.0f;
             return true;
         }
-        
-        // Prüfe, ob die Sequenz leer ist oder alle Animationen abgeschlossen sind
-        if (sequence.empty() || currentIndex >= sequence.size()) {
+
+        // Prüfe, ob die Sequenz leer ist oder alle Schritte abgeschlossen sind
+        if (currentIndex >= stepCount) {
             completed = true;
             progress = 1.0f;
             return true;
         }
-        
-        // Führe die aktuelle Animation aus
-        Animation* current = sequence[currentIndex];
-        Serial.println(currentIndex);
-        current->run(currentTime);
-        
-        // Prüfe, ob die aktuelle Animation abgeschlossen ist
-        if (current->isCompleted()) {
+
+        // Führe den aktuellen Schritt aus, abgeschlossene Schritte direkt weiterschalten
+        while (currentIndex < stepCount && runStep(currentTime)) {
+            uint32_t stepEnd = stepEndTime();
             currentIndex++;
-            
-            // Starte die nächste Animation, wenn vorhanden
-            if (currentIndex < sequence.size()) {
-                sequence[currentIndex]->start();
+
+            // Starte den nächsten Schritt zum Ende des vorherigen, wenn vorhanden
+            if (currentIndex < stepCount) {
+                startStep(stepEnd);
             } else {
-                // Alle Animationen abgeschlossen
+                // Alle Schritte abgeschlossen
                 completed = true;
                 progress = 1.0f;
+                endTime = stepEnd;
             }
         }
-        
+
         // Berechne den Gesamtfortschritt
-        if (!sequence.empty()) {
-            float stepProgress = (float)currentIndex / sequence.size();
-            float currentProgress = 0.0f;
-            
-            if (currentIndex < sequence.size()) {
-                currentProgress = sequence[currentIndex]->getProgress() / sequence.size();
-            }
-            
-            progress = stepProgress + currentProgress;
+        if (currentIndex < stepCount) {
+            progress = (currentIndex + currentStepProgress()) / stepCount;
         }
-        
+
         return true;
     }
-    
+
     /**
      * @brief Bricht die Animation ab
-     * 
+     *
      * @return true wenn der Abbruch erfolgreich war
      */
     bool cancel() override {
         cancelRequested = true;
-        
+
         // Brich die aktuelle Animation ab, wenn vorhanden
-        if (currentIndex < sequence.size()) {
-            sequence[currentIndex]->cancel();
+        if (currentIndex < stepCount && sequence[currentIndex].animation != nullptr) {
+            sequence[currentIndex].animation->cancel();
         }
-        
+
         return true;
     }
-    
+
     /**
      * @brief Prüft, ob die Animation abgeschlossen ist
-     * 
+     *
      * @return true wenn die Animation abgeschlossen ist
      */
     bool isCompleted() const override {
         return completed || cancelRequested;
     }
-    
+
     /**
      * @brief Gibt den Fortschritt der Animation zurück
-     * 
+     *
      * @return Fortschritt als Wert zwischen 0.0 und 1.0
      */
     float getProgress() const override {
         return progress;
     }
+
+    /**
+     * @brief Gibt den planmäßigen Endzeitpunkt zurück
+     *
+     * @return Endzeitpunkt in Millisekunden
+     */
+    uint32_t getEndTime() const override {
+        return endTime;
+    }
+
+private:
+    void startStep(uint32_t time) {
+        Step& step = sequence[currentIndex];
+        stepProgress = 0.0f;
+        stepStartTime = time;
+        if (step.animation != nullptr) {
+            step.animation->startAt(time);
+        }
+    }
+
+    // Planmäßiges Ende des aktuellen, abgeschlossenen Schritts
+    uint32_t stepEndTime() const {
+        const Step& step = sequence[currentIndex];
+        if (step.animation != nullptr) {
+            return step.animation->getEndTime();
+        }
+        return stepStartTime + step.waitTime;
+    }
+
+    // Führt den aktuellen Schritt aus, gibt true zurück wenn er abgeschlossen ist
+    bool runStep(uint32_t currentTime) {
+        Step& step = sequence[currentIndex];
+        if (step.animation != nullptr) {
+            step.animation->run(currentTime);
+            return step.animation->isCompleted();
+        }
+        uint32_t elapsedTime = currentTime - stepStartTime;
+        if (elapsedTime >= step.waitTime) {
+            stepProgress = 1.0f;
+            return true;
+        }
+        stepProgress = (float)elapsedTime / step.waitTime;
+        return false;
+    }
+
+    float currentStepProgress() const {
+        const Step& step = sequence[currentIndex];
+        return step.animation != nullptr ? step.animation->getProgress() : stepProgress;
+    }
 };
 
 #endif // COMPOSITE_ANIMATION_H
@@ -18,10 +18,14 @@
  */
 class CycloneAnimation : public AnimationBase {
 private:
-    uint8_t currentStep;     // Aktueller Schritt der Animation
-    uint8_t totalSteps;      // Gesamtzahl der Schritte
+    uint16_t currentStep;    // Nächster Schritt im aktuellen Umlauf
+    uint32_t stepsDone;      // Seit dem Start gezeichnete Schritte
+    uint16_t totalSteps;     // Gesamtzahl der Schritte
     bool isContinous;        // Animaiton im Continues mode 
-    uint8_t firstCylePos;    // Position im ersten Zyklus (für <> PAR_START_FROM_BLACK)  
+    uint16_t firstCylePos;   // Position im ersten Zyklus (für <> PAR_START_FROM_BLACK)  
+    bool trailPending;       // Schweif des vorherigen Schritts muss noch abgedunkelt werden
+    uint16_t trailStep;      // Schritt, dessen Schweif aussteht
+    int trailIdx;            // Kopfposition dieses Schritts
     
 public:
     /**
@@ -33,9 +37,13 @@ public:
     CycloneAnimation(CRGB* leds,  AnimationContext* context, uint8_t startHue = 0) 
     : AnimationBase(leds, context) 
         , currentStep(0)
+        , stepsDone(0)
         , totalSteps(context->numLeds)
         , isContinous(false)
         , firstCylePos(0)
+        , trailPending(false)
+        , trailStep(0)
+        , trailIdx(0)
         , hue(startHue) 
         {
             
@@ -67,10 +75,12 @@ public:
      */
     void onStart() override {
         currentStep = 0;
+        stepsDone = 0;
         totalSteps = context->numLeds;
         isContinous = (context->cmd.Animation == CMD_CONTINUOUS_CYCLONE) ;
         CRGB color = context->cmd.Color;
         firstCylePos = 0;
+        trailPending = false;
         Serial.println("OnSTART");
         
         hue = rgb2hsv_approximate(color).hue;  
@@ -87,7 +97,7 @@ public:
         if(context->cmd.para.startFromBlack == true){
             // Lösche alle LEDs zu Beginn
             fill_solid(leds, context->numLeds, CRGB::Black);
-            FastLED.show();
+            markFrameDirty();
         }
     }
     
@@ -103,24 +113,50 @@ public:
             return true;
         }
         
-        // Prüfe, ob es Zeit für den nächsten Schritt ist
-        if (currentTime - lastUpdateTime < stepDuration) {
-            return true; // Noch nicht Zeit für Update, aber erfolgreich
+        // Schritt s ist zum Zeitpunkt s * stepDuration fällig, der Durchlauf endet nach totalSteps Schritten
+        uint32_t due = dueStep(currentTime);
+        uint32_t target = due + 1;
+        if (!isContinous && target > totalSteps) {
+            target = totalSteps;
+        }
+        
+        // Nach einem langen Stillstand nur den letzten Umlauf nachholen
+        if (target - stepsDone > totalSteps) {
+            stepsDone = target - totalSteps;
+            currentStep = stepsDone % totalSteps;
+        }
+        
+        // Verpasste Schritte nachzeichnen, damit der Schweif stimmt
+        while (stepsDone < target) {
+            drawStep();
+            stepsDone++;
         }
         
         // Prüfe, ob alle Schritte abgeschlossen sind
-        if (currentStep >= totalSteps) {
-            if (isContinous){
-                completed = false;
-                currentStep =0;
-            } else {
-                completed = true; 
-            }
-            
+        if (!isContinous && due >= totalSteps) {
+            completed = true;
             progress = 1.0f;
+            endTime = startTime + totalSteps * stepDuration;
             return true;
         }
         
+        // Aktualisiere den Fortschritt (im Dauerbetrieb pro Umlauf)
+        progress = (float)(due % totalSteps) / totalSteps;
+        
+        return true;
+    }
+
+private:
+    /**
+     * @brief Zeichnet den nächsten Schritt: Schweif abdunkeln, Kopf setzen
+     */
+    void drawStep() {
+        // Schweif des vorherigen Schritts abdunkeln, bevor der neue Kopf gezeichnet
+        // wird - der Frame wird erst vom Controller ausgegeben
+        if (trailPending) {
+            fadeTrail(trailStep, trailIdx);
+        }
+        
         // Berechne den Index basierend auf der Richtung
         int idx = currentStep;
         if (context->cmd.para.reversDirection) {
@@ -139,11 +175,26 @@ public:
         }
         
         // Zeige die Änderung an
-        FastLED.show();
+        markFrameDirty();
+        trailPending = true;
+        trailStep = currentStep;
+        trailIdx = idx;
         
-        // Dimme LEDs für den Schweifeffekt
+        currentStep++;
+        if (isContinous && currentStep >= totalSteps) {
+            currentStep = 0;
+        }
+    }
+    
+    /**
+     * @brief Dimmt die LEDs für den Schweifeffekt
+     * 
+     * @param step Schritt, in dem der Kopf gezeichnet wurde
+     * @param idx Position des Kopfes in diesem Schritt
+     */
+    void fadeTrail(uint16_t step, int idx) {
         if ((firstCylePos < context->numLeds) &&(firstCylePos < context->numLeds -1)) {
-            firstCylePos = currentStep;
+            firstCylePos = step;
 
             if (context->cmd.para.reversDirection) {
 
@@ -153,7 +204,7 @@ public:
                 }
             } else {
              
-                for(int i = 0; i < currentStep; i++) { 
+                for(int i = 0; i < step; i++) { 
 
                     leds[i].nscale8((255-context->cmd.MultiUseTag1));  
                 }
@@ -168,18 +219,6 @@ public:
                 
             }
         }
-
-
-
-        
-        // Aktualisiere den Fortschritt
-        currentStep++;
-        progress = (float)currentStep / totalSteps;
-        
-        // Aktualisiere die Zeit für den nächsten Schritt
-        lastUpdateTime = currentTime;
-        
-        return true;
     }
 };
 
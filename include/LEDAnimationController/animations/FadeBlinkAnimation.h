@@ -17,11 +17,13 @@
  */
 class FadeBlinkAnimation : public AnimationBase {
 private:
-    CompositeAnimation* sequence;  // Composite-Animation für einen Blink-Zyklus
+    CompositeAnimation sequence;   // Composite-Animation für einen Blink-Zyklus
     int repeatCount;               // Anzahl der Wiederholungen
     int currentRepeat;             // Aktuelle Wiederholung
-    AnimationContext ctx1;
-    CMD_struct tmp;
+    uint32_t cycleDuration;        // Dauer eines Blink-Zyklus in Millisekunden
+    AnimationContext ctx1;         // Kontext mit vertauschtem cmd/saved, referenziert dieselben Frames
+    AllFadeInAnimation fadeInStep;  // Schritte der Sequenz, gehören der Blink-Animation
+    AllFadeInAnimation fadeOutStep; // Blendet mit vertauschtem Kontext zurück
 
 public:
     /**
@@ -33,19 +35,13 @@ public:
     FadeBlinkAnimation(CRGB* leds, AnimationContext* context) 
         : AnimationBase(leds,  context)
         , repeatCount(1)
-        , currentRepeat(0) {
+        , currentRepeat(0)
+        , cycleDuration(0)
+        , fadeInStep(leds, context)
+        , fadeOutStep(leds, &ctx1) {
         
     }
     
-    /**
-     * @brief Destruktor
-     * 
-     * Gibt die Composite-Animation frei.
-     */
-    ~FadeBlinkAnimation() {
-        delete sequence;
-    }
-    
     /**
      * @brief Gibt den Typ der Animation zurück
      * 
@@ -74,7 +70,7 @@ public:
             fill_solid(context->saved.Frame, context->numLeds, CRGB::Black);
             context->cmd.Color = CRGB::Black;
             fill_solid(leds, context->numLeds, CRGB::Black);
-            FastLED.show();
+            markFrameDirty();
         }
 
         currentRepeat = 0;
@@ -83,29 +79,33 @@ public:
         } else {
             repeatCount = 1;
         }      
+        // Ein- und Ausblenden mit je 150 Schritten
+        cycleDuration = 2 * 150 * stepDuration;
 
         // Erstelle die Composite-Sequenz
         context->saved.para.startFromBlack = false;
         context->cmd.para.startFromBlack = false;
         context->cmd.MultiUseTag1 = 150;
-        memcpy(&ctx1, context, sizeof(AnimationContext));
+        ctx1 = *context;
 
-        sequence = new CompositeAnimation(leds, context);
+        sequence.clear();
     
         // Baue das Blink-Muster auf
-        sequence->addAnimation(new AllFadeInAnimation(leds, context));  // Einschalten
-        //sequence->addWait(1000);                      // Warten
+        sequence.addAnimation(&fadeInStep);  // Einschalten
+        //sequence.addWait(1000);                      // Warten
 
-        memcpy(&tmp, &ctx1.saved, sizeof(CMD_struct));    
-        memcpy(&ctx1.saved, &ctx1.cmd, sizeof(CMD_struct));
-        memcpy(&ctx1.cmd, &tmp, sizeof(CMD_struct));
+        ctx1.cmd = context->saved;
+        ctx1.saved = context->cmd;
         ctx1.cmd.para.startFromBlack = false;
         ctx1.saved.para.startFromBlack = false;
+        ctx1.cmd.para.easeInOut = context->cmd.para.easeInOut;
+        ctx1.cmd.para.gammaBlend = context->cmd.para.gammaBlend;
         ctx1.cmd.MultiUseTag1 = 150;
+        ctx1.cmd.speed = context->cmd.speed;
         ctx1.saved.Color= context->cmd.Color;
-        sequence->addAnimation(new AllFadeInAnimation(leds,  &ctx1));    // Ausschalten
-        //sequence->addWait(1000);                      // Warten 
-        sequence->start();
+        sequence.addAnimation(&fadeOutStep);    // Ausschalten
+        //sequence.addWait(1000);                      // Warten 
+        sequence.startAt(startTime);
 
     }
     
@@ -113,7 +113,7 @@ public:
      * @brief Bricht die Animation ab
      */
     void onCancel() override {
-        sequence->cancel();
+        sequence.cancel();
     }
     
     /**
@@ -131,25 +131,29 @@ public:
         }
         
         // Führe die Sequenz aus
-        sequence->run(currentTime);
+        sequence.run(currentTime);
         
-        // Wenn die Sequenz abgeschlossen ist, aber noch Wiederholungen übrig sind
-        if (sequence->isCompleted()) {
+        // Wenn die Sequenz abgeschlossen ist, aber noch Wiederholungen übrig sind.
+        // Nach einer Verzögerung können mehrere Wiederholungen fällig sein.
+        while (sequence.isCompleted()) {
             currentRepeat++;
             
-            // Aktualisiere den Fortschritt
-            progress = (float)currentRepeat / repeatCount;
-            
             if (currentRepeat < repeatCount) {
-                // Starte die Sequenz neu
-                sequence->start();
+                // Starte die Sequenz zum planmäßigen Ende der vorherigen neu
+                sequence.startAt(sequence.getEndTime());
+                sequence.run(currentTime);
             } else {
                 // Alle Wiederholungen abgeschlossen
                 completed = true;
                 progress = 1.0f;
+                endTime = sequence.getEndTime();
+                return true;
             }
         }
         
+        // Aktualisiere den Fortschritt anhand der Zeit seit dem Start
+        progress = min(1.0f, (float)(currentTime - startTime) / (repeatCount * cycleDuration));
+        
         return true;
     }
 };
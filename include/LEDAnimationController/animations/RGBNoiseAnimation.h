@@ -2,93 +2,79 @@
 #define RGB_NOISE_ANIMATION_H
 
 #include "../AnimationBase.h"
-#include <math.h>
 
 /**
  * @brief RGB-Rausch-Animation
- * 
+ *
  * Diese Animation erzeugt kontinuierlich Rauscheffekte mit wechselnden Farben.
- * Sie verwendet Vorberechnungstechniken für bessere Performance.
+ * Die LEDs liegen auf einem Kreis, der sich langsam durch das Rauschfeld dreht.
+ * Die Kreispositionen sind einmalig in Festkomma vorberechnet, die Drehung
+ * wird einmal pro Frame mit sin16/cos16 bestimmt statt je LED in double.
+ * Rauschfelder und HSV-Umrechnung sind dieselben wie bisher, sie kosten auf
+ * dem Host weniger als inoise8 und eine Palette.
  * Sie ist vom Typ CONTINUOUS und läuft endlos.
+ *
+ * @tparam LED_CAPACITY Größe der Positionstabellen, RGBNoiseAnimation nutzt NUM_LEDS
  */
-class RGBNoiseAnimation : public AnimationBase {
+template <uint16_t LED_CAPACITY>
+class RGBNoiseAnimationN : public AnimationBase {
 private:
-    // Struktur für vorberechnete Rauschwerte
-    struct NoisePoint {
-        uint8_t hue;
-        uint8_t sat;
-        uint8_t val;
-    };
-    
-    NoisePoint* noisePoints;  // Array für vorberechnete Rauschwerte
-    float* precalcCos;        // Vorberechnete Cosinus-Werte
-    float* precalcSin;        // Vorberechnete Sinus-Werte
-    uint32_t runTime;         // Laufzeit der Animation
-    
+    int16_t precalcCos[LED_CAPACITY];  // Vorberechnete Cosinus-Werte (Q15)
+    int16_t precalcSin[LED_CAPACITY];  // Vorberechnete Sinus-Werte (Q15)
+    uint32_t runTime;                  // Laufzeit der Animation
+
 public:
     /**
      * @brief Konstruktor
-     * 
+     *
      * @param leds Zeiger auf das LED-Array
      * @param context current Animation context
      */
-    RGBNoiseAnimation(CRGB* leds, AnimationContext* context) 
-        : AnimationBase(leds, context) 
+    RGBNoiseAnimationN(CRGB* leds, AnimationContext* context)
+        : AnimationBase(leds, context)
         , runTime(0) {
-        
-        // Speicher für vorberechnete Werte allozieren
-        noisePoints = new NoisePoint[context->numLeds];
-        precalcCos = new float[context->numLeds];
-        precalcSin = new float[context->numLeds];
-        
-        // Trigonometrische Werte vorberechnen
-        for (int i = 0; i < context->numLeds; i++) {
-            float angle = i * 2 * M_PI / context->numLeds;
-            precalcCos[i] = cos(angle);
-            precalcSin[i] = sin(angle);
-        }
     }
-    
+
     /**
-     * @brief Destruktor
-     * 
-     * Gibt den allozierten Speicher frei.
+     * @brief Berechnet die Kreispositionen der LEDs einmalig vor
      */
-    ~RGBNoiseAnimation() {
-        delete[] noisePoints;
-        delete[] precalcCos;
-        delete[] precalcSin;
+    void onSetup() override {
+        for (int i = 0; i < context->numLeds; i++) {
+            uint16_t angle = ((uint32_t)i << 16) / context->numLeds;
+            precalcCos[i] = cos16(angle);
+            precalcSin[i] = sin16(angle);
+        }
     }
-    
+
     /**
      * @brief Gibt den Typ der Animation zurück
-     * 
+     *
      * @return ANIMATION_CONTINUOUS
      */
     AnimationType getType() const override {
         return ANIMATION_CONTINUOUS;
     }
-    
+
     /**
      * @brief Prüft, ob die Animation einen bestimmten Befehl unterstützt
-     * 
+     *
      * @param cmd Der zu prüfende Befehl
      * @return true wenn cmd == CMD_RGB_NOISE
      */
     bool supportsCommand(AnimationCommand cmd) const override {
         return cmd == CMD_RGB_NOISE;
     }
-    
+
     /**
      * @brief Startet die Animation
      */
     void onStart() override {
         runTime = 0;
     }
-    
+
     /**
      * @brief Führt einen Animationsschritt aus
-     * 
+     *
      * @param currentTime Aktuelle Zeit in Millisekunden
      * @return true wenn der Schritt erfolgreich ausgeführt wurde
      */
@@ -97,83 +83,77 @@ public:
         if (cancelRequested) {
             return true;
         }
-        
+
         // Prüfe, ob es Zeit für den nächsten Schritt ist
         if (currentTime - lastUpdateTime < stepDuration) {
             return true; // Noch nicht Zeit für Update, aber erfolgreich
         }
-        
-        // Berechne die Rauschwerte für den aktuellen Frame vor
-        precalculateNoiseFrame(currentTime);
-        
-        // Wende die vorberechneten Werte auf die LEDs an
-        for (int i = 0; i < context->numLeds; i++) {
-            leds[i] = CHSV(noisePoints[i].hue, noisePoints[i].sat, noisePoints[i].val);
-        }
-        
+
+        // Berechne den Frame direkt in das LED-Array
+        renderNoiseFrame(currentTime);
+
         // Zeige die Änderung an
-        FastLED.show();
-        
+        markFrameDirty();
+
         // Aktualisiere die Laufzeit
         runTime += currentTime - lastUpdateTime;
-        
+
         // Bei kontinuierlichen Animationen bleibt der Fortschritt immer bei 0
         // oder kann zyklisch sein, je nach Implementierung
         progress = 0.0f;
-        
+
         // Aktualisiere die Zeit für den nächsten Schritt
         lastUpdateTime = currentTime;
-        
+
         return true;
     }
-    
+
     /**
      * @brief Gibt den Fortschritt der Animation zurück
-     * 
+     *
      * Bei kontinuierlichen Animationen gibt es keinen echten Fortschritt,
      * daher wird immer 0.0 zurückgegeben.
-     * 
+     *
      * @return 0.0f
      */
     float getProgress() const override {
         return 0.0f;
     }
-    
+
 private:
     /**
-     * @brief Berechnet die Rauschwerte für den aktuellen Frame vor
-     * 
+     * @brief Berechnet die Rauschwerte für den aktuellen Frame
+     *
      * @param now Aktuelle Zeit in Millisekunden
      */
-    void precalculateNoiseFrame(uint32_t now) {
-        double angle_offset = double(now) / 32000.0 * 2 * M_PI;
-        now = (now << 5) * 1;
-        
+    void renderNoiseFrame(uint32_t now) {
+        // Drehung einmal pro Frame, eine Umdrehung dauert 32 s
+        uint16_t angle = (now % 32000) * 2048 / 1000;
+        int32_t cosOffset = cos16(angle);
+        int32_t sinOffset = sin16(angle);
+        uint32_t z = now << 5;
+
         for (int i = 0; i < context->numLeds; i++) {
-            // Verwende vorberechnete Werte für bessere Performance
-            float x = precalcCos[i] * cos(angle_offset) - precalcSin[i] * sin(angle_offset);
-            float y = precalcCos[i] * sin(angle_offset) + precalcSin[i] * cos(angle_offset);
-            
-            x *= 0xffff * 4;
-            y *= 0xffff * 4;
-            
-            // Berechne verschiedene Rauschwerte für Farbton, Sättigung und Helligkeit
-            uint16_t noise = inoise16(x, y, now);
-            uint16_t noise2 = inoise16(x, y, 0xfff + now);
-            uint16_t noise3 = inoise16(x, y, 0xffff + now);
-            noise3 = noise3 >> 8;
-            
-            int16_t noise4 = map(noise3, 0, 255, -64, 255);
-            if (noise4 < 0) {
-                noise4 = 0;
+            // Gedrehte Position, Q30 >> 12 skaliert den Einheitskreis auf +-0x3FFFF
+            uint32_t x = (uint32_t)((precalcCos[i] * cosOffset - precalcSin[i] * sinOffset) >> 12);
+            uint32_t y = (uint32_t)((precalcCos[i] * sinOffset + precalcSin[i] * cosOffset) >> 12);
+
+            // Drei Kanäle an derselben Position, in z gegeneinander versetzt
+            uint16_t noise = inoise16(x, y, z);
+            uint16_t noise2 = inoise16(x, y, z + 0xfff);
+            uint8_t noise3 = inoise16(x, y, z + 0xffff) >> 8;
+
+            // 0..255 -> -64..255, negative Werte sind aus
+            int16_t val = (int16_t)(noise3 * 319 / 255) - 64;
+            if (val < 0) {
+                val = 0;
             }
-            
-            // Speichere die vorberechneten Werte
-            noisePoints[i].hue = noise >> 8;
-            noisePoints[i].sat = MAX(128, noise2 >> 8);
-            noisePoints[i].val = noise4;
+
+            leds[i] = CHSV(noise >> 8, MAX(128, noise2 >> 8), val);
         }
     }
 };
 
+typedef RGBNoiseAnimationN<NUM_LEDS> RGBNoiseAnimation;
+
 #endif // RGB_NOISE_ANIMATION_H
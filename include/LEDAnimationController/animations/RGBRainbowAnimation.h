@@ -13,8 +13,10 @@
  */
 class RGBRainbowAnimation : public AnimationBase {
 private:
-    uint8_t currentStep;     // Aktueller Schritt der Animation
+    uint32_t currentStep;    // Zuletzt gezeichneter Schritt der Animation
+    bool stepDrawn;          // currentStep wurde bereits gezeichnet
     uint8_t totalSteps;      // Gesamtzahl der Schritte
+    uint8_t startHue;        // Farbton beim Start
 
     CRGB Wheel(byte WheelPos) {
         WheelPos = 255 - WheelPos;
@@ -38,7 +40,10 @@ public:
     RGBRainbowAnimation(CRGB* leds, AnimationContext* context) 
     : AnimationBase(leds,  context)
         , currentStep(0)
+        , stepDrawn(false)
         , totalSteps(255)
+        , startHue(0)
+        , hue(0)
    {
     }
     
@@ -66,12 +71,14 @@ public:
      */
     void onStart() override {
         currentStep = 0;
+        stepDrawn = false;
+        startHue = hue;
         totalSteps = context->cmd.MultiUseTag1;
         if (context->cmd.para.startFromBlack) {
             // Lösche alle LEDs zu Beginn
             fill_solid(context->saved.Frame, context->numLeds, CRGB::Black);
             fill_solid(leds, context->numLeds, CRGB::Black);
-            FastLED.show();
+            markFrameDirty();
         }
     }
 
@@ -89,29 +96,23 @@ public:
             return true;
         }
         
-        // Prüfe, ob es Zeit für den nächsten Schritt ist
-        if (currentTime - lastUpdateTime < stepDuration) {
+        // Fälligen Schritt aus der Zeit seit dem Start bestimmen, verspätete Schritte entfallen
+        uint32_t step = dueStep(currentTime);
+        if (stepDrawn && step == currentStep) {
             return true; // Noch nicht Zeit für Update, aber erfolgreich
         }
-        
-
-
-        // Update base hue only on certain frames for slower movement
-        if ((currentStep % 3 ) == 0) {
-            hue = (hue + context->cmd.MultiUseTag1) % 255;
-        }
+        currentStep = step;
+        stepDrawn = true;
 
+        // Base hue moves on every third step for slower movement
+        hue = (startHue + (currentStep / 3 + 1) * context->cmd.MultiUseTag1) % 255;
         
         // Use bit manipulation function for direction control
         fill_rainbow_circular(leds, context->numLeds, hue, context->cmd.para.reversDirection);
-        FastLED.show();  
-        
-        // Aktualisiere den Fortschritt
-        currentStep++;
-        progress = (float)currentStep / totalSteps;
+        markFrameDirty();
         
-        // Aktualisiere die Zeit für den nächsten Schritt
-        lastUpdateTime = currentTime;
+        // Kontinuierliche Animation ohne echten Fortschritt
+        progress = 0.0f;
         
         return true;
     }
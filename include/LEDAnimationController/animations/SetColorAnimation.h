@@ -58,7 +58,7 @@ public:
    
 
         // Show the change
-        FastLED.show();
+        markFrameDirty();
 
         // Mark the animation as completed
         completed = true;
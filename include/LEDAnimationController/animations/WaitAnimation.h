@@ -13,7 +13,6 @@
 class WaitAnimation : public AnimationBase {
 private:
     uint32_t duration;    // Dauer der Wartezeit in Millisekunden
-    uint32_t startTime;   // Startzeit der Animation
     
 public:
     /**
@@ -25,8 +24,7 @@ public:
      */
     WaitAnimation(CRGB* leds,  AnimationContext* context, uint32_t waitDuration) 
         : AnimationBase(leds, context)
-        , duration(waitDuration)
-        , startTime(0) {
+        , duration(waitDuration) {
     }
     
     /**
@@ -51,13 +49,6 @@ public:
         return false;
     }
     
-    /**
-     * @brief Startet die Animation
-     */
-    void onStart() override {
-        startTime = millis();
-    }
-    
     /**
      * @brief Führt einen Animationsschritt aus
      * 
@@ -84,6 +75,7 @@ public:
         if (elapsedTime >= duration) {
             completed = true;
             progress = 1.0f;
+            endTime = startTime + duration;
         }
         
         return true;
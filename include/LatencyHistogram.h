@@ -0,0 +1,48 @@
+#pragma once
+#include <Arduino.h>
+#include "config.h"
+
+/**
+ * @brief Logarithmisches Histogramm für Laufzeiten und Latenzen
+ *
+ * Klasse 0 zählt Werte unter 1 µs, Klasse i > 0 den Bereich
+ * [2^(i-1), 2^i) µs, die letzte Klasse alles darüber. Mit 16 Klassen reicht
+ * das bis 16 ms, Ausreißer landen in der obersten Klasse. Das Einsortieren
+ * kostet ein CLZ und ein Inkrement, die Zähler sättigen nicht.
+ */
+class LatencyHistogram {
+public:
+    static const uint8_t BUCKETS = LATENCY_HISTOGRAM_BUCKETS;
+
+    LatencyHistogram() {
+        reset();
+    }
+
+    void reset() {
+        memset(counts, 0, sizeof(counts));
+    }
+
+    void add(uint32_t value_us) {
+        counts[bucketOf(value_us)]++;
+    }
+
+    uint32_t getCount(uint8_t bucket) const {
+        return counts[bucket];
+    }
+
+    // Untere Grenze einer Klasse in Mikrosekunden
+    static uint32_t lowerBound(uint8_t bucket) {
+        return bucket == 0 ? 0 : (uint32_t)1 << (bucket - 1);
+    }
+
+    static uint8_t bucketOf(uint32_t value_us) {
+        if (value_us == 0) {
+            return 0;
+        }
+        uint8_t bucket = 32 - __builtin_clz(value_us);
+        return bucket < BUCKETS ? bucket : BUCKETS - 1;
+    }
+
+private:
+    uint32_t counts[BUCKETS];
+};
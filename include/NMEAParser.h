@@ -0,0 +1,119 @@
+#pragma once
+#include <Arduino.h>
+
+// Maximale Länge eines NMEA-Satzes inkl. '$' und "*hh\r\n"
+#define NMEA_MAX_SENTENCE_LENGTH 100
+
+// Satellitensysteme in NMEAFix::systemsUsed
+#define NMEA_SYSTEM_GPS 0x01
+#define NMEA_SYSTEM_GLONASS 0x02
+#define NMEA_SYSTEM_GALILEO 0x04
+#define NMEA_SYSTEM_BEIDOU 0x08
+#define NMEA_SYSTEM_QZSS 0x10
+
+// Ergebnis des Parsers in Festkommadarstellung (keine double/atof)
+struct NMEAFix {
+    // Position (GGA/RMC)
+    bool positionValid = false;
+    int32_t latitude_e7 = 0;       // Grad * 1e7
+    int32_t longitude_e7 = 0;      // Grad * 1e7
+    bool altitudeValid = false;
+    int32_t altitude_mm = 0;       // Höhe über MSL in Millimetern
+    uint8_t fixQuality = 0;        // GGA Fix-Qualität (0 = kein Fix, 1 = GPS, 2 = DGPS/SBAS, ...)
+    uint8_t satellites = 0;
+    bool hdopValid = false;
+    uint16_t hdop_x100 = 0;
+
+    // Bewegung (RMC)
+    bool speedValid = false;
+    uint32_t speed_mknots = 0;     // Geschwindigkeit in 1/1000 Knoten
+    bool courseValid = false;
+    uint16_t course_cdeg = 0;      // Kurs in 1/100 Grad
+
+    // Zeit (UTC)
+    bool timeValid = false;
+    uint8_t hour = 0;
+    uint8_t minute = 0;
+    uint8_t second = 0;
+    uint16_t millisecond = 0;
+    bool dateValid = false;
+    uint16_t year = 0;
+    uint8_t month = 0;
+    uint8_t day = 0;
+
+    // DOP (GSA)
+    uint8_t fixMode = 1;           // 1 = kein Fix, 2 = 2D, 3 = 3D
+    uint16_t pdop_x100 = 0;
+    uint16_t vdop_x100 = 0;        // 0 = nicht gemeldet
+    uint8_t systemsUsed = 0;       // NMEA_SYSTEM_* mit mindestens einem Satelliten in der Lösung
+
+    // Fehlerstatistik (GST), Standardabweichungen in Millimetern
+    uint32_t errorTime_ms = 0;     // Tageszeit (UTC) der Statistik
+    bool rangeRmsValid = false;
+    uint32_t rangeRms_mm = 0;      // RMS der Pseudoentfernungsresiduen
+    bool ellipseValid = false;
+    uint32_t stdMajor_mm = 0;      // Große Halbachse der Fehlerellipse
+    uint32_t stdMinor_mm = 0;      // Kleine Halbachse
+    uint16_t orient_cdeg = 0;      // Richtung der großen Halbachse ab Nord in 1/100 Grad
+    bool stdValid = false;
+    uint32_t stdLat_mm = 0;
+    uint32_t stdLon_mm = 0;
+    uint32_t stdAlt_mm = 0;
+
+    // Tageszeit der Lösung in Millisekunden
+    uint32_t timeOfDay_ms() const {
+        return ((hour * 60UL + minute) * 60UL + second) * 1000UL + millisecond;
+    }
+};
+
+/**
+ * @brief Satzbasierter NMEA-Parser
+ *
+ * Sucht "$...*hh\r\n"-Sätze im Eingangsstrom, prüft die Prüfsumme wortweise
+ * und wertet nur GGA, RMC, GSA und GST direkt im Satzpuffer aus.
+ *
+ * Mehrere GSA-Sätze hintereinander (einer je Satellitensystem) bilden eine
+ * Gruppe, systemsUsed beschreibt immer die zuletzt gelesene Gruppe.
+ */
+class NMEAParser {
+public:
+    enum SentenceType {
+        SENTENCE_GGA = 0x01,
+        SENTENCE_RMC = 0x02,
+        SENTENCE_GSA = 0x04,
+        SENTENCE_GST = 0x08
+    };
+
+    NMEAParser();
+
+    // Verarbeitet einen Block Eingangsdaten, gibt eine Bitmaske der ausgewerteten Satztypen zurück
+    uint8_t feed(const uint8_t* data, uint32_t length);
+
+    const NMEAFix& getFix() const;
+
+    // Statistik
+    uint32_t getSentenceCount() const;
+    uint32_t getChecksumErrorCount() const;
+
+    // XOR-Prüfsumme über den Satzinhalt zwischen '$' und '*'
+    static uint8_t computeChecksum(const char* data, uint32_t length);
+
+private:
+    NMEAFix fix;
+
+    char sentence[NMEA_MAX_SENTENCE_LENGTH];
+    uint8_t sentenceLength;
+    bool inSentence;
+
+    uint32_t sentenceCount;
+    uint32_t checksumErrors;
+
+    uint8_t previousSentence;      // Typ des letzten gültigen Satzes, 0 = sonstiger
+    uint8_t gsaSystems;            // Systeme der laufenden GSA-Gruppe
+
+    uint8_t parseSentence();
+    void parseGGA(const char* p, const char* end);
+    void parseRMC(const char* p, const char* end);
+    void parseGSA(const char* talker, const char* p, const char* end);
+    void parseGST(const char* p, const char* end);
+};
@@ -11,14 +11,21 @@ struct NavSatFixData {
   static const uint8_t COVARIANCE_TYPE_DIAGONAL_KNOWN = 2;
   static const uint8_t COVARIANCE_TYPE_KNOWN = 3;
   
-  // Status-Konstanten
-  static const uint8_t STATUS_NO_FIX = 0;
-  static const uint8_t STATUS_FIX = 1;
-  static const uint8_t STATUS_SBAS_FIX = 2;
-  static const uint8_t STATUS_GBAS_FIX = 3;
+  // Status-Konstanten, Werte wie NavSatStatus
+  static const int8_t STATUS_NO_FIX = -1;
+  static const int8_t STATUS_FIX = 0;
+  static const int8_t STATUS_SBAS_FIX = 1;
+  static const int8_t STATUS_GBAS_FIX = 2;
+  
+  // Satellitensysteme der Lösung, Bits wie NavSatStatus
+  static const uint16_t SERVICE_GPS = 1;
+  static const uint16_t SERVICE_GLONASS = 2;
+  static const uint16_t SERVICE_COMPASS = 4;     // BeiDou
+  static const uint16_t SERVICE_GALILEO = 8;
   
   // Datenfelder
-  uint8_t status;
+  int8_t status;
+  uint16_t service;             // 0 = unbekannt
   double latitude;
   double longitude;
   double altitude;
@@ -38,10 +45,13 @@ struct NavSatFixData {
   uint8_t hour;
   uint8_t minute;
   uint8_t second;
+  int32_t nanosecond;   // Bruchteil der Sekunde, bei UBX auch negativ möglich
+  bool time_valid;      // Datum und Uhrzeit der Lösung sind gültig
   
   // Initialisierung
   NavSatFixData() {
     status = STATUS_NO_FIX;
+    service = 0;
     latitude = 0.0;
     longitude = 0.0;
     altitude = 0.0;
@@ -63,39 +73,57 @@ struct NavSatFixData {
     hour = 0;
     minute = 0;
     second = 0;
+    nanosecond = 0;
+    time_valid = false;
   }
   
-  // Berechnet die Genauigkeit in Metern basierend auf HDOP
-  float getHorizontalAccuracyMeters() const {
-    // Typische Umrechnung: HDOP * 2.5m (für GPS)
-    return hdop * 2.5f;
+  // Gültigkeitszeitpunkt der Lösung (UTC) als Unix-Zeit in Nanosekunden, 0 wenn unbekannt
+  int64_t getUnixTimeNanos() const {
+    if (!time_valid) {
+      return 0;
+    }
+    // Tage seit 1970-01-01 ("days from civil", proleptischer gregorianischer Kalender)
+    int32_t y = year - (month <= 2 ? 1 : 0);
+    int32_t era = y / 400;
+    int32_t yoe = y - era * 400;
+    int32_t doy = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    int32_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    int64_t days = (int64_t)era * 146097 + doe - 719468;
+    
+    int64_t seconds = days * 86400 + hour * 3600 + minute * 60 + second;
+    return seconds * 1000000000LL + nanosecond;
   }
   
-  // Berechnet die vertikale Genauigkeit (typischerweise 1.5x horizontale Genauigkeit)
-  float getVerticalAccuracyMeters() const {
-    return getHorizontalAccuracyMeters() * 1.5f;
+  // Diagonale Kovarianz (Ost, Nord, Hoch) aus Standardabweichungen in Metern
+  void setCovariance(float sigma_east, float sigma_north, float sigma_up, uint8_t type) {
+    clearCovariance();
+    position_covariance[0] = sigma_east * sigma_east;
+    position_covariance[4] = sigma_north * sigma_north;
+    position_covariance[8] = sigma_up * sigma_up;
+    position_covariance_type = type;
   }
   
-  // Aktualisiert die Kovarianzmatrix basierend auf HDOP
-  void updateCovariance() {
-    float horizontal_accuracy = getHorizontalAccuracyMeters();
-    float vertical_accuracy = getVerticalAccuracyMeters();
-    
-    // Diagonale Kovarianzmatrix (x, y, z)
-    position_covariance[0] = horizontal_accuracy * horizontal_accuracy; // x-Varianz
-    position_covariance[4] = horizontal_accuracy * horizontal_accuracy; // y-Varianz
-    position_covariance[8] = vertical_accuracy * vertical_accuracy;     // z-Varianz
-    
-    // Andere Elemente auf 0 setzen (keine Korrelation)
-    position_covariance[1] = position_covariance[2] = position_covariance[3] = 0;
-    position_covariance[5] = position_covariance[6] = position_covariance[7] = 0;
-    
-    // Setze Kovarianztyp
-    if (satellites > 0 && hdop > 0) {
-      position_covariance_type = COVARIANCE_TYPE_APPROXIMATED;
-    } else {
-      position_covariance_type = COVARIANCE_TYPE_UNKNOWN;
+  // Horizontale Kovarianz aus der Fehlerellipse, Richtung der großen Halbachse ab Nord über Ost.
+  // Die Korrelation zwischen Lage und Höhe ist unbekannt und bleibt 0.
+  void setCovarianceFromEllipse(float sigma_major, float sigma_minor, float orientation_deg, float sigma_up) {
+    float angle = orientation_deg * (float)DEG_TO_RAD;
+    float s = sinf(angle);
+    float c = cosf(angle);
+    float major2 = sigma_major * sigma_major;
+    float minor2 = sigma_minor * sigma_minor;
+    clearCovariance();
+    position_covariance[0] = major2 * s * s + minor2 * c * c;   // Ost
+    position_covariance[4] = major2 * c * c + minor2 * s * s;   // Nord
+    position_covariance[1] = position_covariance[3] = (major2 - minor2) * s * c;
+    position_covariance[8] = sigma_up * sigma_up;
+    position_covariance_type = COVARIANCE_TYPE_KNOWN;
+  }
+  
+  void clearCovariance() {
+    for (int i = 0; i < 9; i++) {
+      position_covariance[i] = 0.0;
     }
+    position_covariance_type = COVARIANCE_TYPE_UNKNOWN;
   }
 };
 
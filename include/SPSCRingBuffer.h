@@ -0,0 +1,132 @@
+#pragma once
+#include <Arduino.h>
+#include <atomic>
+
+/**
+ * @brief Lock-freier Single-Producer/Single-Consumer Ringpuffer
+ *
+ * Genau ein Producer (z.B. eine ISR) ruft push() auf, genau ein Consumer
+ * (z.B. loop()) ruft pop()/read() auf. Es werden keine Interrupts gesperrt.
+ * Head und Tail laufen frei über den gesamten uint32_t-Bereich, dadurch ist
+ * "voll" und "leer" ohne zusätzliches Flag unterscheidbar.
+ *
+ * @tparam T Elementtyp
+ * @tparam CAPACITY Anzahl der Elemente, muss eine Zweierpotenz sein
+ */
+template <typename T, uint32_t CAPACITY>
+class SPSCRingBuffer {
+    static_assert(CAPACITY > 0 && (CAPACITY & (CAPACITY - 1)) == 0,
+                  "SPSCRingBuffer: CAPACITY muss eine Zweierpotenz sein");
+
+public:
+    SPSCRingBuffer()
+        : head(0)
+        , tail(0)
+        , overflowCount(0)
+        , highWaterMark(0)
+    {
+    }
+
+    // Nur vom Producer aufrufen
+    bool push(const T& value) {
+        uint32_t h = head.load(std::memory_order_relaxed);
+        uint32_t used = h - tail.load(std::memory_order_acquire);
+        if (used >= CAPACITY) {
+            // Puffer voll - Element verwerfen und zählen
+            overflowCount++;
+            return false;
+        }
+        buffer[h & MASK] = value;
+        head.store(h + 1, std::memory_order_release);
+
+        if (used + 1 > highWaterMark) {
+            highWaterMark = used + 1;
+        }
+        return true;
+    }
+
+    // Nur vom Consumer aufrufen
+    bool pop(T& value) {
+        uint32_t t = tail.load(std::memory_order_relaxed);
+        if (t == head.load(std::memory_order_acquire)) {
+            return false;
+        }
+        value = buffer[t & MASK];
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Liest das älteste Element, ohne es zu entnehmen, nur vom Consumer aufrufen
+    bool peek(T& value) const {
+        uint32_t t = tail.load(std::memory_order_relaxed);
+        if (t == head.load(std::memory_order_acquire)) {
+            return false;
+        }
+        value = buffer[t & MASK];
+        return true;
+    }
+
+    // Liest bis zu maxCount Elemente am Stück, nur vom Consumer aufrufen
+    uint32_t read(T* dest, uint32_t maxCount) {
+        uint32_t t = tail.load(std::memory_order_relaxed);
+        uint32_t count = head.load(std::memory_order_acquire) - t;
+        if (count > maxCount) {
+            count = maxCount;
+        }
+        for (uint32_t i = 0; i < count; i++) {
+            dest[i] = buffer[(t + i) & MASK];
+        }
+        tail.store(t + count, std::memory_order_release);
+        return count;
+    }
+
+    // Liefert den zusammenhängend lesbaren Bereich ohne Kopie, danach consume() aufrufen
+    uint32_t peekContiguous(const T*& ptr) const {
+        uint32_t t = tail.load(std::memory_order_relaxed);
+        uint32_t count = head.load(std::memory_order_acquire) - t;
+        uint32_t index = t & MASK;
+        if (count > CAPACITY - index) {
+            count = CAPACITY - index;
+        }
+        ptr = &buffer[index];
+        return count;
+    }
+
+    // Gibt count Elemente nach peekContiguous() frei, nur vom Consumer aufrufen
+    void consume(uint32_t count) {
+        tail.store(tail.load(std::memory_order_relaxed) + count, std::memory_order_release);
+    }
+
+    uint32_t available() const {
+        return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire);
+    }
+
+    bool isEmpty() const {
+        return available() == 0;
+    }
+
+    constexpr uint32_t capacity() const {
+        return CAPACITY;
+    }
+
+    // Anzahl der verworfenen Elemente seit dem Start
+    uint32_t getOverflowCount() const {
+        return overflowCount;
+    }
+
+    // Höchster gemessener Füllstand seit dem Start
+    uint32_t getHighWaterMark() const {
+        return highWaterMark;
+    }
+
+private:
+    static const uint32_t MASK = CAPACITY - 1;
+
+    T buffer[CAPACITY];
+    std::atomic<uint32_t> head;
+    std::atomic<uint32_t> tail;
+
+    // Statistik, wird nur vom Producer geschrieben
+    volatile uint32_t overflowCount;
+    volatile uint32_t highWaterMark;
+};
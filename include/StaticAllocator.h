@@ -0,0 +1,56 @@
+#pragma once
+#include <Arduino.h>
+#include <rcutils/allocator.h>
+
+/**
+ * @brief Allokator mit fester, zur Übersetzungszeit dimensionierter Arena
+ *
+ * Ersetzt malloc/free für rcl und rmw. Freie Blöcke liegen in einer nach
+ * Adresse sortierten Liste (First-Fit), benachbarte freie Blöcke werden beim
+ * Freigeben zusammengefasst. Damit hinterlässt ein vollständiger Abbau und
+ * Neuaufbau der micro-ROS-Entitäten keine Fragmentierung.
+ */
+class StaticAllocator {
+public:
+    StaticAllocator(uint8_t* arena, size_t size);
+
+    // rcutils-Allokator, der auf diese Arena verweist
+    rcutils_allocator_t getAllocator();
+
+    void* allocate(size_t size);
+    void deallocate(void* ptr);
+    void* reallocate(void* ptr, size_t size);
+    void* zeroAllocate(size_t count, size_t size);
+
+    // Statistik in Bytes (inkl. Blockköpfe)
+    size_t getCapacity() const;
+    size_t getUsed() const;
+    size_t getHighWaterMark() const;
+    size_t getLargestFreeBlock() const;
+    uint32_t getFailedAllocations() const;
+
+private:
+    struct Block {
+        size_t size;                // Gesamtgröße inkl. Kopf
+        Block* next;                // Nur in freien Blöcken gültig
+    };
+
+    static const size_t ALIGNMENT = 8;
+    static const size_t HEADER_SIZE = (sizeof(Block) + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+
+    uint8_t* arena;
+    size_t capacity;
+    Block* freeList;
+
+    size_t used;
+    size_t highWaterMark;
+    uint32_t failedAllocations;
+
+    void insertFree(Block* block);
+
+    // Einsprungpunkte für rcutils
+    static void* allocateCallback(size_t size, void* state);
+    static void deallocateCallback(void* ptr, void* state);
+    static void* reallocateCallback(void* ptr, size_t size, void* state);
+    static void* zeroAllocateCallback(size_t count, size_t size, void* state);
+};
@@ -3,11 +3,33 @@
 #include "driver/NCP5623.h"
 #include "config.h"
 
+// Neue Zustände bekommen hier einen Eintrag und ein Muster in StatusLEDPatterns.h
 enum BeaconLEDStatus {
     LED_STATUS_CONNECTING,
     LED_STATUS_CONNECTED_NO_FIX,
     LED_STATUS_CONNECTED_FIX,
-    LED_STATUS_ERROR
+    LED_STATUS_ERROR,
+    LED_STATUS_LOW_SATELLITES,
+    LED_STATUS_ROS_DEGRADED,
+    LED_STATUS_HATCH_OPEN,
+    LED_STATUS_COUNT
+};
+
+// Ein Schritt eines Musters: Farbe setzen, Strom rampen, halten
+struct StatusKeyframe {
+    uint8_t red;
+    uint8_t green;
+    uint8_t blue;
+    uint8_t current;     // LED-Strom in mA (0-30), 0 = aus
+    uint16_t rampMs;     // Dauer der Stromrampe, läuft im NCP5623; 0 = sofort
+    uint16_t holdMs;     // Haltezeit nach der Rampe
+};
+
+// Muster eines Zustands, mehrere Schritte laufen in einer Schleife
+struct StatusPattern {
+    BeaconLEDStatus status;
+    const StatusKeyframe* frames;
+    uint8_t count;
 };
 
 class StatusLEDManager {
@@ -16,16 +38,20 @@ public:
     void begin();
     void update();
     void setColor(uint8_t red, uint8_t green, uint8_t blue);
-    
+
     // RGB-LED Methoden
     void setStatus(BeaconLEDStatus status);
-    
+
+    // I2C-Statistik des LED-Treibers
+    void printStats(Print& out) const;
+
 private:
     NCP5623 rgbLED;
-    
+
     BeaconLEDStatus currentStatus;
-    bool ledState;
-    elapsedMillis blinkTimer;
-    
-    void updateStatusLED();
+    uint8_t frameIndex;          // Aktueller Schritt des Musters
+    uint32_t frameStart;         // Planmäßiger Beginn des Schritts in Millisekunden
+
+    void startPattern();
+    void applyKeyframe();
 };
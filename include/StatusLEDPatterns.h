@@ -0,0 +1,110 @@
+#pragma once
+#include "StatusLEDManager.h"
+
+/**
+ * Muster der Status-LED
+ *
+ * Jeder Zustand ist eine Tabelle von Schritten (Farbe, Strom, Rampe, Haltezeit),
+ * die in einer Schleife abgespielt wird. Ein einzelner Schritt ist ein
+ * statisches Licht. Rampen dimmt der NCP5623 selbst, die CPU schreibt pro
+ * Schritt nur die geänderten Register. Farbwechsel sind sofort, für weiche
+ * Übergänge zwischen Farben über Strom 0 gehen.
+ */
+namespace StatusLEDPatterns {
+
+constexpr uint8_t MAX_CURRENT = 30;   // Voller LED-Strom in mA
+
+// Cyan, weiches Pulsieren
+constexpr StatusKeyframe CONNECTING[] = {
+    {0, 255, 255, MAX_CURRENT, 400, 100},
+    {0, 255, 255, 0,           400, 100},
+};
+
+// Cyan blinkend
+constexpr StatusKeyframe CONNECTED_NO_FIX[] = {
+    {0, 255, 255, MAX_CURRENT, 0, 1000},
+    {0, 255, 255, 0,           0, 1000},
+};
+
+// Blau statisch
+constexpr StatusKeyframe CONNECTED_FIX[] = {
+    {0, 0, 255, MAX_CURRENT, 0, 0},
+};
+
+// Rot blinkend
+constexpr StatusKeyframe CONNECTION_ERROR[] = {
+    {255, 0, 0, MAX_CURRENT, 0, 250},
+    {255, 0, 0, 0,           0, 250},
+};
+
+// Blau, langsames Atmen zwischen hell und gedimmt
+constexpr StatusKeyframe LOW_SATELLITES[] = {
+    {0, 0, 255, MAX_CURRENT, 1000, 0},
+    {0, 0, 255, 2,           1000, 0},
+};
+
+// Magenta, kurz eingeblendet
+constexpr StatusKeyframe ROS_DEGRADED[] = {
+    {255, 0, 255, MAX_CURRENT, 100, 400},
+    {255, 0, 255, 0,           100, 400},
+};
+
+// Gelb, Doppelblitz
+constexpr StatusKeyframe HATCH_OPEN[] = {
+    {255, 160, 0, MAX_CURRENT, 0, 150},
+    {255, 160, 0, 0,           0, 150},
+    {255, 160, 0, MAX_CURRENT, 0, 150},
+    {255, 160, 0, 0,           0, 700},
+};
+
+#define STATUS_PATTERN(status, frames) {status, frames, sizeof(frames) / sizeof(frames[0])}
+
+// Reihenfolge wie BeaconLEDStatus
+constexpr StatusPattern PATTERNS[] = {
+    STATUS_PATTERN(LED_STATUS_CONNECTING,       CONNECTING),
+    STATUS_PATTERN(LED_STATUS_CONNECTED_NO_FIX, CONNECTED_NO_FIX),
+    STATUS_PATTERN(LED_STATUS_CONNECTED_FIX,    CONNECTED_FIX),
+    STATUS_PATTERN(LED_STATUS_ERROR,            CONNECTION_ERROR),
+    STATUS_PATTERN(LED_STATUS_LOW_SATELLITES,   LOW_SATELLITES),
+    STATUS_PATTERN(LED_STATUS_ROS_DEGRADED,     ROS_DEGRADED),
+    STATUS_PATTERN(LED_STATUS_HATCH_OPEN,       HATCH_OPEN),
+};
+
+#undef STATUS_PATTERN
+
+constexpr uint32_t frameDuration(const StatusKeyframe& frame) {
+    return (uint32_t)frame.rampMs + frame.holdMs;
+}
+
+constexpr uint32_t patternDuration(const StatusPattern& pattern) {
+    uint32_t total = 0;
+    for (uint8_t i = 0; i < pattern.count; i++) {
+        total += frameDuration(pattern.frames[i]);
+    }
+    return total;
+}
+
+// Jeder Zustand hat genau ein Muster, wiederholte Muster haben eine Dauer
+constexpr bool patternsValid() {
+    for (uint8_t i = 0; i < LED_STATUS_COUNT; i++) {
+        const StatusPattern& pattern = PATTERNS[i];
+        if (pattern.status != i || pattern.count == 0) {
+            return false;
+        }
+        if (pattern.count > 1 && patternDuration(pattern) == 0) {
+            return false;
+        }
+        for (uint8_t f = 0; f < pattern.count; f++) {
+            if (pattern.frames[f].current > MAX_CURRENT) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static_assert(sizeof(PATTERNS) / sizeof(PATTERNS[0]) == LED_STATUS_COUNT,
+              "StatusLEDPatterns: ein Muster je BeaconLEDStatus");
+static_assert(patternsValid(), "StatusLEDPatterns: Reihenfolge, Dauer oder Strom ungültig");
+
+}  // namespace StatusLEDPatterns
@@ -0,0 +1,77 @@
+#pragma once
+#include <Arduino.h>
+#include "config.h"
+#include "LatencyHistogram.h"
+
+/**
+ * @brief Kooperativer Scheduler mit fester Tasktabelle
+ *
+ * Jeder Task hat eine Periode, eine relative Deadline und eine Priorität.
+ * run() führt pro Aufruf genau einen fälligen Task aus, und zwar den mit der
+ * frühesten absoluten Deadline (bei Gleichstand die höhere Priorität).
+ * Tasks müssen non-blocking sein und sofort zurückkehren.
+ *
+ * Laufzeiten werden mit dem Zykluszähler gemessen (CycleCounter), zusätzlich
+ * die Startverzögerung gegenüber der Freigabe. Beides landet je Task in
+ * einem LatencyHistogram.
+ */
+class TaskScheduler {
+public:
+    typedef void (*TaskFunction)();
+
+    struct TaskStats {
+        uint32_t runs;
+        uint32_t overruns;          // Laufzeit länger als die relative Deadline
+        uint32_t missedDeadlines;   // Start erst nach Ablauf der Deadline
+        uint32_t min_cycles;
+        uint32_t max_cycles;
+        uint64_t total_cycles;
+        uint32_t maxLatency_us;     // Größte Verzögerung zwischen Freigabe und Start
+        LatencyHistogram execution; // Laufzeit in µs
+        LatencyHistogram latency;   // Startverzögerung in µs
+    };
+
+    TaskScheduler();
+
+    // Periode 0 = bei jedem Durchlauf bereit, gibt die Task-ID oder -1 zurück
+    int8_t addTask(const char* name, TaskFunction function, uint32_t period_us, uint32_t deadline_us, uint8_t priority);
+
+    // Aus loop() aufrufen, gibt true zurück, wenn ein Task lief
+    bool run();
+
+    uint8_t getTaskCount() const;
+    const char* getTaskName(uint8_t id) const;
+    const TaskStats& getStats(uint8_t id) const;
+    void resetStats();
+    void printStats(Print& out) const;
+    void printHistograms(Print& out) const;
+
+    /**
+     * Statistik als Binärframe, Felder little-endian:
+     *
+     *   'T' 'S'  version(u8)  length(u16)  payload  ck_a ck_b
+     *
+     * payload: cycles_per_us(u32) uptime_ms(u32) tasks(u8) buckets(u8),
+     * danach je Task: name(8 Byte, mit 0 aufgefüllt) runs overruns missed
+     * min_cycles max_cycles (je u32) total_cycles(u64) max_latency_us(u32)
+     * execution[buckets] latency[buckets] (je u32).
+     * Die Prüfsumme ist Fletcher-8 über version bis Ende payload wie bei UBX.
+     */
+    void dumpStats(Print& out) const;
+
+private:
+    struct Task {
+        const char* name;
+        TaskFunction function;
+        uint32_t period_us;
+        uint32_t deadline_us;
+        uint8_t priority;           // Größer = wichtiger
+        uint32_t release_us;        // Nächster Freigabezeitpunkt
+        TaskStats stats;
+    };
+
+    Task tasks[SCHEDULER_MAX_TASKS];
+    uint8_t taskCount;
+
+    static void clearStats(TaskStats& stats);
+};
@@ -0,0 +1,105 @@
+#pragma once
+#include <Arduino.h>
+#include "config.h"
+
+/**
+ * @brief Lineares Uhrenmodell: lokale Mikrosekunden -> Referenzzeit in Nanosekunden
+ *
+ * Aus den letzten TIME_SYNC_WINDOW Stützpunkten wird per Ausgleichsgerade
+ * Offset und Drift der lokalen Uhr gegenüber der Referenz geschätzt.
+ */
+class ClockEstimator {
+public:
+    ClockEstimator();
+
+    void reset();
+    // false, wenn der Stützpunkt als Ausreißer verworfen wurde
+    bool addSample(uint64_t local_us, int64_t reference_ns);
+
+    bool isValid() const;
+    uint8_t getSampleCount() const;
+    uint32_t getRejectedSamples() const;
+
+    int64_t toReference(uint64_t local_us) const;
+    uint64_t toLocal(int64_t reference_ns) const;
+
+    // Gangabweichung der lokalen Uhr in ppm (positiv = lokale Uhr zu langsam)
+    float getDriftPpm() const;
+
+private:
+    struct Sample {
+        uint64_t local_us;
+        int64_t reference_ns;
+    };
+
+    Sample samples[TIME_SYNC_WINDOW];
+    uint8_t count;
+    uint8_t next;
+    uint8_t outliers;           // Ausreißer in Folge
+    uint32_t rejectedSamples;
+
+    // Ergebnis der Anpassung: reference = baseReference + (local - baseLocal) * slope
+    uint64_t baseLocal;
+    int64_t baseReference;
+    double slope;               // ns pro µs
+
+    void fit();
+};
+
+/**
+ * @brief Zeitbasis der Bake
+ *
+ * Erweitert micros() auf 64 Bit, erfasst die PPS-Flanke des Empfängers per
+ * Interrupt und führt zwei Uhrenmodelle: lokal -> UTC (PPS-diszipliniert)
+ * und lokal -> Agentenzeit (aus rmw_uros_sync_session).
+ */
+class TimeSync {
+public:
+    // PPS-Flanke, wie sie beim Beginn eines Epochen-Bursts zuletzt erfasst war
+    struct PPSEdge {
+        uint32_t micros;        // Lokaler Zeitpunkt der Flanke
+        uint32_t count;         // Laufende Nummer der Flanke, 0 = noch keine
+    };
+
+    TimeSync();
+    void begin(int ppsPin);
+
+    // Lokale Zeit in µs, 64 Bit ohne Überlauf
+    uint64_t nowMicros();
+    // Erweitert einen früher erfassten micros()-Wert auf 64 Bit
+    uint64_t extendMicros(uint32_t captured_us);
+
+    // Agentenzeit
+    void addAgentSample(uint64_t local_us, int64_t agent_ns, uint32_t round_trip_us);
+    bool isAgentSynchronized() const;
+    int64_t toAgentNanos(uint64_t local_us) const;
+    void resetAgent();
+
+    // Letzte PPS-Flanke, auch aus einer ISR aufrufbar (Empfangs-ISR beim Beginn eines Bursts)
+    static PPSEdge latchPPS();
+    // GNSS/PPS: pro Epoche mit UTC-Gültigkeitszeit, lokalem Empfangsbeginn und
+    // der beim Empfangsbeginn erfassten PPS-Flanke aufrufen
+    void addGnssEpoch(int64_t utc_ns, uint32_t arrival_us, const PPSEdge& pps);
+    bool isPPSDisciplined() const;
+    // Lokaler Zeitpunkt, zu dem die Lösung gültig war
+    uint64_t timeOfValidity(int64_t utc_ns, uint32_t arrival_us);
+
+    const ClockEstimator& getAgentClock() const;
+    const ClockEstimator& getPPSClock() const;
+    uint32_t getPPSCount() const;
+    uint32_t getRejectedAgentSamples() const;
+
+private:
+    ClockEstimator agentClock;
+    ClockEstimator ppsClock;
+
+    uint32_t lastMicros;
+    uint32_t microsHigh;
+
+    uint32_t lastUsedPPSCount;
+    uint32_t rejectedAgentSamples;
+
+    static volatile uint32_t ppsMicros;
+    static volatile uint32_t ppsCount;
+    static void ppsISR();
+};
@@ -0,0 +1,126 @@
+#pragma once
+#include <Arduino.h>
+
+// UBX-Rahmen
+#define UBX_SYNC_CHAR_1 0xB5
+#define UBX_SYNC_CHAR_2 0x62
+#define UBX_MAX_PAYLOAD 768         // NAV-SAT mit bis zu 63 Satelliten
+
+// Nachrichtenklassen und IDs
+#define UBX_CLASS_NAV 0x01
+#define UBX_CLASS_ACK 0x05
+#define UBX_CLASS_CFG 0x06
+#define UBX_NAV_DOP 0x04
+#define UBX_NAV_PVT 0x07
+#define UBX_NAV_SAT 0x35
+#define UBX_ACK_NAK 0x00
+#define UBX_ACK_ACK 0x01
+#define UBX_CFG_PRT 0x00
+#define UBX_CFG_MSG 0x01
+#define UBX_CFG_RATE 0x08
+
+// Navigationslösung aus NAV-PVT, NAV-DOP und NAV-SAT
+struct UBXNavSolution {
+    // NAV-PVT
+    uint32_t iTOW = 0;              // GPS time of week der Lösung in ms
+    uint16_t year = 0;
+    uint8_t month = 0;
+    uint8_t day = 0;
+    uint8_t hour = 0;
+    uint8_t minute = 0;
+    uint8_t second = 0;
+    int32_t nano = 0;               // Bruchteil der Sekunde in ns (kann negativ sein)
+    bool dateValid = false;
+    bool timeValid = false;
+    uint8_t fixType = 0;            // 0 kein Fix, 1 DR, 2 2D, 3 3D, 4 GNSS+DR, 5 nur Zeit
+    bool gnssFixOK = false;
+    bool diffSoln = false;
+    uint8_t numSV = 0;
+    int32_t longitude_e7 = 0;       // Grad * 1e7
+    int32_t latitude_e7 = 0;        // Grad * 1e7
+    int32_t hMSL_mm = 0;            // Höhe über MSL in mm
+    uint32_t hAcc_mm = 0;           // Horizontale Genauigkeit in mm
+    uint32_t vAcc_mm = 0;           // Vertikale Genauigkeit in mm
+    int32_t gSpeed_mmps = 0;        // Geschwindigkeit über Grund in mm/s
+    int32_t headMot_e5 = 0;         // Bewegungsrichtung in Grad * 1e5
+
+    // NAV-DOP (in 1/100)
+    uint16_t pDOP = 0;
+    uint16_t hDOP = 0;
+    uint16_t vDOP = 0;
+
+    // NAV-SAT
+    uint8_t numSvsUsed = 0;         // In der Lösung verwendete Satelliten
+    uint8_t gnssUsedMask = 0;       // Bit n gesetzt = gnssId n in der Lösung verwendet
+};
+
+/**
+ * @brief Decoder für das binäre UBX-Protokoll von u-blox
+ *
+ * Sucht die Sync-Zeichen, prüft die Fletcher-Prüfsumme und wertet
+ * NAV-PVT, NAV-DOP, NAV-SAT sowie ACK-Nachrichten aus.
+ */
+class UBXParser {
+public:
+    enum MessageType {
+        MESSAGE_NAV_PVT = 0x01,
+        MESSAGE_NAV_DOP = 0x02,
+        MESSAGE_NAV_SAT = 0x04,
+        MESSAGE_ACK = 0x08
+    };
+
+    UBXParser();
+
+    // Verarbeitet einen Block Eingangsdaten, gibt eine Bitmaske der ausgewerteten Nachrichten zurück
+    uint8_t feed(const uint8_t* data, uint32_t length);
+
+    const UBXNavSolution& getSolution() const;
+
+    // Letzte Bestätigung einer CFG-Nachricht
+    bool isAcknowledged(uint8_t msgClass, uint8_t msgId) const;
+    void clearAcknowledge();
+
+    // Statistik
+    uint32_t getMessageCount() const;
+    uint32_t getChecksumErrorCount() const;
+
+    // Baut einen kompletten UBX-Rahmen inkl. Prüfsumme, gibt die Rahmenlänge zurück
+    static uint16_t buildFrame(uint8_t msgClass, uint8_t msgId, const uint8_t* payload, uint16_t length,
+                               uint8_t* frame, uint16_t frameSize);
+
+private:
+    enum State {
+        STATE_SYNC1,
+        STATE_SYNC2,
+        STATE_CLASS,
+        STATE_ID,
+        STATE_LENGTH1,
+        STATE_LENGTH2,
+        STATE_PAYLOAD,
+        STATE_CK_A,
+        STATE_CK_B
+    };
+
+    UBXNavSolution solution;
+
+    State state;
+    uint8_t msgClass;
+    uint8_t msgId;
+    uint16_t payloadLength;
+    uint16_t payloadIndex;
+    uint8_t ckA;
+    uint8_t ckB;
+    uint8_t payload[UBX_MAX_PAYLOAD];
+
+    uint8_t ackClass;
+    uint8_t ackId;
+    bool ackReceived;
+
+    uint32_t messageCount;
+    uint32_t checksumErrors;
+
+    uint8_t handleMessage();
+    void parseNavPVT();
+    void parseNavDOP();
+    void parseNavSAT();
+};
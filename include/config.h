@@ -2,36 +2,98 @@
 
 // Publish-Raten (in Millisekunden)
 #define HATCH_PUBLISH_RATE_MS 500
+#define HATCH_PUBLISH_ON_CHANGE 1   // 1 = sofort bei Zustandswechsel plus Heartbeat, 0 = fest alle HATCH_PUBLISH_RATE_MS
+#define HATCH_HEARTBEAT_MS 2000     // Wiederholung des unveränderten Zustands
 #define GPS_PUBLISH_RATE_MS 500
+#define GPS_PUBLISH_ON_NEW_FIX 1    // 1 = genau einmal pro neuer GNSS-Epoche senden, 0 = fest alle GPS_PUBLISH_RATE_MS
 #define LED_ANIMATION_FEEDBACK_RATE_MS 200
+#define DIAGNOSTICS_PUBLISH_RATE_MS 1000    // Eine Task-Statistik pro Nachricht, reihum
+#define LED_ANIMATION_GOAL_HANDLES 4        // Ein laufendes Ziel je LED-Ebene + ein nachfolgendes Ziel
 
 // Pin-Definitionen
 #define HATCH_LEFT_PIN 2
 #define HATCH_RIGHT_PIN 3
+#define HATCH_DEBOUNCE_US 5000      // Sperrzeit nach einem Zustandswechsel
+#define HATCH_EVENT_BUFFER_SIZE 16  // Flanken zwischen ISR und loop(), muss Zweierpotenz sein
 #define GPS_SERIAL Serial3
 #define GPS_BAUD 38400
 
-// LED-Statusanzeige
-#define LED_STATUS_CONNECTING_R 0
-#define LED_STATUS_CONNECTING_G 255
-#define LED_STATUS_CONNECTING_B 255  // Cyan
-#define LED_STATUS_CONNECTED_NO_FIX_R 0
-#define LED_STATUS_CONNECTED_NO_FIX_G 255
-#define LED_STATUS_CONNECTED_NO_FIX_B 255  // Cyan
-#define LED_STATUS_CONNECTED_FIX_R 0
-#define LED_STATUS_CONNECTED_FIX_G 0
-#define LED_STATUS_CONNECTED_FIX_B 255  // Blau
-#define LED_STATUS_ERROR_R 255
-#define LED_STATUS_ERROR_G 0
-#define LED_STATUS_ERROR_B 0  // Rot
-
-// Blink-Intervalle (in Millisekunden)
-#define BLINK_INTERVAL_CONNECTING 500
-#define BLINK_INTERVAL_NO_FIX 1000
-#define BLINK_INTERVAL_ERROR 250
+// GPS-Empfangspuffer
+#define GPS_SERIAL_RX_EXTRA_BYTES 256   // Zusätzlicher Speicher für den UART-Empfangspuffer des Cores
+#define GPS_INGEST_BUFFER_SIZE 4096     // Ringpuffer zwischen ISR und loop(), muss Zweierpotenz sein (>1 s bei 38400 Baud)
+#define GPS_INGEST_POLL_US 1000         // Intervall der Empfangs-ISR in Mikrosekunden
+#define GPS_INGEST_BURSTS 16            // Epochen-Bursts im Ringpuffer (Empfangsbeginn, PPS-Flanke), muss Zweierpotenz sein
+
+// GPS-Protokoll
+// Die Kovarianz aus GST (Fehlerstatistik) und GSA (DOP) gibt es nur mit
+// GPS_USE_UBX 0. Im UBX-Betrieb stammt sie aus hAcc/vAcc von NAV-PVT
+// (DIAGONAL_KNOWN), die GPS_NMEA_*-Werte wirken dann nicht.
+#define GPS_USE_UBX 1                   // 1 = Empfänger beim Start auf UBX-Binärausgabe umstellen, 0 = NMEA
+#define GPS_UBX_MEAS_RATE_MS 200        // Messrate im UBX-Betrieb (200 ms = 5 Hz)
+#define GPS_UBX_SAT_RATE 5              // NAV-SAT nur bei jeder n-ten Lösung senden
+#define GPS_UBX_ACK_TIMEOUT_MS 250      // Wartezeit auf ACK je Konfigurationsnachricht
+#define GPS_NMEA_ERROR_MAX_AGE_MS 2000  // GST-Fehlerstatistik gilt nur für Lösungen in diesem Zeitabstand
+#define GPS_NMEA_UERE_M 2.5f            // Entfernungsfehler für die DOP-Schätzung, wenn GST keinen RMS-Wert liefert
+
+// Zeitsynchronisation
+#define GPS_PPS_PIN -1                  // Timepulse-Ausgang des Empfängers, -1 = nicht angeschlossen
+#define GPS_BURST_GAP_US 20000          // Empfangspause, nach der ein neuer Epochen-Burst beginnt
+#define TIME_SYNC_WINDOW 16             // Anzahl Stützpunkte für die Offset-/Driftschätzung
+#define TIME_SYNC_MAX_RTT_US 20000      // Sync-Stützpunkte mit längerer Laufzeit verwerfen
+#define TIME_SYNC_MAX_RESIDUAL_NS 500000000LL   // Stützpunkte weiter neben der Schätzung sind Ausreißer (0,5 s)
+#define TIME_SYNC_MAX_OUTLIERS 8        // So viele Ausreißer in Folge: die Referenz ist gesprungen, Schätzung neu beginnen
+
+// LED-Statusanzeige (Muster in StatusLEDPatterns.h)
+#define STATUS_LED_LOW_SATELLITES 6         // Fix mit weniger Satelliten wird als schwach angezeigt
+
+// micro-ROS Verbindung
+// Das Budget gilt für einen ganzen update()-Aufruf: Ping, Zeitsynchronisation,
+// angelegte Entität (eine pro update()) und zuverlässig gesendete Nachrichten
+// warten zusammen höchstens so lange, jeder Aufruf nur mit dem Rest. Was nicht
+// mehr hineinpasst, wird im nächsten update() gesendet.
+// Ausnahmen: der Sitzungsaufbau in rclc_support_init() (Wartezeit und Versuche
+// aus der rmw_microxrcedds-Konfiguration, läuft aber erst nach einem
+// erfolgreichen Ping) sowie Feedback und Ergebnis des Action Servers, deren
+// Publisher rclc intern anlegt (RMW_UXRCE_PUBLISH_RELIABLE_TIMEOUT). Sie
+// starten nur mit Restbudget, können es aber überschreiten.
+#define ROS_BLOCKING_BUDGET_MS 20           // Maximale Wartezeit auf den Agenten je update()
+#define ROS_PING_INTERVAL_CONNECTED_MS 1000 // Ping-Intervall bei bestehender Verbindung
+#define ROS_PING_MAX_FAILURES 3             // Aufeinanderfolgende Fehlschläge bis zur Trennung
+#define ROS_PING_BACKOFF_MIN_MS 100         // Erstes Ping-Intervall beim Warten auf den Agenten
+#define ROS_PING_BACKOFF_MAX_MS 4000        // Maximales Ping-Intervall beim Warten auf den Agenten
+#define ROS_TIME_SYNC_INTERVAL_MS 10000     // Zeitsynchronisation bei eingeschwungener Schätzung
+#define ROS_TIME_SYNC_FAST_INTERVAL_MS 1000 // Zeitsynchronisation, solange noch wenige Stützpunkte vorliegen
+#define ROS_TIME_SYNC_FAST_SAMPLES 4
+#define ROS_ALLOCATOR_ARENA_SIZE (32 * 1024)  // Statische Arena für rcl/rmw, mit getHighWaterMark() nachmessen
+
+// Scheduler (Perioden und relative Deadlines in Mikrosekunden, Priorität: größer = wichtiger)
+#define SCHEDULER_MAX_TASKS 8
+#define SCHEDULER_STATS_PRINT_MS 0          // Laufzeitstatistik periodisch ausgeben, 0 = nur auf Anfrage ('s' über Serial)
+#define LATENCY_HISTOGRAM_BUCKETS 16        // <1 µs, dann Zweierpotenzen bis >=16 ms
+#define TASK_HATCH_PERIOD_US 1000
+#define TASK_HATCH_DEADLINE_US 1000
+#define TASK_HATCH_PRIORITY 5
+#define TASK_GPS_PERIOD_US 2000
+#define TASK_GPS_DEADLINE_US 2000
+#define TASK_GPS_PRIORITY 4
+#define TASK_LED_PERIOD_US 1000
+#define TASK_LED_DEADLINE_US 2000
+#define TASK_LED_PRIORITY 3
+#define TASK_ROS_PERIOD_US 2000
+#define TASK_ROS_DEADLINE_US 25000          // Agent-Aufrufe dürfen bis ROS_BLOCKING_BUDGET_MS blockieren
+#define TASK_ROS_PRIORITY 2
+#define TASK_STATUS_PERIOD_US 20000
+#define TASK_STATUS_DEADLINE_US 20000
+#define TASK_STATUS_PRIORITY 1
+#define TASK_STATS_PERIOD_US 100000
+#define TASK_STATS_DEADLINE_US 100000
+#define TASK_STATS_PRIORITY 0
 
 // ROS-Topics
 #define ROS_NAMESPACE "/Beacon/"
 #define TOPIC_HATCH_STATUS "hatchIsOpen"
+#define TOPIC_HATCH_LEFT "hatchLeftIsOpen"
+#define TOPIC_HATCH_RIGHT "hatchRightIsOpen"
 #define TOPIC_GPS "gps"
+#define TOPIC_DIAGNOSTICS "/diagnostics"    // Globales Topic des diagnostic_aggregator, ohne ROS_NAMESPACE
 #define ACTION_LED_ANIMATION "led_animation"
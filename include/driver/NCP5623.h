@@ -6,7 +6,39 @@
 
 #define NCP5623_REG_ILED 0x1
 #define NCP5623_REG_CHANNEL_BASE 0x2
+#define NCP5623_REG_UPWARD 0x5      // Zielwert für Aufwärtsdimmen
+#define NCP5623_REG_DOWNWARD 0x6    // Zielwert für Abwärtsdimmen
+#define NCP5623_REG_DIMMING 0x7     // Zeit je Dimmstufe, startet das Dimmen
+#define NCP5623_REG_COUNT 8
 
+#define NCP5623_DIMMING_STEP_MS 8   // Einheit der Zeit je Dimmstufe
+
+#define NCP5623_TRANSFER_TIMEOUT_US 2000  // Abbruch, wenn der Bus so lange kein Wort abnimmt und kein STOP meldet
+
+// Teensy 4.x: Übertragung über den TX-FIFO des LPI2C1 (Wire), ohne auf den Bus zu warten.
+// Tests setzen den Wert selbst und bringen einen LPI2C-Ersatz mit
+#ifndef NCP5623_ASYNC_I2C
+#if defined(__IMXRT1062__)
+#define NCP5623_ASYNC_I2C 1
+#else
+#define NCP5623_ASYNC_I2C 0
+#endif
+#endif
+
+/**
+ * Treiber für den RGB-LED-Treiber NCP5623
+ *
+ * Schreibzugriffe landen in einem Registerabbild. Unveränderte Werte werden
+ * verworfen, geänderte Register werden in update() zu einer einzigen
+ * I2C-Übertragung zusammengefasst (ein Befehlsbyte rrrvvvvv je Register).
+ * Ändert sich ein Register mehrfach vor der Übertragung, wird nur der letzte
+ * Wert geschrieben. Auf dem Teensy 4 füllt update() die Übertragung in den
+ * FIFO des I2C-Controllers und kehrt sofort zurück, spätere Aufrufe schließen
+ * sie ab. Fehlgeschlagene Register werden beim nächsten update() wiederholt.
+ *
+ * fadeCurrent() lässt den Baustein den LED-Strom selbst Stufe für Stufe
+ * auf den Zielwert dimmen, der Bus wird dafür nur einmal benutzt.
+ */
 class NCP5623 {
 public:
     NCP5623();
@@ -16,14 +48,43 @@ public:
     void setGreen(uint8_t value);
     void setBlue(uint8_t value);
     void setCurrent(uint8_t iled);
+    void fadeCurrent(uint8_t iled, uint16_t duration_ms); // Dims from the current level in hardware
     void mapColors(uint8_t red, uint8_t green, uint8_t blue);
-    
+
+    void update();              // Call this regularly, advances or starts a transfer
+    void flush();               // Blocks until all pending registers are written
+    bool isBusy() const;        // Transfer in progress or registers pending
+
+    // Statistics
+    uint32_t getTransferCount() const;  // I2C transfers started
+    uint32_t getSkippedCount() const;   // Register writes dropped because the value was unchanged
+    uint32_t getErrorCount() const;     // Failed transfers (NACK, arbitration lost, timeout)
+
 private:
     uint8_t _addr;
     uint8_t _red;
     uint8_t _green;
     uint8_t _blue;
-    
+
+    uint8_t shadow[NCP5623_REG_COUNT];  // Zuletzt angeforderte Registerwerte
+    uint8_t validMask;                  // Register, deren Wert im Baustein steht
+    uint8_t dirtyMask;                  // Register, die noch übertragen werden müssen
+    uint8_t transferMask;               // Register der laufenden Übertragung
+
+    uint8_t txBuffer[NCP5623_REG_COUNT];
+    uint8_t txLength;
+    uint8_t txIndex;                    // Nächstes Wort für den FIFO (START, Daten, STOP)
+    bool transferActive;
+    elapsedMicros transferTimer;        // Zeit seit dem letzten Wort, das in den FIFO ging
+
+    uint32_t transferCount;
+    uint32_t skippedCount;
+    uint32_t errorCount;
+
     void setChannel(uint8_t channel, uint8_t value);
-    void writeReg(uint8_t reg, uint8_t value);
+    void writeReg(uint8_t reg, uint8_t value, bool force = false);
+    void startTransfer();
+    void pollTransfer();
+    void abortTransfer();
+    void finishTransfer(bool success);
 };
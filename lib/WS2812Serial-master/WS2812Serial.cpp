@@ -230,116 +230,74 @@ bool WS2812Serial::begin()
 	return true;
 }
 
-void WS2812Serial::show()
+bool WS2812Serial::transferActive()
 {
-	uint32_t microseconds_per_led, bytes_per_led;
+	if (!dma) return false;
+#if defined(KINETISK) || defined(__IMXRT1062__)
+	return (DMA_ERQ & (1 << dma->channel)) != 0;
+#elif defined(KINETISL)
+	return (dma->CFG->DCR & DMA_DCR_ERQ) != 0;
+#endif
+}
 
-	// wait if prior DMA still in progress
-#if defined(KINETISK)
-	while ((DMA_ERQ & (1 << dma->channel))) {
-		yield();
+bool WS2812Serial::busy()
+{
+	// prior DMA still in progress?
+	if (transferActive()) return true;
+	// WS2812 reset time after the last transfer
+	uint32_t min_elapsed = (numled * ((config < 6) ? 30 : 40)) + 300;
+	return (micros() - prior_micros) <= min_elapsed;
+}
+
+bool WS2812Serial::poll()
+{
+	if (!pending || busy()) return false;
+	// swap: the queued buffer goes on the wire, the other one becomes idle
+	uint8_t *fb = backBuffer;
+	backBuffer = frameBuffer;
+	frameBuffer = fb;
+	pending = false;
+	prior_micros = micros();
+	startTransfer(frameBuffer, (config < 6) ? 12 : 16);
+	return true;
+}
+
+bool WS2812Serial::tryShow()
+{
+	if (!backBuffer) {
+		// single buffer: encoding would overwrite the frame on the wire
+		if (busy()) return false;
+		uint32_t bytes_per_led = encode(frameBuffer);
+		prior_micros = micros();
+		startTransfer(frameBuffer, bytes_per_led);
+		return true;
 	}
-#elif defined(KINETISL)
-	while ((dma->CFG->DCR & DMA_DCR_ERQ)) {
-		yield();
+	// a queued frame goes first, frames are never dropped or reordered
+	poll();
+	if (pending) return false;
+	// the back buffer is never the one being transmitted
+	encode(backBuffer);
+	pending = true;
+	poll();
+	return true;
+}
+
+void WS2812Serial::show()
+{
+	if (backBuffer) {
+		while (!tryShow()) {
+			yield();
+		}
+		return;
 	}
-#elif defined(__IMXRT1062__)
-	//Serial.println("Show called");
-	while ((DMA_ERQ & (1 << dma->channel))) {
+
+	// wait if prior DMA still in progress
+	while (transferActive()) {
 		yield();
 	}
-	//Serial.println("After Yield");
-#endif
-	// copy drawing buffer to frame buffer
-	if (config < 6) {
-		// RGB
-		const uint8_t *p = drawBuffer;
-		const uint8_t *end = p + (numled * 3);
-		uint8_t *fb = frameBuffer;
-		while (p < end) {
-			uint8_t b = *p++;
-			uint8_t g = *p++;
-			uint8_t r = *p++;
-			uint32_t mult = brightness + 1;
-			b = (b * mult) >> 8;
-			g = (g * mult) >> 8;
-			r = (r * mult) >> 8;
-			uint32_t n=0;
-			switch (config) {
-			  case WS2812_RGB: n = (r << 16) | (g << 8) | b; break;
-			  case WS2812_RBG: n = (r << 16) | (b << 8) | g; break;
-			  case WS2812_GRB: n = (g << 16) | (r << 8) | b; break;
-			  case WS2812_GBR: n = (g << 16) | (b << 8) | r; break;
-			  case WS2812_BRG: n = (b << 16) | (r << 8) | g; break;
-			  case WS2812_BGR: n = (b << 16) | (g << 8) | r; break;
-			}
-			const uint8_t *stop = fb + 12;
-			do {
-				uint8_t x = 0x08;
-				if (!(n & 0x00800000)) x |= 0x07;
-				if (!(n & 0x00400000)) x |= 0xE0;
-				n <<= 2;
-				*fb++ = x;
-			} while (fb < stop);
-		}
-		microseconds_per_led = 30;
-		bytes_per_led = 12;
-	} else {
-		// RGBW
-		const uint8_t *p = drawBuffer;
-		const uint8_t *end = p + (numled * 4);
-		uint8_t *fb = frameBuffer;
-		while (p < end) {
-			uint8_t b = *p++;
-			uint8_t g = *p++;
-			uint8_t r = *p++;
-			uint8_t w = *p++;
-			uint32_t mult = brightness + 1;
-			b = (b * mult) >> 8;
-			g = (g * mult) >> 8;
-			r = (r * mult) >> 8;
-			w = (w * mult) >> 8;
-			uint32_t n=0;
-			switch (config) {
-			  case WS2812_RGBW: n = (r << 24) | (g << 16) | (b << 8) | w; break;
-			  case WS2812_RBGW: n = (r << 24) | (b << 16) | (g << 8) | w; break;
-			  case WS2812_GRBW: n = (g << 24) | (r << 16) | (b << 8) | w; break;
-			  case WS2812_GBRW: n = (g << 24) | (b << 16) | (r << 8) | w; break;
-			  case WS2812_BRGW: n = (b << 24) | (r << 16) | (g << 8) | w; break;
-			  case WS2812_BGRW: n = (b << 24) | (b << 16) | (r << 8) | w; break;
-			  case WS2812_WRGB: n = (w << 24) | (r << 16) | (g << 8) | b; break;
-			  case WS2812_WRBG: n = (w << 24) | (r << 16) | (b << 8) | g; break;
-			  case WS2812_WGRB: n = (w << 24) | (g << 16) | (r << 8) | b; break;
-			  case WS2812_WGBR: n = (w << 24) | (g << 16) | (b << 8) | r; break;
-			  case WS2812_WBRG: n = (w << 24) | (b << 16) | (r << 8) | g; break;
-			  case WS2812_WBGR: n = (w << 24) | (b << 16) | (g << 8) | r; break;
-			  case WS2812_RWGB: n = (r << 24) | (w << 16) | (g << 8) | b; break;
-			  case WS2812_RWBG: n = (r << 24) | (w << 16) | (b << 8) | g; break;
-			  case WS2812_GWRB: n = (g << 24) | (w << 16) | (r << 8) | b; break;
-			  case WS2812_GWBR: n = (g << 24) | (w << 16) | (b << 8) | r; break;
-			  case WS2812_BWRG: n = (b << 24) | (w << 16) | (r << 8) | g; break;
-			  case WS2812_BWGR: n = (b << 24) | (w << 16) | (g << 8) | r; break;
-			  case WS2812_RGWB: n = (r << 24) | (g << 16) | (w << 8) | b; break;
-			  case WS2812_RBWG: n = (r << 24) | (b << 16) | (w << 8) | g; break;
-			  case WS2812_GRWB: n = (g << 24) | (r << 16) | (w << 8) | b; break;
-			  case WS2812_GBWR: n = (g << 24) | (b << 16) | (w << 8) | r; break;
-			  case WS2812_BRWG: n = (b << 24) | (r << 16) | (w << 8) | g; break;
-			  case WS2812_BGWR: n = (b << 24) | (g << 16) | (w << 8) | r; break;
-			}
-			const uint8_t *stop = fb + 16;
-			do {
-				uint8_t x = 0x08;
-				if (!(n & 0x80000000)) x |= 0x07;
-				if (!(n & 0x40000000)) x |= 0xE0;
-				n <<= 2;
-				*fb++ = x;
-			} while (fb < stop);
-		}
-		microseconds_per_led = 40;
-		bytes_per_led = 16;
-	}
+	uint32_t bytes_per_led = encode(frameBuffer);
 	// wait 300us WS2812 reset time
-	uint32_t min_elapsed = (numled * microseconds_per_led) + 300;
+	uint32_t min_elapsed = (numled * ((config < 6) ? 30 : 40)) + 300;
 	//if (min_elapsed < 2500) min_elapsed = 2500; // limit refresh to 400 Hz
 	uint32_t m;
 	while (1) {
@@ -348,24 +306,115 @@ void WS2812Serial::show()
 		yield();
 	}
 	prior_micros = m;
+	startTransfer(frameBuffer, bytes_per_led);
+}
+
+// Each color byte becomes 4 UART bytes carrying 2 WS2812 bits each. The
+// table holds those 4 bytes as one little endian word, so the encoder does
+// one lookup and one 32 bit store per color byte instead of 4 branchy steps.
+namespace {
+
+struct WS2812EncodeTable {
+	uint32_t word[256];
+	constexpr WS2812EncodeTable() : word() {
+		for (uint32_t v = 0; v < 256; v++) {
+			uint32_t w = 0;
+			for (uint32_t i = 0; i < 4; i++) {
+				uint32_t bits = v << (2 * i);
+				uint32_t x = 0x08;
+				if (!(bits & 0x80)) x |= 0x07;
+				if (!(bits & 0x40)) x |= 0xE0;
+				w |= x << (8 * i);
+			}
+			word[v] = w;
+		}
+	}
+};
+
+constexpr WS2812EncodeTable encodeTable;
+
+// Index into the drawing buffer (b, g, r[, w] as stored by setPixel) of each
+// channel in transmit order, per config
+const uint8_t colorOrder[30][4] = {
+	{2, 1, 0, 0}, {2, 0, 1, 0}, {1, 2, 0, 0}, {1, 0, 2, 0}, {0, 2, 1, 0}, {0, 1, 2, 0},	// RGB..BGR
+	{2, 1, 0, 3}, {2, 0, 1, 3}, {1, 2, 0, 3}, {1, 0, 2, 3}, {0, 2, 1, 3}, {0, 1, 2, 3},	// RGBW..BGRW
+	{3, 2, 1, 0}, {3, 2, 0, 1}, {3, 1, 2, 0}, {3, 1, 0, 2}, {3, 0, 2, 1}, {3, 0, 1, 2},	// WRGB..WBGR
+	{2, 3, 1, 0}, {2, 3, 0, 1}, {1, 3, 2, 0}, {1, 3, 0, 2}, {0, 3, 2, 1}, {0, 3, 1, 2},	// RWGB..BWGR
+	{2, 1, 3, 0}, {2, 0, 3, 1}, {1, 2, 3, 0}, {1, 0, 3, 2}, {0, 2, 3, 1}, {0, 1, 3, 2},	// RGWB..BGWR
+};
+
+inline void storeWord(uint8_t *fb, uint32_t w) {
+	memcpy(fb, &w, 4);	// single (possibly unaligned) 32 bit store on Cortex-M
+}
+
+}  // namespace
+
+uint32_t WS2812Serial::encode(uint8_t *fb)
+{
+	// color order and brightness are resolved once per frame
+	const uint32_t channels = (config < 6) ? 3 : 4;
+	const uint8_t *order = colorOrder[(config < 30) ? config : 0];
+	const uint32_t o0 = order[0], o1 = order[1], o2 = order[2], o3 = order[3];
+	const uint32_t *lut = encodeTable.word;
+	const uint8_t *p = drawBuffer;
+	const uint8_t *end = p + (numled * channels);
+
+	if (brightness == 255) {
+		// full brightness: (v * 256) >> 8 == v, no scaling needed
+		if (channels == 3) {
+			for (; p < end; p += 3, fb += 12) {
+				storeWord(fb + 0, lut[p[o0]]);
+				storeWord(fb + 4, lut[p[o1]]);
+				storeWord(fb + 8, lut[p[o2]]);
+			}
+		} else {
+			for (; p < end; p += 4, fb += 16) {
+				storeWord(fb + 0, lut[p[o0]]);
+				storeWord(fb + 4, lut[p[o1]]);
+				storeWord(fb + 8, lut[p[o2]]);
+				storeWord(fb + 12, lut[p[o3]]);
+			}
+		}
+	} else {
+		const uint32_t mult = brightness + 1;
+		if (channels == 3) {
+			for (; p < end; p += 3, fb += 12) {
+				storeWord(fb + 0, lut[(p[o0] * mult) >> 8]);
+				storeWord(fb + 4, lut[(p[o1] * mult) >> 8]);
+				storeWord(fb + 8, lut[(p[o2] * mult) >> 8]);
+			}
+		} else {
+			for (; p < end; p += 4, fb += 16) {
+				storeWord(fb + 0, lut[(p[o0] * mult) >> 8]);
+				storeWord(fb + 4, lut[(p[o1] * mult) >> 8]);
+				storeWord(fb + 8, lut[(p[o2] * mult) >> 8]);
+				storeWord(fb + 12, lut[(p[o3] * mult) >> 8]);
+			}
+		}
+	}
+	return channels * 4;
+}
+
+void WS2812Serial::startTransfer(uint8_t *fb, uint32_t bytes_per_led)
+{
 	// start DMA transfer to update LEDs  :-)
 #if defined(KINETISK)
-	dma->sourceBuffer(frameBuffer, numled * bytes_per_led);
+	dma->sourceBuffer(fb, numled * bytes_per_led);
 	dma->transferSize(1);
 	dma->transferCount(numled * bytes_per_led);
 	dma->disableOnCompletion();
 	dma->enable();
 #elif defined(KINETISL)
-	dma->CFG->SAR = frameBuffer;
+	dma->CFG->SAR = fb;
 	dma->CFG->DSR_BCR = 0x01000000;
 	dma->CFG->DSR_BCR = numled * bytes_per_led;
 	dma->CFG->DCR = DMA_DCR_ERQ | DMA_DCR_CS | DMA_DCR_SSIZE(1) |
 		DMA_DCR_SINC | DMA_DCR_DSIZE(1) | DMA_DCR_D_REQ;
 #elif defined(__IMXRT1062__)
 	// See if we need to muck with DMA cache...
-	if ((uint32_t)frameBuffer >= 0x20200000u)  arm_dcache_flush(frameBuffer, numled * bytes_per_led);
+	if ((uint32_t)fb >= 0x20200000u)  arm_dcache_flush(fb, numled * bytes_per_led);
 	
-	dma->sourceBuffer(frameBuffer, numled * bytes_per_led);
+	dma->sourceBuffer(fb, numled * bytes_per_led);
 //	dma->transferSize(1);
 	dma->transferCount(numled * bytes_per_led);
 	dma->disableOnCompletion();
@@ -381,4 +430,3 @@ void WS2812Serial::show()
 
 #endif
 }
-
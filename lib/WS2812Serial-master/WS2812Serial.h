@@ -65,6 +65,12 @@ public:
 		numled(num), pin(pin), config(3),
 		frameBuffer((uint8_t *)fb), drawBuffer((uint8_t *)db) {
 	}
+	// Double buffered: the next frame is encoded into the idle frame buffer
+	// while the other one is still being transmitted by DMA
+	constexpr WS2812Serial(uint16_t num, void *fb, void *fb2, void *db, uint8_t pin, uint8_t cfg) :
+		numled(num), pin(pin), config(3),
+		frameBuffer((uint8_t *)fb), drawBuffer((uint8_t *)db), backBuffer((uint8_t *)fb2) {
+	}
 	bool begin();
 	void setPixel(uint32_t num, uint32_t color) {
 		if (num >= numled) return;
@@ -92,6 +98,15 @@ public:
 	} 	
 	void show();
 	bool busy();
+	// Never waits: encodes the drawing buffer if a frame buffer is free and
+	// starts it as soon as the line is idle. Returns true if the drawing
+	// buffer was taken over, false if the caller has to try again later.
+	bool tryShow();
+	// Starts a frame queued by tryShow() once the line is idle
+	bool poll();
+	bool framePending() {
+		return pending;
+	}
 	uint16_t numPixels() {
 		return numled;
 	}
@@ -123,12 +138,17 @@ private:
 	const uint8_t config;
 	uint8_t *frameBuffer;
 	uint8_t *drawBuffer;
+	uint8_t *backBuffer = nullptr;
+	bool pending = false;
 	DMAChannel *dma = nullptr;
 	uint32_t prior_micros = 0;
 	uint8_t brightness = 255;
 	#if defined(__IMXRT1062__) // Teensy 3.x
 	IMXRT_LPUART_t *uart = nullptr; 
 	#endif
+	bool transferActive();
+	uint32_t encode(uint8_t *fb);
+	void startTransfer(uint8_t *fb, uint32_t bytes_per_led);
 };
 
 #endif
@@ -0,0 +1,243 @@
+#pragma once
+
+/**
+ * Arduino/Teensy-Ersatz für den Host-Build (env:native)
+ *
+ * Stellt genau die Teile der Teensy-API bereit, die die Firmware benutzt.
+ * Zeit, Pins, Interrupts und serielle Schnittstellen sind simuliert, die
+ * Steuerung der Simulation steht in BeaconSim.h.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <math.h>
+#include <type_traits>
+#include <vector>
+#include <deque>
+
+#define HIGH 1
+#define LOW 0
+
+// INPUT und OUTPUT definiert auch der Stub-Plattformteil von FastLED, mit denselben Werten
+#ifndef INPUT
+#define INPUT 0
+#endif
+#ifndef OUTPUT
+#define OUTPUT 1
+#endif
+#define INPUT_PULLUP 2
+#define INPUT_PULLDOWN 3
+
+#define CHANGE 4
+#define FALLING 2
+#define RISING 3
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+#define DEG_TO_RAD 0.017453292519943295769236907684886
+#define RAD_TO_DEG 57.295779513082320876798154814105
+#define PI 3.1415926535897932384626433832795
+#define HALF_PI 1.5707963267948966192313216916398
+#define TWO_PI 6.283185307179586476925286766559
+
+#define radians(deg) ((deg) * DEG_TO_RAD)
+#define degrees(rad) ((rad) * RAD_TO_DEG)
+#define sq(x) ((x) * (x))
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+// Gleiche Signaturen wie in FastLEDs led_sysdefs_stub_generic.h
+extern "C" {
+    void pinMode(uint8_t pin, uint8_t mode);
+
+    uint32_t millis(void);
+    uint32_t micros(void);
+
+    void delay(int ms);
+    void yield(void);
+}
+
+void delayMicroseconds(uint32_t us);
+
+int digitalRead(uint8_t pin);
+void digitalWrite(uint8_t pin, uint8_t value);
+inline int digitalReadFast(uint8_t pin) {
+    return digitalRead(pin);
+}
+inline void digitalWriteFast(uint8_t pin, uint8_t value) {
+    digitalWrite(pin, value);
+}
+
+#define digitalPinToInterrupt(pin) (pin)
+void attachInterrupt(uint8_t pin, void (*function)(void), int mode);
+void detachInterrupt(uint8_t pin);
+void interrupts();
+void noInterrupts();
+
+template <class A, class B>
+constexpr typename std::common_type<A, B>::type min(A a, B b) {
+    return b < a ? b : a;
+}
+
+template <class A, class B>
+constexpr typename std::common_type<A, B>::type max(A a, B b) {
+    return a < b ? b : a;
+}
+
+template <class T, class L, class H>
+constexpr T constrain(T value, L low, H high) {
+    return value < low ? low : (value > high ? high : value);
+}
+
+inline long map(long x, long in_min, long in_max, long out_min, long out_max) {
+    return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+
+/**
+ * @brief Zeitmessung wie im Teensy-Core, läuft auf der simulierten Uhr
+ */
+class elapsedMillis {
+public:
+    elapsedMillis() : start(millis()) {}
+    elapsedMillis(unsigned long value) : start(millis() - value) {}
+    operator unsigned long() const { return millis() - start; }
+    elapsedMillis& operator=(unsigned long value) { start = millis() - value; return *this; }
+    elapsedMillis& operator-=(unsigned long value) { start += value; return *this; }
+    elapsedMillis& operator+=(unsigned long value) { start -= value; return *this; }
+
+private:
+    unsigned long start;
+};
+
+class elapsedMicros {
+public:
+    elapsedMicros() : start(micros()) {}
+    elapsedMicros(unsigned long value) : start(micros() - value) {}
+    operator unsigned long() const { return micros() - start; }
+    elapsedMicros& operator=(unsigned long value) { start = micros() - value; return *this; }
+    elapsedMicros& operator-=(unsigned long value) { start += value; return *this; }
+    elapsedMicros& operator+=(unsigned long value) { start -= value; return *this; }
+
+private:
+    unsigned long start;
+};
+
+/**
+ * @brief Periodischer Interrupt, wird von der Simulation zwischen zwei loop()-Aufrufen ausgelöst
+ */
+class IntervalTimer {
+public:
+    IntervalTimer() : slot(-1) {}
+    ~IntervalTimer() { end(); }
+    bool begin(void (*function)(), unsigned long period_us);
+    void end();
+    void priority(uint8_t) {}
+
+private:
+    int8_t slot;
+};
+
+class Print {
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t b) = 0;
+    virtual size_t write(const uint8_t* buffer, size_t size);
+    size_t write(const char* str) { return write((const uint8_t*)str, strlen(str)); }
+
+    size_t print(const char* str) { return write(str); }
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t print(int n, int base = DEC) { return print((long)n, base); }
+    size_t print(unsigned int n, int base = DEC) { return print((unsigned long)n, base); }
+    size_t print(long n, int base = DEC);
+    size_t print(unsigned long n, int base = DEC);
+    size_t print(long long n, int base = DEC);
+    size_t print(unsigned long long n, int base = DEC);
+    size_t print(double n, int digits = 2);
+
+    size_t println() { return write("\r\n"); }
+    template <class T>
+    size_t println(T value) { return print(value) + println(); }
+    template <class T>
+    size_t println(T value, int format) { return print(value, format) + println(); }
+
+    int printf(const char* format, ...) __attribute__((format(printf, 2, 3)));
+
+private:
+    size_t printNumber(unsigned long long n, int base);
+};
+
+class Stream : public Print {
+public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+};
+
+/**
+ * @brief Serielle Schnittstelle der Simulation
+ *
+ * Empfangene Bytes kommen zu festen simulierten Zeitpunkten an und landen
+ * wie beim Teensy in einem begrenzten Empfangspuffer, zu spät gelesene
+ * Bytes gehen verloren. Gesendete Bytes werden gezählt und optional in
+ * eine Datei geschrieben.
+ */
+class HardwareSerial : public Stream {
+public:
+    HardwareSerial(const char* name, size_t rxBufferSize);
+
+    void begin(uint32_t baud, uint16_t format = 0);
+    void end() {}
+    void addMemoryForRead(void* buffer, size_t length);
+    void addMemoryForWrite(void*, size_t) {}
+
+    int available() override;
+    int read() override;
+    int peek() override;
+    void flush() {}
+    using Print::write;
+    size_t write(uint8_t b) override;
+    size_t write(const uint8_t* buffer, size_t size) override;
+    operator bool() const { return true; }
+
+    // Steuerung durch die Simulation
+    void simReceive(uint8_t value, uint64_t at_us);   // Byte trifft zum Zeitpunkt at_us ein
+    void simSetOutput(FILE* file);                     // Gesendete Bytes mitschreiben, nullptr = verwerfen
+    const char* simName() const { return name; }
+    uint32_t simBaud() const { return baud; }
+    uint64_t simBytesReceived() const { return received; }
+    uint64_t simBytesDropped() const { return dropped; }
+    uint64_t simBytesSent() const { return sent; }
+
+private:
+    struct Arrival {
+        uint64_t at_us;
+        uint8_t value;
+    };
+
+    const char* name;
+    uint32_t baud;
+    size_t capacity;                // Empfangspuffer des Cores plus addMemoryForRead()
+    FILE* output;
+
+    std::vector<Arrival> pending;   // Noch nicht eingetroffene Bytes, zeitlich sortiert
+    size_t pendingNext;
+    std::deque<uint8_t> rxBuffer;
+
+    uint64_t received;
+    uint64_t dropped;
+    uint64_t sent;
+
+    void receiveDue();
+};
+
+extern HardwareSerial Serial;
+extern HardwareSerial Serial2;
+extern HardwareSerial Serial3;
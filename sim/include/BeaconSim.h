@@ -0,0 +1,43 @@
+#pragma once
+#include <Arduino.h>
+
+/**
+ * Steuerung der Host-Simulation (env:native)
+ *
+ * Die Uhr ist rein simuliert und deterministisch. Sie läuft nur weiter, wenn
+ * die Simulation sie vorstellt (Treiberschleife, delay(), blockierende
+ * Bus-Zugriffe) und um SIM_CLOCK_READ_US bei jedem Lesen mit millis() oder
+ * micros(), damit Warteschleifen auf die Uhr enden. Die Rechenzeit der
+ * Firmware selbst wird nicht abgebildet, dafür den Host-Prozess mit perf
+ * oder gprof messen.
+ *
+ * Interrupts (IntervalTimer, Pinflanken) laufen nur, während die Uhr
+ * vorgestellt wird, jeweils zu ihrem simulierten Zeitpunkt und nie
+ * verschachtelt.
+ */
+
+#define SIM_CLOCK_READ_US 1             // Simulierte Kosten eines Uhrzugriffs
+#define SIM_PIN_COUNT 64
+#define SIM_INTERVAL_TIMERS 4           // Wie beim Teensy 4 (PIT)
+
+namespace BeaconSim {
+
+// Simulierte Zeit in µs seit dem Start, ohne die Uhr vorzustellen
+uint64_t now();
+
+// Stellt die Uhr vor und führt unterwegs fällige Interrupts aus
+void advance(uint64_t us);
+void advanceTo(uint64_t at_us);
+
+// Pegel eines Eingangs ab dem Zeitpunkt at_us, angehängte Interrupts werden ausgelöst
+void setPin(uint8_t pin, uint8_t level, uint64_t at_us);
+
+// micro-ROS-Agent: erreichbar im Zeitfenster [from_us, until_us)
+void setAgentWindow(uint64_t from_us, uint64_t until_us);
+// LED-Animationsziel mit Parameterblock (siehe LEDAnimation.action), zum Zeitpunkt at_us
+void queueGoal(uint64_t at_us, const uint8_t params[8]);
+// Abbruch des laufenden Ziels zum Zeitpunkt at_us
+void queueCancel(uint64_t at_us);
+void printMicroROSStats(FILE* out);
+
+}  // namespace BeaconSim
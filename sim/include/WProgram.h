@@ -0,0 +1,3 @@
+#pragma once
+// Name der Arduino-API vor 1.0, ältere Bibliotheken binden ihn noch ein
+#include <Arduino.h>
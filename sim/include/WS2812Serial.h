@@ -0,0 +1,49 @@
+#pragma once
+#include <Arduino.h>
+
+#define WS2812_RGB      0
+#define WS2812_RBG      1
+#define WS2812_GRB      2
+#define WS2812_GBR      3
+#define WS2812_BRG      4
+#define WS2812_BGR      5
+
+/**
+ * @brief WS2812Serial der Simulation
+ *
+ * Bildet nur das Zeitverhalten der doppelt gepufferten Ausgabe nach: ein
+ * Frame belegt die Leitung 30 µs je LED plus 300 µs Reset-Pause, ein weiterer
+ * Frame kann warten. Ausgegebene Frames werden gezählt und können als
+ * Zeitstempel mit RGB-Werten protokolliert werden.
+ */
+class WS2812Serial {
+public:
+    WS2812Serial(uint16_t num, void* fb, void* db, uint8_t pin, uint8_t cfg);
+    WS2812Serial(uint16_t num, void* fb, void* fb2, void* db, uint8_t pin, uint8_t cfg);
+
+    bool begin();
+    void show();
+    bool busy();
+    bool tryShow();
+    bool poll();
+    bool framePending() {
+        return pending;
+    }
+    uint16_t numPixels() {
+        return numled;
+    }
+
+    // Statistik und Protokoll aller Instanzen
+    static void simSetLog(FILE* file);
+    static uint32_t simFramesShown();
+    static uint32_t simFramesRejected();   // tryShow() ohne freien Frame-Puffer
+
+private:
+    const uint16_t numled;
+    uint8_t* drawBuffer;
+    uint8_t* frameBuffer;       // Kopie des wartenden Frames, für das Protokoll
+    bool pending;
+    uint64_t lineFree_us;       // Ende der laufenden Übertragung samt Reset-Pause
+
+    void startTransfer(const uint8_t* frame);
+};
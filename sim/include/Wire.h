@@ -0,0 +1,49 @@
+#pragma once
+#include <Arduino.h>
+
+#define BUFFER_LENGTH 32
+
+/**
+ * @brief I2C-Bus der Simulation
+ *
+ * Jede Adresse bestätigt, Lesezugriffe liefern keine Daten. Eine Übertragung
+ * blockiert für die Dauer der Bits auf dem Bus (9 Takte je Byte plus START
+ * und STOP) und kann mit Zeitstempel in eine Datei protokolliert werden.
+ */
+class TwoWire : public Stream {
+public:
+    TwoWire();
+
+    void begin();
+    void setClock(uint32_t frequency);
+    void beginTransmission(uint8_t address);
+    uint8_t endTransmission(uint8_t sendStop = 1);
+    uint8_t requestFrom(uint8_t address, uint8_t quantity, uint8_t sendStop = 1);
+
+    using Print::write;
+    size_t write(uint8_t b) override;
+    size_t write(const uint8_t* data, size_t length) override;
+    int available() override { return 0; }
+    int read() override { return -1; }
+    int peek() override { return -1; }
+
+    // Steuerung durch die Simulation
+    void simSetLog(FILE* file);
+    uint32_t simTransfers() const { return transfers; }
+    uint32_t simBytes() const { return bytes; }
+    uint64_t simBusyMicros() const { return busy_us; }
+
+private:
+    uint32_t frequency;
+    uint8_t address;
+    uint8_t txBuffer[BUFFER_LENGTH];
+    uint8_t txLength;
+    bool transmitting;
+    FILE* log;
+
+    uint32_t transfers;
+    uint32_t bytes;
+    uint64_t busy_us;
+};
+
+extern TwoWire Wire;
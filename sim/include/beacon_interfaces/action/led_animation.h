@@ -0,0 +1,41 @@
+#pragma once
+// micro-ROS-Ersatz für den Host-Build (env:native), Aufbau wie aus LEDAnimation.action erzeugt
+#include <stdbool.h>
+#include <stdint.h>
+#include <builtin_interfaces/msg/time.h>
+#include <rosidl_runtime_c/action_type_support_struct.h>
+
+typedef struct unique_identifier_msgs__msg__UUID {
+    uint8_t uuid[16];
+} unique_identifier_msgs__msg__UUID;
+
+typedef struct beacon_interfaces__action__LEDAnimation_Goal {
+    uint8_t params[8];
+} beacon_interfaces__action__LEDAnimation_Goal;
+
+typedef struct beacon_interfaces__action__LEDAnimation_Result {
+    bool success;
+    uint8_t final_status;
+} beacon_interfaces__action__LEDAnimation_Result;
+
+typedef struct beacon_interfaces__action__LEDAnimation_Feedback {
+    float progress;
+    uint8_t status;
+} beacon_interfaces__action__LEDAnimation_Feedback;
+
+typedef struct beacon_interfaces__action__LEDAnimation_SendGoal_Request {
+    unique_identifier_msgs__msg__UUID goal_id;
+    beacon_interfaces__action__LEDAnimation_Goal goal;
+} beacon_interfaces__action__LEDAnimation_SendGoal_Request;
+
+typedef struct beacon_interfaces__action__LEDAnimation_FeedbackMessage {
+    unique_identifier_msgs__msg__UUID goal_id;
+    beacon_interfaces__action__LEDAnimation_Feedback feedback;
+} beacon_interfaces__action__LEDAnimation_FeedbackMessage;
+
+typedef struct beacon_interfaces__action__LEDAnimation_GetResult_Response {
+    int8_t status;
+    beacon_interfaces__action__LEDAnimation_Result result;
+} beacon_interfaces__action__LEDAnimation_GetResult_Response;
+
+extern const rosidl_action_type_support_t beacon_interfaces__action__LEDAnimation__type_support;
@@ -0,0 +1,8 @@
+#pragma once
+// micro-ROS-Ersatz für den Host-Build (env:native)
+#include <stdint.h>
+
+typedef struct builtin_interfaces__msg__Time {
+    int32_t sec;
+    uint32_t nanosec;
+} builtin_interfaces__msg__Time;
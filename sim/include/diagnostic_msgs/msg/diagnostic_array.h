@@ -0,0 +1,44 @@
+#pragma once
+// micro-ROS-Ersatz für den Host-Build (env:native)
+#include <stdint.h>
+#include <rosidl_runtime_c/message_type_support_struct.h>
+#include <std_msgs/msg/header.h>
+
+typedef struct diagnostic_msgs__msg__KeyValue {
+    rosidl_runtime_c__String key;
+    rosidl_runtime_c__String value;
+} diagnostic_msgs__msg__KeyValue;
+
+typedef struct diagnostic_msgs__msg__KeyValue__Sequence {
+    diagnostic_msgs__msg__KeyValue* data;
+    size_t size;
+    size_t capacity;
+} diagnostic_msgs__msg__KeyValue__Sequence;
+
+enum {
+    diagnostic_msgs__msg__DiagnosticStatus__OK = 0,
+    diagnostic_msgs__msg__DiagnosticStatus__WARN = 1,
+    diagnostic_msgs__msg__DiagnosticStatus__ERROR = 2,
+    diagnostic_msgs__msg__DiagnosticStatus__STALE = 3
+};
+
+typedef struct diagnostic_msgs__msg__DiagnosticStatus {
+    uint8_t level;
+    rosidl_runtime_c__String name;
+    rosidl_runtime_c__String message;
+    rosidl_runtime_c__String hardware_id;
+    diagnostic_msgs__msg__KeyValue__Sequence values;
+} diagnostic_msgs__msg__DiagnosticStatus;
+
+typedef struct diagnostic_msgs__msg__DiagnosticStatus__Sequence {
+    diagnostic_msgs__msg__DiagnosticStatus* data;
+    size_t size;
+    size_t capacity;
+} diagnostic_msgs__msg__DiagnosticStatus__Sequence;
+
+typedef struct diagnostic_msgs__msg__DiagnosticArray {
+    std_msgs__msg__Header header;
+    diagnostic_msgs__msg__DiagnosticStatus__Sequence status;
+} diagnostic_msgs__msg__DiagnosticArray;
+
+extern const rosidl_message_type_support_t diagnostic_msgs__msg__DiagnosticArray__type_support;
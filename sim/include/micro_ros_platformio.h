@@ -0,0 +1,5 @@
+#pragma once
+// micro-ROS-Ersatz für den Host-Build (env:native): kein echter Transport, der Agent ist simuliert
+#include <Arduino.h>
+
+void set_microros_serial_transports(Stream& stream);
@@ -0,0 +1,4 @@
+#pragma once
+// micro-ROS-Ersatz für den Host-Build (env:native)
+
+#define rcl_reset_error()
@@ -0,0 +1,71 @@
+#pragma once
+// micro-ROS-Ersatz für den Host-Build (env:native), Verhalten in sim/src/SimMicroROS.cpp
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <rcutils/allocator.h>
+#include <rosidl_runtime_c/message_type_support_struct.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef int32_t rcl_ret_t;
+typedef int32_t rmw_ret_t;
+
+#define RCL_RET_OK 0
+#define RCL_RET_ERROR 1
+#define RCL_RET_TIMEOUT 2
+#define RCL_RET_INVALID_ARGUMENT 11
+#define RCL_RET_ACTION_GOAL_ACCEPTED 2100
+#define RCL_RET_ACTION_GOAL_REJECTED 2101
+
+#define RMW_RET_OK 0
+#define RMW_RET_ERROR 1
+#define RMW_RET_TIMEOUT 2
+
+#define RCL_MS_TO_NS(ms) ((ms) * (1000LL * 1000LL))
+
+typedef rcutils_allocator_t rcl_allocator_t;
+#define rcl_get_default_allocator rcutils_get_default_allocator
+
+typedef struct rmw_context_t {
+    uint32_t destroy_session_timeout_ms;
+} rmw_context_t;
+
+typedef struct rcl_context_t {
+    rmw_context_t rmw_context;
+} rcl_context_t;
+
+typedef struct rcl_node_t {
+    const char* name;
+} rcl_node_t;
+
+typedef struct rcl_publisher_t {
+    struct sim_topic_t* impl;
+    uint32_t session_timeout_ms;    // 0 = Vorgabe von rmw_microxrcedds
+} rcl_publisher_t;
+
+typedef struct rmw_publisher_allocation_t rmw_publisher_allocation_t;
+
+rcl_node_t rcl_get_zero_initialized_node(void);
+rcl_ret_t rcl_node_fini(rcl_node_t* node);
+
+rcl_publisher_t rcl_get_zero_initialized_publisher(void);
+rcl_ret_t rcl_publisher_fini(rcl_publisher_t* publisher, rcl_node_t* node);
+rcl_ret_t rcl_publish(const rcl_publisher_t* publisher, const void* ros_message,
+                      rmw_publisher_allocation_t* allocation);
+
+rmw_context_t* rcl_context_get_rmw_context(rcl_context_t* context);
+
+// rmw_microxrcedds
+rmw_ret_t rmw_uros_ping_agent(int timeout_ms, uint8_t attempts);
+rmw_ret_t rmw_uros_sync_session(int timeout_ms);
+int64_t rmw_uros_epoch_nanos(void);
+rmw_ret_t rmw_uros_set_context_entity_creation_session_timeout(rmw_context_t* context, int64_t timeout_ms);
+rmw_ret_t rmw_uros_set_context_entity_destroy_session_timeout(rmw_context_t* context, int64_t timeout_ms);
+rmw_ret_t rmw_uros_set_publisher_session_timeout(rcl_publisher_t* publisher, int64_t timeout_ms);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,55 @@
+#pragma once
+// micro-ROS-Ersatz für den Host-Build (env:native)
+#include <rclc/rclc.h>
+#include <rosidl_runtime_c/action_type_support_struct.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef int8_t rcl_action_goal_state_t;
+
+#define GOAL_STATE_UNKNOWN 0
+#define GOAL_STATE_ACCEPTED 1
+#define GOAL_STATE_EXECUTING 2
+#define GOAL_STATE_CANCELING 3
+#define GOAL_STATE_SUCCEEDED 4
+#define GOAL_STATE_CANCELED 5
+#define GOAL_STATE_ABORTED 6
+
+typedef struct rclc_action_server_t rclc_action_server_t;
+
+typedef struct rclc_action_goal_handle_t {
+    bool available;
+    void* ros_goal_request;
+    rcl_action_goal_state_t status;
+    rclc_action_server_t* action_server;
+} rclc_action_goal_handle_t;
+
+typedef rcl_ret_t (*rclc_action_handle_goal_request_t)(rclc_action_goal_handle_t*, void*);
+typedef bool (*rclc_action_handle_cancel_request_t)(rclc_action_goal_handle_t*, void*);
+
+#define RCLC_ACTION_SERVER_MAX_GOALS 4
+
+struct rclc_action_server_t {
+    const char* name;
+    rclc_action_goal_handle_t goal_handles[RCLC_ACTION_SERVER_MAX_GOALS];
+    size_t goal_handles_count;
+    rclc_action_handle_goal_request_t goal_callback;
+    rclc_action_handle_cancel_request_t cancel_callback;
+    void* context;
+};
+
+rcl_ret_t rclc_action_server_init_default(rclc_action_server_t* action_server, rcl_node_t* node,
+                                          rclc_support_t* support,
+                                          const rosidl_action_type_support_t* type_support,
+                                          const char* action_name);
+rcl_ret_t rclc_action_server_fini(rclc_action_server_t* action_server, rcl_node_t* node);
+
+rcl_ret_t rclc_action_publish_feedback(rclc_action_goal_handle_t* goal_handle, void* ros_feedback);
+rcl_ret_t rclc_action_send_result(rclc_action_goal_handle_t* goal_handle,
+                                  rcl_action_goal_state_t status, void* ros_response);
+
+#ifdef __cplusplus
+}
+#endif
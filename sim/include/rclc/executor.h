@@ -0,0 +1,31 @@
+#pragma once
+// micro-ROS-Ersatz für den Host-Build (env:native)
+#include <rclc/action_server.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct rclc_executor_t {
+    rclc_action_server_t* action_server;
+    size_t max_handles;
+} rclc_executor_t;
+
+rclc_executor_t rclc_executor_get_zero_initialized_executor(void);
+rcl_ret_t rclc_executor_init(rclc_executor_t* executor, rcl_context_t* context,
+                             const size_t number_of_handles, const rcl_allocator_t* allocator);
+rcl_ret_t rclc_executor_fini(rclc_executor_t* executor);
+
+rcl_ret_t rclc_executor_add_action_server(rclc_executor_t* executor, rclc_action_server_t* action_server,
+                                          size_t handles_number, void* ros_request_msg,
+                                          size_t ros_request_msg_size,
+                                          rclc_action_handle_goal_request_t goal_callback,
+                                          rclc_action_handle_cancel_request_t cancel_callback,
+                                          void* context);
+
+// Führt bereitstehende Ziele und Abbrüche aus, wartet nicht
+rcl_ret_t rclc_executor_spin_some(rclc_executor_t* executor, const uint64_t timeout_ns);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,27 @@
+#pragma once
+// micro-ROS-Ersatz für den Host-Build (env:native)
+#include <rcl/rcl.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct rclc_support_t {
+    rcl_context_t context;
+    rcl_allocator_t* allocator;
+} rclc_support_t;
+
+rcl_ret_t rclc_support_init(rclc_support_t* support, int argc, char const* const* argv,
+                            rcl_allocator_t* allocator);
+rcl_ret_t rclc_support_fini(rclc_support_t* support);
+
+rcl_ret_t rclc_node_init_default(rcl_node_t* node, const char* name, const char* namespace_,
+                                 rclc_support_t* support);
+
+rcl_ret_t rclc_publisher_init_default(rcl_publisher_t* publisher, const rcl_node_t* node,
+                                      const rosidl_message_type_support_t* type_support,
+                                      const char* topic_name);
+
+#ifdef __cplusplus
+}
+#endif
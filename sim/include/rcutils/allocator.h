@@ -0,0 +1,24 @@
+#pragma once
+// micro-ROS-Ersatz für den Host-Build (env:native)
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct rcutils_allocator_s {
+    void* (*allocate)(size_t size, void* state);
+    void (*deallocate)(void* pointer, void* state);
+    void* (*reallocate)(void* pointer, size_t size, void* state);
+    void* (*zero_allocate)(size_t number_of_elements, size_t size_of_element, void* state);
+    void* state;
+} rcutils_allocator_t;
+
+rcutils_allocator_t rcutils_get_zero_initialized_allocator(void);
+rcutils_allocator_t rcutils_get_default_allocator(void);
+bool rcutils_set_default_allocator(rcutils_allocator_t* allocator);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,9 @@
+#pragma once
+// micro-ROS-Ersatz für den Host-Build (env:native)
+
+typedef struct rosidl_action_type_support_t {
+    const char* name;
+} rosidl_action_type_support_t;
+
+#define ROSIDL_GET_ACTION_TYPE_SUPPORT(PkgName, Name) \
+    (&PkgName##__action__##Name##__type_support)
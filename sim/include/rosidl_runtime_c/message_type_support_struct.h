@@ -0,0 +1,9 @@
+#pragma once
+// micro-ROS-Ersatz für den Host-Build (env:native)
+
+typedef struct rosidl_message_type_support_t {
+    const char* name;
+} rosidl_message_type_support_t;
+
+#define ROSIDL_GET_MSG_TYPE_SUPPORT(PkgName, MsgSubfolder, MsgName) \
+    (&PkgName##__##MsgSubfolder##__##MsgName##__type_support)
@@ -0,0 +1,43 @@
+#pragma once
+// micro-ROS-Ersatz für den Host-Build (env:native)
+#include <stdint.h>
+#include <std_msgs/msg/header.h>
+#include <rosidl_runtime_c/message_type_support_struct.h>
+
+enum {
+    sensor_msgs__msg__NavSatStatus__STATUS_NO_FIX = -1,
+    sensor_msgs__msg__NavSatStatus__STATUS_FIX = 0,
+    sensor_msgs__msg__NavSatStatus__STATUS_SBAS_FIX = 1,
+    sensor_msgs__msg__NavSatStatus__STATUS_GBAS_FIX = 2
+};
+
+enum {
+    sensor_msgs__msg__NavSatStatus__SERVICE_GPS = 1,
+    sensor_msgs__msg__NavSatStatus__SERVICE_GLONASS = 2,
+    sensor_msgs__msg__NavSatStatus__SERVICE_COMPASS = 4,
+    sensor_msgs__msg__NavSatStatus__SERVICE_GALILEO = 8
+};
+
+enum {
+    sensor_msgs__msg__NavSatFix__COVARIANCE_TYPE_UNKNOWN = 0,
+    sensor_msgs__msg__NavSatFix__COVARIANCE_TYPE_APPROXIMATED = 1,
+    sensor_msgs__msg__NavSatFix__COVARIANCE_TYPE_DIAGONAL_KNOWN = 2,
+    sensor_msgs__msg__NavSatFix__COVARIANCE_TYPE_KNOWN = 3
+};
+
+typedef struct sensor_msgs__msg__NavSatStatus {
+    int8_t status;
+    uint16_t service;
+} sensor_msgs__msg__NavSatStatus;
+
+typedef struct sensor_msgs__msg__NavSatFix {
+    std_msgs__msg__Header header;
+    sensor_msgs__msg__NavSatStatus status;
+    double latitude;
+    double longitude;
+    double altitude;
+    double position_covariance[9];
+    uint8_t position_covariance_type;
+} sensor_msgs__msg__NavSatFix;
+
+extern const rosidl_message_type_support_t sensor_msgs__msg__NavSatFix__type_support;
@@ -0,0 +1,10 @@
+#pragma once
+// micro-ROS-Ersatz für den Host-Build (env:native)
+#include <stdbool.h>
+#include <rosidl_runtime_c/message_type_support_struct.h>
+
+typedef struct std_msgs__msg__Bool {
+    bool data;
+} std_msgs__msg__Bool;
+
+extern const rosidl_message_type_support_t std_msgs__msg__Bool__type_support;
@@ -0,0 +1,15 @@
+#pragma once
+// micro-ROS-Ersatz für den Host-Build (env:native)
+#include <stddef.h>
+#include <builtin_interfaces/msg/time.h>
+
+typedef struct rosidl_runtime_c__String {
+    char* data;
+    size_t size;
+    size_t capacity;
+} rosidl_runtime_c__String;
+
+typedef struct std_msgs__msg__Header {
+    builtin_interfaces__msg__Time stamp;
+    rosidl_runtime_c__String frame_id;
+} std_msgs__msg__Header;
@@ -0,0 +1,190 @@
+#include "BeaconSim.h"
+#include <map>
+
+namespace {
+
+uint64_t simTime = 0;
+bool inInterrupt = false;
+bool interruptsEnabled = true;
+
+struct TimerSlot {
+    void (*function)();
+    uint32_t period_us;
+    uint64_t next_us;
+};
+TimerSlot timers[SIM_INTERVAL_TIMERS];
+
+struct PinState {
+    uint8_t level;
+    bool driven;                // Pegel von außen vorgegeben, sonst gilt der Pull-Widerstand
+    void (*isr)();
+    int isrMode;
+};
+PinState pins[SIM_PIN_COUNT];
+
+struct PinChange {
+    uint8_t pin;
+    uint8_t level;
+};
+std::multimap<uint64_t, PinChange> pinChanges;   // Geplante Pegelwechsel, gleiche Zeit in Reihenfolge des Eintragens
+
+void applyPin(uint8_t pin, uint8_t level) {
+    PinState& state = pins[pin];
+    uint8_t previous = state.level;
+    state.level = level;
+    state.driven = true;
+    if (state.isr == nullptr || previous == level) {
+        return;
+    }
+    if (state.isrMode == CHANGE || (state.isrMode == RISING && level == HIGH) ||
+        (state.isrMode == FALLING && level == LOW)) {
+        state.isr();
+    }
+}
+
+// Führt das früheste fällige Ereignis bis einschließlich limit aus
+bool runNextEvent(uint64_t limit) {
+    int8_t timer = -1;
+    uint64_t next = limit + 1;
+    for (uint8_t i = 0; i < SIM_INTERVAL_TIMERS; i++) {
+        if (timers[i].function != nullptr && timers[i].next_us < next) {
+            next = timers[i].next_us;
+            timer = i;
+        }
+    }
+    auto change = pinChanges.begin();
+    bool pinFirst = change != pinChanges.end() && change->first < next;
+    if (!pinFirst && timer < 0) {
+        return false;
+    }
+
+    if (pinFirst) {
+        next = change->first;
+    }
+    if (next > simTime) {
+        simTime = next;
+    }
+    inInterrupt = true;
+    if (pinFirst) {
+        PinChange pending = change->second;
+        pinChanges.erase(change);
+        applyPin(pending.pin, pending.level);
+    } else {
+        TimerSlot& slot = timers[timer];
+        slot.next_us += slot.period_us;
+        slot.function();
+    }
+    inInterrupt = false;
+    return true;
+}
+
+}  // namespace
+
+uint64_t BeaconSim::now() {
+    return simTime;
+}
+
+void BeaconSim::advanceTo(uint64_t at_us) {
+    // In einer ISR oder bei gesperrten Interrupts läuft nur die Uhr weiter
+    if (!inInterrupt && interruptsEnabled) {
+        while (runNextEvent(at_us)) {
+        }
+    }
+    if (at_us > simTime) {
+        simTime = at_us;
+    }
+}
+
+void BeaconSim::advance(uint64_t us) {
+    advanceTo(simTime + us);
+}
+
+void BeaconSim::setPin(uint8_t pin, uint8_t level, uint64_t at_us) {
+    if (pin < SIM_PIN_COUNT) {
+        pinChanges.insert(std::make_pair(at_us, PinChange{pin, (uint8_t)(level ? HIGH : LOW)}));
+    }
+}
+
+extern "C" uint32_t millis(void) {
+    simTime += SIM_CLOCK_READ_US;
+    return (uint32_t)(simTime / 1000);
+}
+
+extern "C" uint32_t micros(void) {
+    simTime += SIM_CLOCK_READ_US;
+    return (uint32_t)simTime;
+}
+
+extern "C" void delay(int ms) {
+    BeaconSim::advance((uint64_t)ms * 1000);
+}
+
+extern "C" void yield(void) {
+}
+
+void delayMicroseconds(uint32_t us) {
+    BeaconSim::advance(us);
+}
+
+extern "C" void pinMode(uint8_t pin, uint8_t mode) {
+    if (pin < SIM_PIN_COUNT && !pins[pin].driven) {
+        pins[pin].level = (mode == INPUT_PULLUP) ? HIGH : LOW;
+    }
+}
+
+int digitalRead(uint8_t pin) {
+    return pin < SIM_PIN_COUNT ? pins[pin].level : LOW;
+}
+
+void digitalWrite(uint8_t pin, uint8_t value) {
+    if (pin < SIM_PIN_COUNT) {
+        applyPin(pin, value ? HIGH : LOW);
+    }
+}
+
+void attachInterrupt(uint8_t pin, void (*function)(void), int mode) {
+    if (pin < SIM_PIN_COUNT) {
+        pins[pin].isr = function;
+        pins[pin].isrMode = mode;
+    }
+}
+
+void detachInterrupt(uint8_t pin) {
+    if (pin < SIM_PIN_COUNT) {
+        pins[pin].isr = nullptr;
+    }
+}
+
+void interrupts() {
+    interruptsEnabled = true;
+}
+
+void noInterrupts() {
+    interruptsEnabled = false;
+}
+
+bool IntervalTimer::begin(void (*function)(), unsigned long period_us) {
+    if (function == nullptr || period_us == 0) {
+        return false;
+    }
+    if (slot < 0) {
+        for (int8_t i = 0; i < SIM_INTERVAL_TIMERS; i++) {
+            if (timers[i].function == nullptr) {
+                slot = i;
+                break;
+            }
+        }
+        if (slot < 0) {
+            return false;
+        }
+    }
+    timers[slot] = TimerSlot{function, (uint32_t)period_us, simTime + period_us};
+    return true;
+}
+
+void IntervalTimer::end() {
+    if (slot >= 0) {
+        timers[slot].function = nullptr;
+        slot = -1;
+    }
+}
@@ -0,0 +1,245 @@
+#include "BeaconSim.h"
+#include <Wire.h>
+#include <WS2812Serial.h>
+#include "config.h"
+#include <chrono>
+#include <map>
+#include <string>
+
+/**
+ * Einstiegspunkt der Host-Simulation
+ *
+ * Ruft setup() einmal und loop() bis zum Ende der simulierten Laufzeit auf.
+ * Nach jedem loop()-Aufruf wird die Uhr um einen festen Schritt vorgestellt.
+ * Alle Eingänge (GNSS-Daten, Klappenpins, Agent, Aktionsziele) stehen vor dem
+ * Start fest, zwei Läufe mit denselben Optionen verhalten sich identisch.
+ * In Testläufen (pio test -e native) bringt jeder Test sein eigenes main() mit.
+ */
+
+#ifndef PIO_UNIT_TESTING
+
+void setup();
+void loop();
+
+namespace {
+
+struct Options {
+    uint64_t duration_us = 60000000;
+    uint32_t step_us = 100;
+    const char* gpsFile = nullptr;
+    uint32_t gpsEpoch_ms = 1000;
+    uint32_t stats_ms = 0;
+    bool quiet = false;
+    FILE* i2cLog = nullptr;
+    FILE* ledLog = nullptr;
+    std::multimap<uint64_t, std::string> console;  // Eingaben an die Konsole nach Zeitpunkt in µs
+};
+
+void usage(const char* program) {
+    fprintf(stderr,
+            "usage: %s [options]\n"
+            "  --seconds N          simulierte Laufzeit (60)\n"
+            "  --step-us N          Uhrschritt nach jedem loop() (100)\n"
+            "  --gps FILE           Mitschnitt des Empfängers, wird mit GPS_BAUD eingespielt\n"
+            "  --gps-epoch-ms N     NMEA: nach jedem GGA-Satz bis zur nächsten Epoche warten (1000), 0 = am Stück\n"
+            "  --pin P=L@MS         Pin P ab MS Millisekunden auf Pegel L (mehrfach)\n"
+            "  --agent FROM[:UNTIL] Agent erreichbar von FROM bis UNTIL ms (0)\n"
+            "  --no-agent           Agent nie erreichbar\n"
+            "  --goal MS:p0,..,p7   LED-Animationsziel zum Zeitpunkt MS (mehrfach)\n"
+            "  --cancel MS          laufendes Ziel zum Zeitpunkt MS abbrechen (mehrfach)\n"
+            "  --stats-ms N         alle N ms 's' an die Konsole senden (Laufzeitstatistik)\n"
+            "  --send MS:TEXT       TEXT zum Zeitpunkt MS an die Konsole senden (mehrfach)\n"
+            "  --i2c-log FILE       I2C-Übertragungen protokollieren\n"
+            "  --led-log FILE       ausgegebene LED-Frames protokollieren\n"
+            "  --quiet              Konsolenausgabe der Firmware verwerfen\n",
+            program);
+}
+
+FILE* openLog(const char* path) {
+    FILE* file = fopen(path, "w");
+    if (file == nullptr) {
+        fprintf(stderr, "cannot open %s\n", path);
+        exit(2);
+    }
+    return file;
+}
+
+bool parseArgs(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        unsigned long long a = 0;
+        unsigned long long b = 0;
+        unsigned int pin = 0;
+        unsigned int level = 0;
+
+        if (strcmp(arg, "--quiet") == 0) {
+            options.quiet = true;
+            continue;
+        }
+        if (strcmp(arg, "--no-agent") == 0) {
+            BeaconSim::setAgentWindow(UINT64_MAX, UINT64_MAX);
+            continue;
+        }
+        if (value == nullptr) {
+            return false;
+        }
+        i++;
+
+        if (strcmp(arg, "--seconds") == 0) {
+            options.duration_us = (uint64_t)(atof(value) * 1e6);
+        } else if (strcmp(arg, "--step-us") == 0) {
+            options.step_us = (uint32_t)atol(value);
+        } else if (strcmp(arg, "--gps") == 0) {
+            options.gpsFile = value;
+        } else if (strcmp(arg, "--gps-epoch-ms") == 0) {
+            options.gpsEpoch_ms = (uint32_t)atol(value);
+        } else if (strcmp(arg, "--stats-ms") == 0) {
+            options.stats_ms = (uint32_t)atol(value);
+        } else if (strcmp(arg, "--send") == 0) {
+            int offset = 0;
+            if (sscanf(value, "%llu:%n", &a, &offset) != 1 || offset == 0) {
+                return false;
+            }
+            options.console.emplace(a * 1000, value + offset);
+        } else if (strcmp(arg, "--i2c-log") == 0) {
+            options.i2cLog = openLog(value);
+        } else if (strcmp(arg, "--led-log") == 0) {
+            options.ledLog = openLog(value);
+        } else if (strcmp(arg, "--pin") == 0) {
+            if (sscanf(value, "%u=%u@%llu", &pin, &level, &a) != 3) {
+                return false;
+            }
+            BeaconSim::setPin(pin, level, a * 1000);
+        } else if (strcmp(arg, "--agent") == 0) {
+            int fields = sscanf(value, "%llu:%llu", &a, &b);
+            if (fields < 1) {
+                return false;
+            }
+            BeaconSim::setAgentWindow(a * 1000, fields == 2 ? b * 1000 : UINT64_MAX);
+        } else if (strcmp(arg, "--goal") == 0) {
+            unsigned int p[8];
+            if (sscanf(value, "%llu:%u,%u,%u,%u,%u,%u,%u,%u", &a,
+                       &p[0], &p[1], &p[2], &p[3], &p[4], &p[5], &p[6], &p[7]) != 9) {
+                return false;
+            }
+            uint8_t params[8];
+            for (uint8_t k = 0; k < 8; k++) {
+                params[k] = (uint8_t)p[k];
+            }
+            BeaconSim::queueGoal(a * 1000, params);
+        } else if (strcmp(arg, "--cancel") == 0) {
+            BeaconSim::queueCancel(strtoull(value, nullptr, 10) * 1000);
+        } else {
+            return false;
+        }
+    }
+    return options.step_us > 0;
+}
+
+bool isEpochEnd(const uint8_t* line, size_t length) {
+    // u-blox schließt die Epoche mit GGA ab, siehe GPSManager::update()
+    return length > 6 && line[0] == '$' && memcmp(line + 3, "GGA", 3) == 0;
+}
+
+// Spielt den Mitschnitt mit GPS_BAUD ein, bei NMEA in Epochen-Bursts
+bool feedGps(const Options& options) {
+    FILE* file = fopen(options.gpsFile, "rb");
+    if (file == nullptr) {
+        fprintf(stderr, "cannot open %s\n", options.gpsFile);
+        return false;
+    }
+    const uint64_t byte_ns = 10000000000ULL / GPS_BAUD;    // 8N1: 10 Bit je Byte
+    const uint64_t epoch_ns = (uint64_t)options.gpsEpoch_ms * 1000000;
+    uint64_t t_ns = 0;
+    uint64_t epochStart_ns = 0;
+    uint8_t line[128];
+    size_t lineLength = 0;
+    int c;
+    while ((c = fgetc(file)) != EOF) {
+        GPS_SERIAL.simReceive((uint8_t)c, t_ns / 1000);
+        t_ns += byte_ns;
+        if (lineLength < sizeof(line)) {
+            line[lineLength++] = (uint8_t)c;
+        }
+        if (c != '\n') {
+            continue;
+        }
+        if (epoch_ns > 0 && isEpochEnd(line, lineLength)) {
+            epochStart_ns += epoch_ns;
+            if (t_ns < epochStart_ns) {
+                t_ns = epochStart_ns;
+            }
+        }
+        lineLength = 0;
+    }
+    fclose(file);
+    return true;
+}
+
+void printSummary(const Options& options, uint64_t loops, double host_s) {
+    double sim_s = BeaconSim::now() * 1e-6;
+    fprintf(stderr, "\n--- sim ---\n");
+    fprintf(stderr, "time       sim %.3f s  host %.3f s  speed %.0fx  loops %llu\n",
+            sim_s, host_s, host_s > 0 ? sim_s / host_s : 0.0, (unsigned long long)loops);
+    HardwareSerial* ports[] = {&Serial, &Serial2, &Serial3};
+    for (HardwareSerial* port : ports) {
+        fprintf(stderr, "%-10s rx %llu  dropped %llu  tx %llu\n", port->simName(),
+                (unsigned long long)port->simBytesReceived(), (unsigned long long)port->simBytesDropped(),
+                (unsigned long long)port->simBytesSent());
+    }
+    fprintf(stderr, "i2c        transfers %lu  bytes %lu  busy %llu us\n",
+            (unsigned long)Wire.simTransfers(), (unsigned long)Wire.simBytes(),
+            (unsigned long long)Wire.simBusyMicros());
+    fprintf(stderr, "ws2812     frames %lu  rejected %lu\n",
+            (unsigned long)WS2812Serial::simFramesShown(), (unsigned long)WS2812Serial::simFramesRejected());
+    BeaconSim::printMicroROSStats(stderr);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseArgs(argc, argv, options)) {
+        usage(argv[0]);
+        return 2;
+    }
+    if (options.gpsFile != nullptr && !feedGps(options)) {
+        return 1;
+    }
+    if (options.stats_ms > 0) {
+        for (uint64_t t = (uint64_t)options.stats_ms * 1000; t <= options.duration_us; t += (uint64_t)options.stats_ms * 1000) {
+            options.console.emplace(t, "s");
+        }
+    }
+    for (const auto& input : options.console) {
+        for (char c : input.second) {
+            Serial.simReceive((uint8_t)c, input.first);
+        }
+    }
+    Serial.simSetOutput(options.quiet ? nullptr : stdout);
+    Wire.simSetLog(options.i2cLog);
+    WS2812Serial::simSetLog(options.ledLog);
+
+    auto hostStart = std::chrono::steady_clock::now();
+    uint64_t loops = 0;
+    setup();
+    while (BeaconSim::now() < options.duration_us) {
+        loop();
+        loops++;
+        BeaconSim::advance(options.step_us);
+    }
+    std::chrono::duration<double> host = std::chrono::steady_clock::now() - hostStart;
+
+    fflush(stdout);
+    printSummary(options, loops, host.count());
+    if (options.i2cLog != nullptr) {
+        fclose(options.i2cLog);
+    }
+    if (options.ledLog != nullptr) {
+        fclose(options.ledLog);
+    }
+    return 0;
+}
+
+#endif  // PIO_UNIT_TESTING
@@ -0,0 +1,432 @@
+#include "BeaconSim.h"
+#include <micro_ros_platformio.h>
+#include <rcl/rcl.h>
+#include <rclc/rclc.h>
+#include <rclc/executor.h>
+#include <rclc/action_server.h>
+#include <std_msgs/msg/bool.h>
+#include <sensor_msgs/msg/nav_sat_fix.h>
+#include <beacon_interfaces/action/led_animation.h>
+#include <diagnostic_msgs/msg/diagnostic_array.h>
+#include <deque>
+#include <map>
+#include <set>
+#include <string>
+
+/**
+ * Simulierter micro-ROS-Agent
+ *
+ * Der Agent ist in einem Zeitfenster erreichbar. Jeder Aufruf, der auf dem
+ * Gerät auf eine Antwort des Agenten wartet, kostet eine Umlaufzeit, bei
+ * unerreichbarem Agenten die volle Wartezeit. Veröffentlichte Nachrichten
+ * werden je Topic gezählt, Aktionsziele kommen aus einer Zeitliste.
+ */
+
+#define SIM_AGENT_ROUND_TRIP_US 1000
+#define SIM_AGENT_SESSION_TIMEOUT_US 1000000   // Vergeblicher Sitzungsaufbau
+#define SIM_AGENT_ENTITY_TIMEOUT_US 1000000    // Vorgabe für das Anlegen einer Entität
+#define SIM_AGENT_PUBLISH_TIMEOUT_US 1000000   // Vorgabe für zuverlässiges Senden
+#define SIM_AGENT_EPOCH_NS 1700000000000000000LL
+
+const rosidl_message_type_support_t std_msgs__msg__Bool__type_support = {"std_msgs/msg/Bool"};
+const rosidl_message_type_support_t sensor_msgs__msg__NavSatFix__type_support = {"sensor_msgs/msg/NavSatFix"};
+const rosidl_message_type_support_t diagnostic_msgs__msg__DiagnosticArray__type_support = {"diagnostic_msgs/msg/DiagnosticArray"};
+const rosidl_action_type_support_t beacon_interfaces__action__LEDAnimation__type_support = {"beacon_interfaces/action/LEDAnimation"};
+
+struct sim_topic_t {
+    std::string name;
+    uint64_t published;
+    uint64_t failed;
+};
+
+namespace {
+
+uint64_t agentFrom_us = 0;
+uint64_t agentUntil_us = UINT64_MAX;
+uint64_t entityTimeout_us = SIM_AGENT_ENTITY_TIMEOUT_US;
+
+std::deque<sim_topic_t> topics;     // Bleiben über Neuverbindungen erhalten
+
+struct Goal {
+    uint8_t params[8];
+};
+std::multimap<uint64_t, Goal> goals;
+std::multiset<uint64_t> cancels;
+rclc_action_goal_handle_t* lastGoal = nullptr;
+
+rcutils_allocator_t defaultAllocator = rcutils_get_zero_initialized_allocator();
+
+struct Stats {
+    uint32_t pings;
+    uint32_t pingFailures;
+    uint32_t syncs;
+    uint32_t sessions;
+    uint32_t sessionFailures;
+    uint32_t goalsAccepted;
+    uint32_t goalsRejected;
+    uint32_t cancelsAccepted;
+    uint32_t cancelsRejected;
+    uint32_t feedback;
+    uint32_t results[GOAL_STATE_ABORTED + 1];
+} stats;
+
+bool agentAvailable() {
+    uint64_t now = BeaconSim::now();
+    return now >= agentFrom_us && now < agentUntil_us;
+}
+
+// Anfrage an den Agenten: eine Umlaufzeit oder die volle Wartezeit
+bool requestAgent(uint64_t timeout_us) {
+    if (agentAvailable()) {
+        BeaconSim::advance(SIM_AGENT_ROUND_TRIP_US);
+        return true;
+    }
+    BeaconSim::advance(timeout_us);
+    return false;
+}
+
+void* mallocAllocate(size_t size, void*) {
+    return malloc(size);
+}
+
+void mallocDeallocate(void* pointer, void*) {
+    free(pointer);
+}
+
+void* mallocReallocate(void* pointer, size_t size, void*) {
+    return realloc(pointer, size);
+}
+
+void* mallocZeroAllocate(size_t count, size_t size, void*) {
+    return calloc(count, size);
+}
+
+rclc_action_goal_handle_t* freeGoalHandle(rclc_action_server_t* server) {
+    for (size_t i = 0; i < server->goal_handles_count; i++) {
+        if (server->goal_handles[i].available) {
+            return &server->goal_handles[i];
+        }
+    }
+    return nullptr;
+}
+
+void deliverGoal(rclc_action_server_t* server, const Goal& goal) {
+    rclc_action_goal_handle_t* handle = freeGoalHandle(server);
+    if (handle == nullptr) {
+        stats.goalsRejected++;
+        return;
+    }
+    beacon_interfaces__action__LEDAnimation_SendGoal_Request* request =
+        static_cast<beacon_interfaces__action__LEDAnimation_SendGoal_Request*>(handle->ros_goal_request);
+    memcpy(request->goal.params, goal.params, sizeof(goal.params));
+    handle->available = false;
+    handle->status = GOAL_STATE_UNKNOWN;
+    if (server->goal_callback(handle, server->context) == RCL_RET_ACTION_GOAL_ACCEPTED) {
+        handle->status = GOAL_STATE_EXECUTING;
+        lastGoal = handle;
+        stats.goalsAccepted++;
+    } else {
+        handle->available = true;
+        stats.goalsRejected++;
+    }
+}
+
+void deliverCancel(rclc_action_server_t* server) {
+    rclc_action_goal_handle_t* handle = lastGoal;
+    if (handle == nullptr || handle->available || handle->status != GOAL_STATE_EXECUTING) {
+        stats.cancelsRejected++;
+        return;
+    }
+    if (server->cancel_callback(handle, server->context)) {
+        handle->status = GOAL_STATE_CANCELING;
+        stats.cancelsAccepted++;
+    } else {
+        stats.cancelsRejected++;
+    }
+}
+
+}  // namespace
+
+void BeaconSim::setAgentWindow(uint64_t from_us, uint64_t until_us) {
+    agentFrom_us = from_us;
+    agentUntil_us = until_us;
+}
+
+void BeaconSim::queueGoal(uint64_t at_us, const uint8_t params[8]) {
+    Goal goal;
+    memcpy(goal.params, params, sizeof(goal.params));
+    goals.insert(std::make_pair(at_us, goal));
+}
+
+void BeaconSim::queueCancel(uint64_t at_us) {
+    cancels.insert(at_us);
+}
+
+void BeaconSim::printMicroROSStats(FILE* out) {
+    fprintf(out, "agent      pings %lu  failed %lu  syncs %lu  sessions %lu  failed %lu\n",
+            (unsigned long)stats.pings, (unsigned long)stats.pingFailures, (unsigned long)stats.syncs,
+            (unsigned long)stats.sessions, (unsigned long)stats.sessionFailures);
+    for (const sim_topic_t& topic : topics) {
+        fprintf(out, "topic      %-28s published %llu  failed %llu\n", topic.name.c_str(),
+                (unsigned long long)topic.published, (unsigned long long)topic.failed);
+    }
+    fprintf(out, "goals      accepted %lu  rejected %lu  cancel %lu/%lu  feedback %lu\n",
+            (unsigned long)stats.goalsAccepted, (unsigned long)stats.goalsRejected,
+            (unsigned long)stats.cancelsAccepted, (unsigned long)(stats.cancelsAccepted + stats.cancelsRejected),
+            (unsigned long)stats.feedback);
+    fprintf(out, "results    succeeded %lu  canceled %lu  aborted %lu\n",
+            (unsigned long)stats.results[GOAL_STATE_SUCCEEDED], (unsigned long)stats.results[GOAL_STATE_CANCELED],
+            (unsigned long)stats.results[GOAL_STATE_ABORTED]);
+}
+
+void set_microros_serial_transports(Stream& stream) {
+}
+
+rcutils_allocator_t rcutils_get_zero_initialized_allocator(void) {
+    rcutils_allocator_t allocator;
+    memset(&allocator, 0, sizeof(allocator));
+    return allocator;
+}
+
+rcutils_allocator_t rcutils_get_default_allocator(void) {
+    if (defaultAllocator.allocate == nullptr) {
+        defaultAllocator.allocate = mallocAllocate;
+        defaultAllocator.deallocate = mallocDeallocate;
+        defaultAllocator.reallocate = mallocReallocate;
+        defaultAllocator.zero_allocate = mallocZeroAllocate;
+    }
+    return defaultAllocator;
+}
+
+bool rcutils_set_default_allocator(rcutils_allocator_t* allocator) {
+    if (allocator == nullptr || allocator->allocate == nullptr || allocator->deallocate == nullptr ||
+        allocator->reallocate == nullptr || allocator->zero_allocate == nullptr) {
+        return false;
+    }
+    defaultAllocator = *allocator;
+    return true;
+}
+
+rmw_ret_t rmw_uros_ping_agent(int timeout_ms, uint8_t attempts) {
+    stats.pings++;
+    if (requestAgent((uint64_t)timeout_ms * attempts * 1000)) {
+        return RMW_RET_OK;
+    }
+    stats.pingFailures++;
+    return RMW_RET_ERROR;
+}
+
+rmw_ret_t rmw_uros_sync_session(int timeout_ms) {
+    if (requestAgent((uint64_t)timeout_ms * 1000)) {
+        stats.syncs++;
+        return RMW_RET_OK;
+    }
+    return RMW_RET_TIMEOUT;
+}
+
+int64_t rmw_uros_epoch_nanos(void) {
+    return SIM_AGENT_EPOCH_NS + (int64_t)BeaconSim::now() * 1000;
+}
+
+rmw_ret_t rmw_uros_set_context_entity_creation_session_timeout(rmw_context_t* context, int64_t timeout_ms) {
+    entityTimeout_us = (uint64_t)timeout_ms * 1000;
+    return RMW_RET_OK;
+}
+
+rmw_ret_t rmw_uros_set_publisher_session_timeout(rcl_publisher_t* publisher, int64_t timeout_ms) {
+    publisher->session_timeout_ms = (uint32_t)timeout_ms;
+    return RMW_RET_OK;
+}
+
+rmw_ret_t rmw_uros_set_context_entity_destroy_session_timeout(rmw_context_t* context, int64_t timeout_ms) {
+    if (context != nullptr) {
+        context->destroy_session_timeout_ms = (uint32_t)timeout_ms;
+    }
+    return RMW_RET_OK;
+}
+
+rmw_context_t* rcl_context_get_rmw_context(rcl_context_t* context) {
+    return &context->rmw_context;
+}
+
+rcl_ret_t rclc_support_init(rclc_support_t* support, int argc, char const* const* argv,
+                            rcl_allocator_t* allocator) {
+    if (!requestAgent(SIM_AGENT_SESSION_TIMEOUT_US)) {
+        stats.sessionFailures++;
+        return RCL_RET_ERROR;
+    }
+    stats.sessions++;
+    entityTimeout_us = SIM_AGENT_ENTITY_TIMEOUT_US;
+    support->allocator = allocator;
+    return RCL_RET_OK;
+}
+
+rcl_ret_t rclc_support_fini(rclc_support_t* support) {
+    return RCL_RET_OK;
+}
+
+rcl_node_t rcl_get_zero_initialized_node(void) {
+    return rcl_node_t{nullptr};
+}
+
+rcl_ret_t rclc_node_init_default(rcl_node_t* node, const char* name, const char* namespace_,
+                                 rclc_support_t* support) {
+    if (!requestAgent(entityTimeout_us)) {
+        return RCL_RET_ERROR;
+    }
+    node->name = name;
+    return RCL_RET_OK;
+}
+
+rcl_ret_t rcl_node_fini(rcl_node_t* node) {
+    node->name = nullptr;
+    return RCL_RET_OK;
+}
+
+rcl_publisher_t rcl_get_zero_initialized_publisher(void) {
+    return rcl_publisher_t{nullptr, 0};
+}
+
+rcl_ret_t rclc_publisher_init_default(rcl_publisher_t* publisher, const rcl_node_t* node,
+                                      const rosidl_message_type_support_t* type_support,
+                                      const char* topic_name) {
+    if (!requestAgent(entityTimeout_us)) {
+        return RCL_RET_ERROR;
+    }
+    for (sim_topic_t& topic : topics) {
+        if (topic.name == topic_name) {
+            publisher->impl = &topic;
+            return RCL_RET_OK;
+        }
+    }
+    topics.push_back(sim_topic_t{topic_name, 0, 0});
+    publisher->impl = &topics.back();
+    return RCL_RET_OK;
+}
+
+rcl_ret_t rcl_publisher_fini(rcl_publisher_t* publisher, rcl_node_t* node) {
+    publisher->impl = nullptr;
+    return RCL_RET_OK;
+}
+
+rcl_ret_t rcl_publish(const rcl_publisher_t* publisher, const void* ros_message,
+                      rmw_publisher_allocation_t* allocation) {
+    if (publisher->impl == nullptr) {
+        return RCL_RET_INVALID_ARGUMENT;
+    }
+    if (!agentAvailable()) {
+        // Zuverlässiges Senden wartet bis zum Ablauf auf die Bestätigung
+        publisher->impl->failed++;
+        uint32_t timeout_ms = publisher->session_timeout_ms;
+        BeaconSim::advance(timeout_ms != 0 ? (uint64_t)timeout_ms * 1000 : SIM_AGENT_PUBLISH_TIMEOUT_US);
+        return RCL_RET_ERROR;
+    }
+    publisher->impl->published++;
+    return RCL_RET_OK;
+}
+
+rcl_ret_t rclc_action_server_init_default(rclc_action_server_t* action_server, rcl_node_t* node,
+                                          rclc_support_t* support,
+                                          const rosidl_action_type_support_t* type_support,
+                                          const char* action_name) {
+    if (!requestAgent(entityTimeout_us)) {
+        return RCL_RET_ERROR;
+    }
+    memset(action_server, 0, sizeof(*action_server));
+    action_server->name = action_name;
+    return RCL_RET_OK;
+}
+
+rcl_ret_t rclc_action_server_fini(rclc_action_server_t* action_server, rcl_node_t* node) {
+    for (size_t i = 0; i < action_server->goal_handles_count; i++) {
+        if (&action_server->goal_handles[i] == lastGoal) {
+            lastGoal = nullptr;
+        }
+    }
+    memset(action_server, 0, sizeof(*action_server));
+    return RCL_RET_OK;
+}
+
+rcl_ret_t rclc_action_publish_feedback(rclc_action_goal_handle_t* goal_handle, void* ros_feedback) {
+    if (goal_handle == nullptr || goal_handle->available || !agentAvailable()) {
+        return RCL_RET_ERROR;
+    }
+    stats.feedback++;
+    return RCL_RET_OK;
+}
+
+rcl_ret_t rclc_action_send_result(rclc_action_goal_handle_t* goal_handle,
+                                  rcl_action_goal_state_t status, void* ros_response) {
+    if (goal_handle == nullptr || goal_handle->available) {
+        return RCL_RET_ERROR;
+    }
+    if (status >= GOAL_STATE_SUCCEEDED && status <= GOAL_STATE_ABORTED) {
+        stats.results[status]++;
+    }
+    goal_handle->status = status;
+    goal_handle->available = true;
+    return RCL_RET_OK;
+}
+
+rclc_executor_t rclc_executor_get_zero_initialized_executor(void) {
+    return rclc_executor_t{nullptr, 0};
+}
+
+rcl_ret_t rclc_executor_init(rclc_executor_t* executor, rcl_context_t* context,
+                             const size_t number_of_handles, const rcl_allocator_t* allocator) {
+    executor->action_server = nullptr;
+    executor->max_handles = number_of_handles;
+    return RCL_RET_OK;
+}
+
+rcl_ret_t rclc_executor_fini(rclc_executor_t* executor) {
+    executor->action_server = nullptr;
+    return RCL_RET_OK;
+}
+
+rcl_ret_t rclc_executor_add_action_server(rclc_executor_t* executor, rclc_action_server_t* action_server,
+                                          size_t handles_number, void* ros_request_msg,
+                                          size_t ros_request_msg_size,
+                                          rclc_action_handle_goal_request_t goal_callback,
+                                          rclc_action_handle_cancel_request_t cancel_callback,
+                                          void* context) {
+    if (executor->action_server != nullptr || executor->max_handles == 0 ||
+        handles_number == 0 || handles_number > RCLC_ACTION_SERVER_MAX_GOALS) {
+        return RCL_RET_ERROR;
+    }
+    for (size_t i = 0; i < handles_number; i++) {
+        rclc_action_goal_handle_t& handle = action_server->goal_handles[i];
+        handle.available = true;
+        handle.ros_goal_request = (uint8_t*)ros_request_msg + i * ros_request_msg_size;
+        handle.status = GOAL_STATE_UNKNOWN;
+        handle.action_server = action_server;
+    }
+    action_server->goal_handles_count = handles_number;
+    action_server->goal_callback = goal_callback;
+    action_server->cancel_callback = cancel_callback;
+    action_server->context = context;
+    executor->action_server = action_server;
+    return RCL_RET_OK;
+}
+
+rcl_ret_t rclc_executor_spin_some(rclc_executor_t* executor, const uint64_t timeout_ns) {
+    rclc_action_server_t* server = executor->action_server;
+    if (server == nullptr) {
+        return RCL_RET_ERROR;
+    }
+    // Ziele und Abbrüche erreichen das Gerät nur bei erreichbarem Agenten, sonst warten sie
+    if (!agentAvailable()) {
+        return RCL_RET_TIMEOUT;
+    }
+    uint64_t now = BeaconSim::now();
+    while (!cancels.empty() && *cancels.begin() <= now) {
+        cancels.erase(cancels.begin());
+        deliverCancel(server);
+    }
+    while (!goals.empty() && goals.begin()->first <= now) {
+        Goal goal = goals.begin()->second;
+        goals.erase(goals.begin());
+        deliverGoal(server, goal);
+    }
+    return RCL_RET_OK;
+}
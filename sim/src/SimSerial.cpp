@@ -0,0 +1,158 @@
+#include "BeaconSim.h"
+
+// Empfangspuffer wie im Teensy-4-Core, die Konsole (USB) puffert deutlich mehr
+HardwareSerial Serial("Serial", 4096);
+HardwareSerial Serial2("Serial2", 64);
+HardwareSerial Serial3("Serial3", 64);
+
+size_t Print::write(const uint8_t* buffer, size_t size) {
+    size_t count = 0;
+    while (size--) {
+        count += write(*buffer++);
+    }
+    return count;
+}
+
+size_t Print::printNumber(unsigned long long n, int base) {
+    char buf[8 * sizeof(n) + 1];
+    char* str = &buf[sizeof(buf) - 1];
+    *str = '\0';
+    if (base < 2) {
+        base = 10;
+    }
+    do {
+        char digit = n % base;
+        n /= base;
+        *--str = digit < 10 ? digit + '0' : digit + 'A' - 10;
+    } while (n);
+    return write(str);
+}
+
+size_t Print::print(long n, int base) {
+    return print((long long)n, base);
+}
+
+size_t Print::print(unsigned long n, int base) {
+    return printNumber(n, base);
+}
+
+size_t Print::print(long long n, int base) {
+    if (n < 0 && base == DEC) {
+        return print('-') + printNumber(-(unsigned long long)n, base);
+    }
+    return printNumber((unsigned long long)n, base);
+}
+
+size_t Print::print(unsigned long long n, int base) {
+    return printNumber(n, base);
+}
+
+size_t Print::print(double n, int digits) {
+    char buf[64];
+    snprintf(buf, sizeof(buf), "%.*f", digits, n);
+    return write(buf);
+}
+
+int Print::printf(const char* format, ...) {
+    char buf[256];
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(buf, sizeof(buf), format, args);
+    va_end(args);
+    if (length < 0) {
+        return length;
+    }
+    if ((size_t)length < sizeof(buf)) {
+        write((const uint8_t*)buf, length);
+        return length;
+    }
+    // Lange Ausgaben in einem eigenen Puffer formatieren
+    std::vector<char> large(length + 1);
+    va_start(args, format);
+    vsnprintf(large.data(), large.size(), format, args);
+    va_end(args);
+    write((const uint8_t*)large.data(), length);
+    return length;
+}
+
+HardwareSerial::HardwareSerial(const char* name, size_t rxBufferSize)
+    : name(name)
+    , baud(0)
+    , capacity(rxBufferSize)
+    , output(nullptr)
+    , pendingNext(0)
+    , received(0)
+    , dropped(0)
+    , sent(0)
+{
+}
+
+void HardwareSerial::begin(uint32_t baud, uint16_t format) {
+    this->baud = baud;
+}
+
+void HardwareSerial::addMemoryForRead(void* buffer, size_t length) {
+    capacity += length;
+}
+
+void HardwareSerial::receiveDue() {
+    uint64_t now = BeaconSim::now();
+    while (pendingNext < pending.size() && pending[pendingNext].at_us <= now) {
+        // Voller Empfangspuffer: wie beim UART geht das neue Byte verloren
+        if (rxBuffer.size() < capacity) {
+            rxBuffer.push_back(pending[pendingNext].value);
+        } else {
+            dropped++;
+        }
+        received++;
+        pendingNext++;
+    }
+    if (pendingNext == pending.size()) {
+        pending.clear();
+        pendingNext = 0;
+    }
+}
+
+int HardwareSerial::available() {
+    receiveDue();
+    return (int)rxBuffer.size();
+}
+
+int HardwareSerial::read() {
+    receiveDue();
+    if (rxBuffer.empty()) {
+        return -1;
+    }
+    uint8_t value = rxBuffer.front();
+    rxBuffer.pop_front();
+    return value;
+}
+
+int HardwareSerial::peek() {
+    receiveDue();
+    return rxBuffer.empty() ? -1 : rxBuffer.front();
+}
+
+size_t HardwareSerial::write(uint8_t b) {
+    return write(&b, 1);
+}
+
+size_t HardwareSerial::write(const uint8_t* buffer, size_t size) {
+    sent += size;
+    if (output != nullptr) {
+        fwrite(buffer, 1, size, output);
+    }
+    return size;
+}
+
+void HardwareSerial::simReceive(uint8_t value, uint64_t at_us) {
+    // Reihenfolge der Bytes bleibt erhalten, auch bei gleicher oder älterer Zeit
+    if (!pending.empty() && at_us < pending.back().at_us) {
+        at_us = pending.back().at_us;
+    }
+    pending.push_back(Arrival{at_us, value});
+}
+
+void HardwareSerial::simSetOutput(FILE* file) {
+    output = file;
+}
@@ -0,0 +1,87 @@
+#include "BeaconSim.h"
+#include <WS2812Serial.h>
+
+#define WS2812_US_PER_LED 30        // 24 Bit zu je 1,25 µs
+#define WS2812_RESET_US 300
+
+namespace {
+
+FILE* frameLog = nullptr;
+uint32_t framesShown = 0;
+uint32_t framesRejected = 0;
+
+}  // namespace
+
+WS2812Serial::WS2812Serial(uint16_t num, void* fb, void* db, uint8_t pin, uint8_t cfg)
+    : numled(num)
+    , drawBuffer((uint8_t*)db)
+    , frameBuffer((uint8_t*)fb)
+    , pending(false)
+    , lineFree_us(0)
+{
+}
+
+WS2812Serial::WS2812Serial(uint16_t num, void* fb, void* fb2, void* db, uint8_t pin, uint8_t cfg)
+    : WS2812Serial(num, fb, db, pin, cfg)
+{
+}
+
+bool WS2812Serial::begin() {
+    return true;
+}
+
+bool WS2812Serial::busy() {
+    return BeaconSim::now() < lineFree_us;
+}
+
+void WS2812Serial::show() {
+    BeaconSim::advanceTo(lineFree_us);
+    startTransfer(drawBuffer);
+}
+
+bool WS2812Serial::tryShow() {
+    if (pending) {
+        framesRejected++;
+        return false;
+    }
+    if (busy()) {
+        memcpy(frameBuffer, drawBuffer, numled * 3);
+        pending = true;
+        return true;
+    }
+    startTransfer(drawBuffer);
+    return true;
+}
+
+bool WS2812Serial::poll() {
+    if (!pending || busy()) {
+        return false;
+    }
+    pending = false;
+    startTransfer(frameBuffer);
+    return true;
+}
+
+void WS2812Serial::startTransfer(const uint8_t* frame) {
+    lineFree_us = BeaconSim::now() + (uint64_t)numled * WS2812_US_PER_LED + WS2812_RESET_US;
+    framesShown++;
+    if (frameLog != nullptr) {
+        fprintf(frameLog, "%llu", (unsigned long long)BeaconSim::now());
+        for (uint16_t i = 0; i < numled * 3; i += 3) {
+            fprintf(frameLog, " %02x%02x%02x", frame[i], frame[i + 1], frame[i + 2]);
+        }
+        fputc('\n', frameLog);
+    }
+}
+
+void WS2812Serial::simSetLog(FILE* file) {
+    frameLog = file;
+}
+
+uint32_t WS2812Serial::simFramesShown() {
+    return framesShown;
+}
+
+uint32_t WS2812Serial::simFramesRejected() {
+    return framesRejected;
+}
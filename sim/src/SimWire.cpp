@@ -0,0 +1,78 @@
+#include "BeaconSim.h"
+#include <Wire.h>
+
+TwoWire Wire;
+
+TwoWire::TwoWire()
+    : frequency(100000)
+    , address(0)
+    , txLength(0)
+    , transmitting(false)
+    , log(nullptr)
+    , transfers(0)
+    , bytes(0)
+    , busy_us(0)
+{
+}
+
+void TwoWire::begin() {
+}
+
+void TwoWire::setClock(uint32_t frequency) {
+    if (frequency > 0) {
+        this->frequency = frequency;
+    }
+}
+
+void TwoWire::beginTransmission(uint8_t address) {
+    this->address = address;
+    txLength = 0;
+    transmitting = true;
+}
+
+size_t TwoWire::write(uint8_t b) {
+    if (!transmitting || txLength >= BUFFER_LENGTH) {
+        return 0;
+    }
+    txBuffer[txLength++] = b;
+    return 1;
+}
+
+size_t TwoWire::write(const uint8_t* data, size_t length) {
+    size_t count = 0;
+    while (count < length && write(data[count])) {
+        count++;
+    }
+    return count;
+}
+
+uint8_t TwoWire::endTransmission(uint8_t sendStop) {
+    if (!transmitting) {
+        return 4;
+    }
+    transmitting = false;
+
+    if (log != nullptr) {
+        fprintf(log, "%llu 0x%02x", (unsigned long long)BeaconSim::now(), address);
+        for (uint8_t i = 0; i < txLength; i++) {
+            fprintf(log, " %02x", txBuffer[i]);
+        }
+        fputc('\n', log);
+    }
+
+    // Adresse und Daten mit je 9 Takten, START und STOP zusammen etwa 2 Takte
+    uint64_t duration_us = ((uint64_t)(txLength + 1) * 9 + 2) * 1000000 / frequency;
+    transfers++;
+    bytes += txLength;
+    busy_us += duration_us;
+    BeaconSim::advance(duration_us);
+    return 0;
+}
+
+uint8_t TwoWire::requestFrom(uint8_t address, uint8_t quantity, uint8_t sendStop) {
+    return 0;
+}
+
+void TwoWire::simSetLog(FILE* file) {
+    log = file;
+}
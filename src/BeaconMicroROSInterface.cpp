@@ -1,6 +1,9 @@
 #include "BeaconMicroROSInterface.h"
 #include "HatchManager.h"
 #include "GPSManager.h"
+#include "TimeSync.h"
+#include "TaskScheduler.h"
+#include "CycleCounter.h"
 
 #define DEBUG_SERIAL Serial
 #if defined DEBUG_SERIAL
@@ -11,26 +14,94 @@
   #define DEBUG_PRINT(X)
 #endif 
 
+BeaconMicroROSInterface* BeaconMicroROSInterface::instance = nullptr;
 
+// Arena für alle Allokationen von rcl/rmw, ersetzt den Heap
+static uint8_t ros_arena[ROS_ALLOCATOR_ARENA_SIZE] __attribute__((aligned(8)));
 
-BeaconMicroROSInterface::BeaconMicroROSInterface(HatchManager* hatchManager, GPSManager* gpsManager)
+static char diagnostics_hardware_id[] = "beacon";
+
+BeaconMicroROSInterface::BeaconMicroROSInterface(HatchManager* hatchManager, GPSManager* gpsManager, TimeSync* timeSync,
+                                                 LEDAnimationController* ledController, TaskScheduler* scheduler)
     : hatchManager(hatchManager)
     , gpsManager(gpsManager)
-    , ping_timeout_ms(100)
+    , timeSync(timeSync)
+    , ledController(ledController)
+    , scheduler(scheduler)
+    , arena(ros_arena, sizeof(ros_arena))
+    , active_goals{}
+    , animation_accepted(false)
+    , animation_progress{}
+    , animation_status{}
+    , diagnostics_task(0)
+    , diagnostics_faults{}
+    , ping_timer(0)
+    , sync_timer(0)
+    , ping_interval_ms(ROS_PING_BACKOFF_MIN_MS)
+    , ping_failures(0)
+    , create_step(0)
+    , blocking_stats{0, 0, 0, 0}
+    , budget_start_us(0)
     , last_publish_hatch(0)
     , last_publish_gps(0)
+    , last_hatch_sequence(0)
+    , last_publish_feedback(0)
+    , last_gps_sequence(0)
+    , last_publish_diagnostics(0)
 {
+    initDiagnosticsMessage();
+}
+
+// Die Nachricht zeigt dauerhaft auf die Puffer der Instanz, publishDiagnostics() füllt nur die Texte
+void BeaconMicroROSInterface::initDiagnosticsMessage() {
+    static const char* const keys[DIAGNOSTICS_VALUES] = {
+        "runs", "exec_avg_us", "exec_max_us", "latency_max_us", "exec_hist", "latency_hist"
+    };
+    memset(&msg_diagnostics, 0, sizeof(msg_diagnostics));
+    memset(&diagnostics_status, 0, sizeof(diagnostics_status));
+    msg_diagnostics.status.data = &diagnostics_status;
+    msg_diagnostics.status.size = 1;
+    msg_diagnostics.status.capacity = 1;
+
+    setString(diagnostics_status.hardware_id, diagnostics_hardware_id, sizeof(diagnostics_hardware_id));
+    diagnostics_name[0] = '\0';
+    diagnostics_message[0] = '\0';
+    setString(diagnostics_status.name, diagnostics_name, sizeof(diagnostics_name));
+    setString(diagnostics_status.message, diagnostics_message, sizeof(diagnostics_message));
+    for (uint8_t i = 0; i < DIAGNOSTICS_VALUES; i++) {
+        // rcl liest die Schlüssel nur, der const_cast ist unkritisch
+        char* key = const_cast<char*>(keys[i]);
+        setString(diagnostics_values[i].key, key, strlen(key) + 1);
+        diagnostics_text[i][0] = '\0';
+        setString(diagnostics_values[i].value, diagnostics_text[i], DIAGNOSTICS_VALUE_LENGTH);
+    }
+    diagnostics_status.values.data = diagnostics_values;
+    diagnostics_status.values.size = DIAGNOSTICS_VALUES;
+    diagnostics_status.values.capacity = DIAGNOSTICS_VALUES;
 }
 
 void BeaconMicroROSInterface::initialize() {
+    // rcl/rmw allokieren ab jetzt ausschließlich aus der statischen Arena
+    rcutils_allocator_t arena_allocator = arena.getAllocator();
+    rcutils_set_default_allocator(&arena_allocator);
+    resetEntities();
+    
     // Setup MicroROS transport
     Serial2.begin(115200);
     set_microros_serial_transports(Serial2);
     
+    // Rückmeldungen des LED-Controllers an den Action Server weiterleiten
+    instance = this;
+    ledController->setFeedbackCallback(onAnimationFeedback);
+    ledController->setResultCallback(onAnimationResult);
+    
     state = WAITING_AGENT;
-    ping_timeout_ms = 500;
+    ping_interval_ms = ROS_PING_BACKOFF_MIN_MS;
+    ping_failures = 0;
     
     // Reset timers
+    ping_timer = 0;
+    sync_timer = 0;
     last_publish_hatch = 0;
     last_publish_gps = 0;
 
@@ -38,127 +109,489 @@ void BeaconMicroROSInterface::initialize() {
 }
 
 void BeaconMicroROSInterface::update() {
+    states previous_state = state;
+    budget_start_us = micros();
 
     switch (state) {
         case WAITING_AGENT:
-          state = (RMW_RET_OK == rmw_uros_ping_agent(ping_timeout_ms, 1)) ? AGENT_AVAILABLE : WAITING_AGENT;
+          // Agent nur nach Zeitplan anpingen, bei Misserfolg mit exponentiellem Backoff
+          if (ping_timer >= ping_interval_ms) {
+            ping_timer = 0;
+            if (pingAgent()) {
+              state = AGENT_AVAILABLE;
+              create_step = 0;
+              ping_interval_ms = ROS_PING_BACKOFF_MIN_MS;
+            } else {
+              ping_interval_ms = min((uint32_t)(ping_interval_ms * 2), (uint32_t)ROS_PING_BACKOFF_MAX_MS);
+            }
+          }
           break;
-        case AGENT_AVAILABLE:
-          state = (true == createEntities()) ? AGENT_CONNECTED : WAITING_AGENT;
-          if (state == WAITING_AGENT) {
+        case AGENT_AVAILABLE: {
+          // Eine Entität pro Aufruf, jeder Aufruf wartet höchstens einmal auf den Agenten
+          uint32_t start_us = micros();
+          bool ok = createNextEntity();
+          recordBlocking(start_us);
+          if (!ok) {
             destroyEntities();
-          };
+            state = WAITING_AGENT;
+          } else if (create_step == CREATE_STEPS) {
+            state = AGENT_CONNECTED;
+            ping_timer = 0;
+            ping_failures = 0;
+            sync_timer = ROS_TIME_SYNC_INTERVAL_MS;   // sofort synchronisieren
+            last_publish_hatch = HATCH_HEARTBEAT_MS;  // Klappenzustand sofort senden
+          }
           break;
+        }
         case AGENT_CONNECTED:
-          state = (RMW_RET_OK == rmw_uros_ping_agent(ping_timeout_ms, 1)) ? AGENT_CONNECTED : AGENT_DISCONNECTED;
-          if (state == AGENT_CONNECTED) {
-            rmw_uros_sync_session(ping_timeout_ms);
-            time_ms = rmw_uros_epoch_millis(); 
-            processMessages();
+          // Verbindung nur periodisch prüfen, einzelne verlorene Pings tolerieren
+          if (ping_timer >= ROS_PING_INTERVAL_CONNECTED_MS && remainingBudgetMs() > 0) {
+            ping_timer = 0;
+            if (pingAgent()) {
+              ping_failures = 0;
+            } else if (++ping_failures >= ROS_PING_MAX_FAILURES) {
+              state = AGENT_DISCONNECTED;
+              break;
+            }
           }
+          if (sync_timer >= timeSyncInterval() && remainingBudgetMs() > 0) {
+            sync_timer = 0;
+            syncTime();
+          }
+          processMessages();
           break;
         case AGENT_DISCONNECTED:
           destroyEntities();
           state = WAITING_AGENT;
+          ping_interval_ms = ROS_PING_BACKOFF_MIN_MS;
           break;
         default:
           break;
       }
-      DEBUG_PRINT("ROS STATE: ");
-      DEBUG_PRINT_LN(state);
+      
+      if (state != previous_state) {
+        DEBUG_PRINT("ROS STATE: ");
+        DEBUG_PRINT_LN(state);
+      }
+}
+
+bool BeaconMicroROSInterface::pingAgent() {
+    uint32_t start_us = micros();
+    bool ok = (RMW_RET_OK == rmw_uros_ping_agent(remainingBudgetMs(), 1));
+    recordBlocking(start_us);
+    return ok;
+}
+
+void BeaconMicroROSInterface::recordBlocking(uint32_t start_us) {
+    uint32_t elapsed_us = micros() - start_us;
+    blocking_stats.calls++;
+    blocking_stats.total_us += elapsed_us;
+    blocking_stats.last_us = elapsed_us;
+    if (elapsed_us > blocking_stats.max_us) {
+        blocking_stats.max_us = elapsed_us;
+    }
+}
+
+// Restbudget des laufenden update() in ganzen Millisekunden, 0 = aufgebraucht
+uint32_t BeaconMicroROSInterface::remainingBudgetMs() const {
+    uint32_t elapsed_us = micros() - budget_start_us;
+    if (elapsed_us >= ROS_BLOCKING_BUDGET_MS * 1000UL) {
+        return 0;
+    }
+    return (ROS_BLOCKING_BUDGET_MS * 1000UL - elapsed_us) / 1000;
+}
+
+// Zuverlässig senden und höchstens das Restbudget auf die Bestätigung warten.
+// Ist es aufgebraucht, wird nichts gesendet und der Aufrufer versucht es im nächsten update()
+rcl_ret_t BeaconMicroROSInterface::publishReliable(rcl_publisher_t& publisher, const void* message) {
+    uint32_t timeout_ms = remainingBudgetMs();
+    if (timeout_ms == 0) {
+        return RCL_RET_TIMEOUT;
+    }
+    (void) rmw_uros_set_publisher_session_timeout(&publisher, timeout_ms);
+    uint32_t start_us = micros();
+    rcl_ret_t rc = rcl_publish(&publisher, message, NULL);
+    recordBlocking(start_us);
+    return rc;
+}
+
+uint32_t BeaconMicroROSInterface::timeSyncInterval() const {
+    // Solange die Schätzung noch wenige Stützpunkte hat, häufiger synchronisieren
+    if (timeSync->getAgentClock().getSampleCount() < ROS_TIME_SYNC_FAST_SAMPLES) {
+        return ROS_TIME_SYNC_FAST_INTERVAL_MS;
+    }
+    return ROS_TIME_SYNC_INTERVAL_MS;
+}
+
+const BeaconMicroROSInterface::BlockingStats& BeaconMicroROSInterface::getBlockingStats() const {
+    return blocking_stats;
+}
+
+const StaticAllocator& BeaconMicroROSInterface::getArena() const {
+    return arena;
+}
+
+void BeaconMicroROSInterface::resetEntities() {
+    memset(&support, 0, sizeof(support));
+    node = rcl_get_zero_initialized_node();
+    executor = rclc_executor_get_zero_initialized_executor();
+    pub_hatch_is_open = rcl_get_zero_initialized_publisher();
+    pub_hatch_left = rcl_get_zero_initialized_publisher();
+    pub_hatch_right = rcl_get_zero_initialized_publisher();
+    pub_gps = rcl_get_zero_initialized_publisher();
+    pub_diagnostics = rcl_get_zero_initialized_publisher();
+    memset(&action_led_animation, 0, sizeof(action_led_animation));
+    memset(active_goals, 0, sizeof(active_goals));
+}
+
+void BeaconMicroROSInterface::reportArena(const char* label) {
+    DEBUG_PRINT(label);
+    DEBUG_PRINT(" - arena used: ");
+    DEBUG_PRINT(arena.getUsed());
+    DEBUG_PRINT(" peak: ");
+    DEBUG_PRINT(arena.getHighWaterMark());
+    DEBUG_PRINT(" of ");
+    DEBUG_PRINT(arena.getCapacity());
+    DEBUG_PRINT(" failed: ");
+    DEBUG_PRINT_LN(arena.getFailedAllocations());
 }
 
 bool BeaconMicroROSInterface::destroyEntities() {
     DEBUG_PRINT_LN("destroyEntities");
+    uint32_t start_us = micros();
 
     rmw_context_t * rmw_context = rcl_context_get_rmw_context(&support.context);
     (void) rmw_uros_set_context_entity_destroy_session_timeout(rmw_context, 0);
 
     rcl_publisher_fini(&pub_hatch_is_open, &node);
+    rcl_publisher_fini(&pub_hatch_left, &node);
+    rcl_publisher_fini(&pub_hatch_right, &node);
     rcl_publisher_fini(&pub_gps, &node);
- 
-      //RCCHECK(rclc_executor_fini(&executor));
+    rcl_publisher_fini(&pub_diagnostics, &node);
+    rclc_executor_fini(&executor);
+    rclc_action_server_fini(&action_led_animation, &node);
 
     rcl_node_fini(&node);
     rclc_support_fini(&support);
 
-    DEBUG_PRINT_LN("destroyEntities END");
+    // Handles für den nächsten Verbindungsaufbau zurücksetzen, die Nachrichten bleiben erhalten
+    resetEntities();
+
+    // Nach dem Wiederverbinden neu synchronisieren
+    timeSync->resetAgent();
+    recordBlocking(start_us);
+
+    reportArena("destroyEntities END");
 
     return true;
 }
 
-bool BeaconMicroROSInterface::createEntities() {
-    DEBUG_PRINT_LN("createEntities");
-    // Initialize allocator
-    allocator = rcl_get_default_allocator();
-    
-    // Initialize support
-    RCCHECK(rclc_support_init(&support, 0, NULL, &allocator));
-    
-    // Create node
-    RCCHECK(rclc_node_init_default(&node, "beacon_node", "", &support));
-    
-    // Create hatch publishers
-    RCCHECK(rclc_publisher_init_default(
-        &pub_hatch_is_open,
-        &node,
-        ROSIDL_GET_MSG_TYPE_SUPPORT(std_msgs, msg, Bool),
-        ROS_NAMESPACE TOPIC_HATCH_STATUS
-    ));
-    // Create gps publishers
-    RCCHECK(rclc_publisher_init_default(
-        &pub_gps,
-        &node,
-        ROSIDL_GET_MSG_TYPE_SUPPORT(sensor_msgs, msg, NavSatFix),
-        ROS_NAMESPACE TOPIC_GPS
-    ));
-    
-    // Create executor
-    //executor = rclc_executor_get_zero_initialized_executor();
-    //RCCHECK(rclc_executor_init(&executor, &support.context, 1, &allocator));
-    DEBUG_PRINT_LN("createEntities END");
-   
+rcl_ret_t BeaconMicroROSInterface::createPublisher(rcl_publisher_t& publisher, const rosidl_message_type_support_t* type_support,
+                                                   const char* topic_name) {
+    rcl_ret_t rc = rclc_publisher_init_default(&publisher, &node, type_support, topic_name);
+    if (rc == RCL_RET_OK) {
+        // Zuverlässiges Senden wartet auf die Bestätigung des Agenten, publishReliable() kürzt auf das Restbudget
+        (void) rmw_uros_set_publisher_session_timeout(&publisher, ROS_BLOCKING_BUDGET_MS);
+    }
+    return rc;
+}
+
+bool BeaconMicroROSInterface::createNextEntity() {
+    switch (create_step) {
+        case 0: {
+            DEBUG_PRINT_LN("createEntities");
+            allocator = rcl_get_default_allocator();
+            // Sitzungsaufbau, die Wartezeit legt rmw_microxrcedds fest (siehe config.h)
+            RCCHECK(rclc_support_init(&support, 0, NULL, &allocator));
+            rmw_context_t * rmw_context = rcl_context_get_rmw_context(&support.context);
+            (void) rmw_uros_set_context_entity_creation_session_timeout(rmw_context, ROS_BLOCKING_BUDGET_MS);
+            break;
+        }
+        case 1:
+            RCCHECK(rclc_node_init_default(&node, "beacon_node", "", &support));
+            break;
+        case 2:
+            RCCHECK(createPublisher(pub_hatch_is_open, ROSIDL_GET_MSG_TYPE_SUPPORT(std_msgs, msg, Bool),
+                                    ROS_NAMESPACE TOPIC_HATCH_STATUS));
+            break;
+        case 3:
+            RCCHECK(createPublisher(pub_hatch_left, ROSIDL_GET_MSG_TYPE_SUPPORT(std_msgs, msg, Bool),
+                                    ROS_NAMESPACE TOPIC_HATCH_LEFT));
+            break;
+        case 4:
+            RCCHECK(createPublisher(pub_hatch_right, ROSIDL_GET_MSG_TYPE_SUPPORT(std_msgs, msg, Bool),
+                                    ROS_NAMESPACE TOPIC_HATCH_RIGHT));
+            break;
+        case 5:
+            RCCHECK(createPublisher(pub_gps, ROSIDL_GET_MSG_TYPE_SUPPORT(sensor_msgs, msg, NavSatFix),
+                                    ROS_NAMESPACE TOPIC_GPS));
+            break;
+        case 6:
+            RCCHECK(createPublisher(pub_diagnostics, ROSIDL_GET_MSG_TYPE_SUPPORT(diagnostic_msgs, msg, DiagnosticArray),
+                                    TOPIC_DIAGNOSTICS));
+            break;
+        case 7:
+            // LED animation action server
+            RCCHECK(rclc_action_server_init_default(
+                &action_led_animation,
+                &node,
+                &support,
+                ROSIDL_GET_ACTION_TYPE_SUPPORT(beacon_interfaces, LEDAnimation),
+                ROS_NAMESPACE ACTION_LED_ANIMATION
+            ));
+            break;
+        case 8:
+            // Executor, rein lokal ohne Anfrage an den Agenten
+            executor = rclc_executor_get_zero_initialized_executor();
+            RCCHECK(rclc_executor_init(&executor, &support.context, 1, &allocator));
+            // Ziel-Nachrichten liegen in goal_requests, rclc legt pro Ziel nichts auf dem Heap an
+            RCCHECK(rclc_executor_add_action_server(
+                &executor,
+                &action_led_animation,
+                LED_ANIMATION_GOAL_HANDLES,
+                goal_requests,
+                sizeof(goal_requests[0]),
+                onAnimationGoal,
+                onAnimationCancel,
+                this
+            ));
+            memset(active_goals, 0, sizeof(active_goals));
+            reportArena("createEntities END");
+            break;
+        default:
+            return false;
+    }
+    create_step++;
     return true;
 }
 
 
 
+void BeaconMicroROSInterface::syncTime() {
+    uint64_t start_us = timeSync->nowMicros();
+    rmw_ret_t ret = rmw_uros_sync_session(remainingBudgetMs());
+    recordBlocking((uint32_t)start_us);
+    if (ret != RMW_RET_OK) {
+        return;
+    }
+    // Lokale Zeit und Agentenzeit direkt nacheinander erfassen
+    uint64_t local_us = timeSync->nowMicros();
+    int64_t agent_ns = rmw_uros_epoch_nanos();
+    timeSync->addAgentSample(local_us, agent_ns, (uint32_t)(local_us - start_us));
+}
+
+void BeaconMicroROSInterface::setStamp(builtin_interfaces__msg__Time& stamp, int64_t time_ns) {
+    stamp.sec = int32_t(time_ns / 1000000000LL);
+    stamp.nanosec = uint32_t(time_ns % 1000000000LL);
+}
+
+void BeaconMicroROSInterface::setString(rosidl_runtime_c__String& string, char* buffer, size_t capacity) {
+    string.data = buffer;
+    string.size = strlen(buffer);
+    string.capacity = capacity;
+}
+
+// Histogramm als Kommaliste, ab der letzten besetzten Klasse abgeschnitten
+static void formatHistogram(char* buffer, size_t size, const LatencyHistogram& histogram) {
+    uint8_t used = 0;
+    for (uint8_t b = 0; b < LatencyHistogram::BUCKETS; b++) {
+        if (histogram.getCount(b) > 0) {
+            used = b + 1;
+        }
+    }
+    size_t length = 0;
+    buffer[0] = '\0';
+    for (uint8_t b = 0; b < used && length < size; b++) {
+        length += snprintf(buffer + length, size - length, b == 0 ? "%lu" : ",%lu",
+                           (unsigned long)histogram.getCount(b));
+    }
+}
+
 bool BeaconMicroROSInterface::processMessages() {
     if (state != AGENT_CONNECTED) {
         return false;
     }
-    publishGPSData();
+    // Nach Wichtigkeit, was das Budget nicht mehr erlaubt, folgt im nächsten Aufruf
     publishHatchStatus();
+    publishGPSData();
+    publishDiagnostics();
 
     // Verarbeite MicroROS-Nachrichten
-    return (rclc_executor_spin_some(&executor, RCL_MS_TO_NS(1)) == RCL_RET_OK);
+    if (remainingBudgetMs() == 0) {
+        return false;
+    }
+    bool ok = (rclc_executor_spin_some(&executor, RCL_MS_TO_NS(1)) == RCL_RET_OK);
+    publishAnimationFeedback();
+    return ok;
+}
+
+bool BeaconMicroROSInterface::publishAnimationFeedback() {
+    // Feedback und Ergebnis senden über die Publisher von rclc, deren Wartezeit nicht einstellbar ist
+    if ((state != AGENT_CONNECTED) || remainingBudgetMs() == 0) {
+        return false;
+    }
+    
+    // Jede Ebene meldet ihr eigenes Ziel, die anderen laufen unabhängig davon weiter
+    bool feedbackDue = last_publish_feedback >= LED_ANIMATION_FEEDBACK_RATE_MS;
+    bool published = false;
+    for (uint8_t layer = 0; layer < LED_LAYER_COUNT; layer++) {
+        if (active_goals[layer] == nullptr) {
+            continue;
+        }
+        
+        // Endzustand der Animation als Ergebnis melden
+        AnimationStatus status = ledController->getStatus(layer);
+        if (status == STATUS_COMPLETED) {
+            finishAnimationGoal(layer, GOAL_STATE_SUCCEEDED, status);
+            published = true;
+            continue;
+        }
+        if (status == STATUS_CANCELED) {
+            finishAnimationGoal(layer, GOAL_STATE_CANCELED, status);
+            published = true;
+            continue;
+        }
+        
+        if (!feedbackDue) {
+            continue;
+        }
+        msg_animation_feedback.feedback.progress = animation_progress[layer];
+        msg_animation_feedback.feedback.status = animation_status[layer];
+        RCCHECK(rclc_action_publish_feedback(active_goals[layer], &msg_animation_feedback));
+        published = true;
+    }
+    if (feedbackDue) {
+        last_publish_feedback = 0;
+    }
+    
+    return published;
+}
+
+void BeaconMicroROSInterface::finishAnimationGoal(uint8_t layer, rcl_action_goal_state_t goal_state, AnimationStatus final_status) {
+    // Ergebnis im Platz des Goal-Handles, gleicher Index wie seine Ziel-Nachricht in goal_requests
+    rclc_action_goal_handle_t* goal = active_goals[layer];
+    size_t slot = static_cast<beacon_interfaces__action__LEDAnimation_SendGoal_Request*>(goal->ros_goal_request) - goal_requests;
+    beacon_interfaces__action__LEDAnimation_GetResult_Response& result = goal_results[slot];
+    result.result.success = (goal_state == GOAL_STATE_SUCCEEDED);
+    result.result.final_status = final_status;
+    rclc_action_send_result(goal, goal_state, &result);
+    active_goals[layer] = nullptr;
+}
+
+rcl_ret_t BeaconMicroROSInterface::onAnimationGoal(rclc_action_goal_handle_t* goal_handle, void* context) {
+    BeaconMicroROSInterface* self = static_cast<BeaconMicroROSInterface*>(context);
+    beacon_interfaces__action__LEDAnimation_SendGoal_Request* request =
+        static_cast<beacon_interfaces__action__LEDAnimation_SendGoal_Request*>(goal_handle->ros_goal_request);
+    
+    // startAnimation() meldet über den Result-Callback, ob der Befehl unterstützt wird
+    uint8_t* params = request->goal.params;
+    self->animation_accepted = false;
+    self->ledController->startAnimation(params[PARAM_CMD], params);
+    if (!self->animation_accepted) {
+        return RCL_RET_ACTION_GOAL_REJECTED;
+    }
+    
+    // Nur das laufende Ziel derselben Ebene wird ersetzt, ein bereits abgebrochenes bleibt CANCELED
+    uint8_t layer = LEDAnimationController::layerOf(params);
+    rclc_action_goal_handle_t* replaced = self->active_goals[layer];
+    if (replaced != nullptr) {
+        self->finishAnimationGoal(layer, replaced->status == GOAL_STATE_CANCELING ? GOAL_STATE_CANCELED : GOAL_STATE_ABORTED,
+                                  STATUS_CANCELED);
+    }
+    self->active_goals[layer] = goal_handle;
+    self->animation_progress[layer] = 0.0f;
+    self->animation_status[layer] = STATUS_STARTED;
+    self->last_publish_feedback = 0;
+    return RCL_RET_ACTION_GOAL_ACCEPTED;
+}
+
+bool BeaconMicroROSInterface::onAnimationCancel(rclc_action_goal_handle_t* goal_handle, void* context) {
+    BeaconMicroROSInterface* self = static_cast<BeaconMicroROSInterface*>(context);
+    for (uint8_t layer = 0; layer < LED_LAYER_COUNT; layer++) {
+        if (goal_handle == self->active_goals[layer]) {
+            // Das Ergebnis CANCELED wird in publishAnimationFeedback() gesendet
+            return self->ledController->cancelAnimation(layer);
+        }
+    }
+    return false;
+}
+
+void BeaconMicroROSInterface::onAnimationFeedback(uint8_t layer, float progress, AnimationStatus status) {
+    if (instance == nullptr || layer >= LED_LAYER_COUNT) {
+        return;
+    }
+    instance->animation_progress[layer] = progress;
+    instance->animation_status[layer] = status;
+}
+
+void BeaconMicroROSInterface::onAnimationResult(uint8_t layer, bool success, AnimationStatus finalStatus) {
+    if (instance == nullptr) {
+        return;
+    }
+    instance->animation_accepted = success;
 }
 
 bool BeaconMicroROSInterface::publishHatchStatus() {
-    if ((state != AGENT_CONNECTED) || last_publish_hatch < HATCH_PUBLISH_RATE_MS) {
+    if (state != AGENT_CONNECTED) {
         return false;
     }
+#if HATCH_PUBLISH_ON_CHANGE
+    // Sofort bei jedem Wechsel, sonst nur als Heartbeat
+    uint32_t sequence = hatchManager->getChangeSequence();
+    if (sequence == last_hatch_sequence && last_publish_hatch < HATCH_HEARTBEAT_MS) {
+        return false;
+    }
+#else
+    if (last_publish_hatch < HATCH_PUBLISH_RATE_MS) {
+        return false;
+    }
+    uint32_t sequence = hatchManager->getChangeSequence();
+#endif
     
     msg_hatch_is_open.data = hatchManager->isHatchOpen();
-    RCCHECK(rcl_publish(&pub_hatch_is_open, &msg_hatch_is_open, NULL));
+    msg_hatch_left.data = hatchManager->isHatchOpen(HatchManager::HATCH_LEFT);
+    msg_hatch_right.data = hatchManager->isHatchOpen(HatchManager::HATCH_RIGHT);
+    RCCHECK(publishReliable(pub_hatch_is_open, &msg_hatch_is_open));
+    RCCHECK(publishReliable(pub_hatch_left, &msg_hatch_left));
+    RCCHECK(publishReliable(pub_hatch_right, &msg_hatch_right));
     last_publish_hatch = 0;
+    last_hatch_sequence = sequence;
     
     return true;
 }
 
 bool BeaconMicroROSInterface::publishGPSData() {
-    if ((state != AGENT_CONNECTED) || last_publish_gps < GPS_PUBLISH_RATE_MS) {
+    if (state != AGENT_CONNECTED) {
         return false;
     }
-    
-    msg_gps.header.stamp.sec  = int32_t( time_ms/1000);
-    msg_gps.header.stamp.nanosec  = int32_t( time_ms % 1000)*1000;
+#if GPS_PUBLISH_ON_NEW_FIX
+    // Genau einmal pro neuer Epoche senden
+    uint32_t sequence = gpsManager->getFixSequence();
+    if (sequence == last_gps_sequence) {
+        return false;
+    }
+#else
+    if (last_publish_gps < GPS_PUBLISH_RATE_MS) {
+        return false;
+    }
+#endif
 
     const NavSatFixData& navsat_data = gpsManager->getNavSatFixData();
     
+    // Zeitstempel = Gültigkeitszeitpunkt der Lösung in Agentenzeit
+    int64_t utc_ns = navsat_data.getUnixTimeNanos();
+    uint64_t validity_us = timeSync->timeOfValidity(utc_ns, gpsManager->getEpochArrivalMicros());
+    if (timeSync->isAgentSynchronized()) {
+        setStamp(msg_gps.header.stamp, timeSync->toAgentNanos(validity_us));
+    } else if (utc_ns > 0) {
+        setStamp(msg_gps.header.stamp, utc_ns);
+    } else {
+        setStamp(msg_gps.header.stamp, rmw_uros_epoch_nanos());
+    }
+    
     // Kopiere die Daten in die ROS-Nachricht
     msg_gps.status.status = navsat_data.status;
-    msg_gps.status.service = 1;  // GPS = 1 in ROS2 NavSatFix
+    msg_gps.status.service = navsat_data.service;
     
     msg_gps.latitude = navsat_data.latitude;
     msg_gps.longitude = navsat_data.longitude;
@@ -170,14 +603,68 @@ bool BeaconMicroROSInterface::publishGPSData() {
     }
     msg_gps.position_covariance_type = navsat_data.position_covariance_type;
     
-    RCCHECK(rcl_publish(&pub_gps, &msg_gps, NULL));
+    RCCHECK(publishReliable(pub_gps, &msg_gps));
     last_publish_gps = 0;
+#if GPS_PUBLISH_ON_NEW_FIX
+    last_gps_sequence = sequence;
+#endif
     
     return true;
 }
 
+bool BeaconMicroROSInterface::publishDiagnostics() {
+    if ((state != AGENT_CONNECTED) || scheduler == nullptr || scheduler->getTaskCount() == 0) {
+        return false;
+    }
+    // Ohne Restbudget nicht zum nächsten Task weiterschalten
+    if (last_publish_diagnostics < DIAGNOSTICS_PUBLISH_RATE_MS || remainingBudgetMs() == 0) {
+        return false;
+    }
+    last_publish_diagnostics = 0;
+
+    // Reihum ein Task pro Nachricht, damit eine Nachricht in ein XRCE-Paket passt
+    uint8_t task = diagnostics_task;
+    diagnostics_task = (uint8_t)((task + 1) % scheduler->getTaskCount());
+    const TaskScheduler::TaskStats& stats = scheduler->getStats(task);
+
+    // WARN, solange seit der letzten Meldung Overruns oder verpasste Deadlines dazukamen
+    uint32_t faults = stats.overruns + stats.missedDeadlines;
+    diagnostics_status.level = (faults != diagnostics_faults[task]) ? diagnostic_msgs__msg__DiagnosticStatus__WARN
+                                                                    : diagnostic_msgs__msg__DiagnosticStatus__OK;
+    diagnostics_faults[task] = faults;
+    snprintf(diagnostics_name, sizeof(diagnostics_name), "beacon: %s", scheduler->getTaskName(task));
+    snprintf(diagnostics_message, sizeof(diagnostics_message), "overruns %lu missed %lu",
+             (unsigned long)stats.overruns, (unsigned long)stats.missedDeadlines);
+
+    uint64_t avg_cycles = stats.runs > 0 ? stats.total_cycles / stats.runs : 0;
+    snprintf(diagnostics_text[0], DIAGNOSTICS_VALUE_LENGTH, "%lu", (unsigned long)stats.runs);
+    snprintf(diagnostics_text[1], DIAGNOSTICS_VALUE_LENGTH, "%lu", (unsigned long)CycleCounter::toMicros((uint32_t)avg_cycles));
+    snprintf(diagnostics_text[2], DIAGNOSTICS_VALUE_LENGTH, "%lu", (unsigned long)CycleCounter::toMicros(stats.max_cycles));
+    snprintf(diagnostics_text[3], DIAGNOSTICS_VALUE_LENGTH, "%lu", (unsigned long)stats.maxLatency_us);
+    formatHistogram(diagnostics_text[4], DIAGNOSTICS_VALUE_LENGTH, stats.execution);
+    formatHistogram(diagnostics_text[5], DIAGNOSTICS_VALUE_LENGTH, stats.latency);
+
+    diagnostics_status.name.size = strlen(diagnostics_name);
+    diagnostics_status.message.size = strlen(diagnostics_message);
+    for (uint8_t i = 0; i < DIAGNOSTICS_VALUES; i++) {
+        diagnostics_values[i].value.size = strlen(diagnostics_text[i]);
+    }
+
+    if (timeSync->isAgentSynchronized()) {
+        setStamp(msg_diagnostics.header.stamp, timeSync->toAgentNanos(timeSync->nowMicros()));
+    } else {
+        setStamp(msg_diagnostics.header.stamp, rmw_uros_epoch_nanos());
+    }
+    RCCHECK(publishReliable(pub_diagnostics, &msg_diagnostics));
+    return true;
+}
+
 BeaconMicroROSInterface::states BeaconMicroROSInterface::getConnectionState() {
     return state  ;
 }
 
+bool BeaconMicroROSInterface::isLinkDegraded() const {
+    return state == AGENT_CONNECTED && ping_failures > 0;
+}
+
 
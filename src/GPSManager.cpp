@@ -1,7 +1,65 @@
 #include "GPSManager.h"
 
+// Zusätzlicher Empfangsspeicher für den UART-Treiber des Cores
+static uint8_t gps_serial_rx_extra[GPS_SERIAL_RX_EXTRA_BYTES];
+
+GPSManager* GPSManager::ingestInstance = nullptr;
+
+namespace {
+
+// UBX-Nutzdaten sind little-endian
+inline void writeU2(uint8_t* p, uint16_t value) {
+    p[0] = value & 0xFF;
+    p[1] = value >> 8;
+}
+
+inline void writeU4(uint8_t* p, uint32_t value) {
+    p[0] = value & 0xFF;
+    p[1] = (value >> 8) & 0xFF;
+    p[2] = (value >> 16) & 0xFF;
+    p[3] = value >> 24;
+}
+
+// Abstand zweier Tageszeiten in ms, über Mitternacht hinweg
+uint32_t timeOfDayDistance(uint32_t a_ms, uint32_t b_ms) {
+    const uint32_t day_ms = 86400000UL;
+    uint32_t d = (a_ms > b_ms) ? a_ms - b_ms : b_ms - a_ms;
+    return (d > day_ms / 2) ? day_ms - d : d;
+}
+
+uint16_t serviceFromNMEA(uint8_t systems) {
+    uint16_t service = 0;
+    // QZSS sendet GPS-kompatible Signale
+    if (systems & (NMEA_SYSTEM_GPS | NMEA_SYSTEM_QZSS)) service |= NavSatFixData::SERVICE_GPS;
+    if (systems & NMEA_SYSTEM_GLONASS) service |= NavSatFixData::SERVICE_GLONASS;
+    if (systems & NMEA_SYSTEM_BEIDOU) service |= NavSatFixData::SERVICE_COMPASS;
+    if (systems & NMEA_SYSTEM_GALILEO) service |= NavSatFixData::SERVICE_GALILEO;
+    return service;
+}
+
+// gnssId aus NAV-SAT: 0 GPS, 1 SBAS, 2 Galileo, 3 BeiDou, 5 QZSS, 6 GLONASS
+uint16_t serviceFromUBX(uint8_t gnssMask) {
+    uint16_t service = 0;
+    if (gnssMask & ((1 << 0) | (1 << 5))) service |= NavSatFixData::SERVICE_GPS;
+    if (gnssMask & (1 << 6)) service |= NavSatFixData::SERVICE_GLONASS;
+    if (gnssMask & (1 << 3)) service |= NavSatFixData::SERVICE_COMPASS;
+    if (gnssMask & (1 << 2)) service |= NavSatFixData::SERVICE_GALILEO;
+    return service;
+}
+
+}  // namespace
+
 GPSManager::GPSManager()
-    : gpsSerial(nullptr)
+    : fixValid(false)
+    , fixSequence(0)
+    , lastEpochTime(0xFFFFFFFF)
+    , epochArrivalMicros(0)
+    , epochPPS{0, 0}
+    , newFixCallback(nullptr)
+    , gpsSerial(nullptr)
+    , ingestBytes(0)
+    , lastByteMicros(0)
+    , currentBurst{0, 0, {0, 0}}
     , last_serial_check(0)
     , serial_bytes_received(0)
     , last_serial_bytes_count(0)
@@ -11,6 +69,7 @@ GPSManager::GPSManager()
 void GPSManager::begin(HardwareSerial& serial, unsigned long baud) {
     gpsSerial = &serial;
     gpsSerial->begin(baud);
+    gpsSerial->addMemoryForRead(gps_serial_rx_extra, sizeof(gps_serial_rx_extra));
     
     // Warte kurz und prüfe dann, ob Daten empfangen werden
     unsigned long start_time = millis();
@@ -25,20 +84,82 @@ void GPSManager::begin(HardwareSerial& serial, unsigned long baud) {
             break;
         }
     }
+    
+#if GPS_USE_UBX
+    // Auf UBX-Binärausgabe mit höherer Messrate umstellen
+    configureUBX();
+#endif
+}
+
+void GPSManager::start() {
+    // Bis hierher aufgelaufene Daten sind veraltet und würden als Block
+    // verarbeitet, die erste Epoche beginnt mit dem nächsten Burst
+    while (gpsSerial->available()) {
+        gpsSerial->read();
+    }
+    lastByteMicros = micros();
+    
+    // Ab hier liest nur noch die ISR von der seriellen Schnittstelle
+    ingestInstance = this;
+    ingestTimer.begin(ingestISR, GPS_INGEST_POLL_US);
+}
+
+void GPSManager::ingestISR() {
+    // Läuft im Interrupt-Kontext: UART-Puffer des Cores in den Ringpuffer leeren,
+    // damit auch bei langen Blockaden von loop() kein Byte verloren geht
+    GPSManager* self = ingestInstance;
+    if (self == nullptr || self->gpsSerial == nullptr) {
+        return;
+    }
+    int available = self->gpsSerial->available();
+    if (available <= 0) {
+        return;
+    }
+    
+    // Beginn eines neuen Epochen-Bursts zeitlich erfassen, korrigiert um die
+    // bereits im UART-Puffer wartenden Bytes (10 Bit pro Byte). Die PPS-Flanke
+    // wird mit erfasst, update() kann den Burst auch Sekunden später zuordnen
+    uint32_t now = micros();
+    if (now - self->lastByteMicros > GPS_BURST_GAP_US) {
+        IngestBurst burst;
+        burst.firstByte = self->ingestBytes;
+        burst.startMicros = now - (uint32_t)available * (10000000UL / GPS_BAUD);
+        burst.pps = TimeSync::latchPPS();
+        self->burstQueue.push(burst);
+    }
+    self->lastByteMicros = now;
+    
+    while (self->gpsSerial->available()) {
+        if (self->ingestBuffer.push((uint8_t)self->gpsSerial->read())) {
+            self->ingestBytes++;
+        }
+    }
 }
 
 void GPSManager::update() {
-    // Lese GPS-Daten
-    while (gpsSerial && gpsSerial->available()) {
-        char c = gpsSerial->read();
-        //handleNMEASentence(c);
-        // Verarbeite das Zeichen mit TinyGPSPlus
-        if (gps.encode(c)) {
-            // Neue Daten wurden verarbeitet
-            updateNavSatFixData();
+    // Sätze direkt im Ringpuffer suchen, ohne Zwischenkopie. Jeder Burst wird
+    // für sich verarbeitet, damit auch nach einer Blockade jede Epoche ihren
+    // eigenen Empfangsbeginn und ihre eigene PPS-Flanke bekommt
+    const uint8_t* data;
+    uint32_t count;
+    while ((count = ingestBuffer.peekContiguous(data)) > 0) {
+        // serial_bytes_received ist die laufende Nummer des nächsten Bytes
+        IngestBurst burst;
+        while (burstQueue.peek(burst) && (int32_t)(burst.firstByte - serial_bytes_received) <= 0) {
+            burstQueue.pop(currentBurst);
+        }
+        if (burstQueue.peek(burst) && burst.firstByte - serial_bytes_received < count) {
+            count = burst.firstByte - serial_bytes_received;
         }
         
-        serial_bytes_received++;
+        uint8_t parsed = nmea.feed(data, count);
+        uint8_t ubxParsed = 0;
+#if GPS_USE_UBX
+        ubxParsed = ubx.feed(data, count);
+#endif
+        ingestBuffer.consume(count);
+        serial_bytes_received += count;
+        updateEpoch(parsed, ubxParsed);
     }
     
     // Prüfe alle x Millisekunden, ob Daten empfangen werden
@@ -48,78 +169,259 @@ void GPSManager::update() {
     }
 }
 
+void GPSManager::updateEpoch(uint8_t parsed, uint8_t ubxParsed) {
+    if (ubxParsed & UBXParser::MESSAGE_NAV_PVT) {
+        // NAV-PVT hat Vorrang vor NMEA, eine Nachricht = eine Epoche
+        updateNavSatFixFromPVT();
+        commitEpoch(ubx.getSolution().iTOW);
+    } else if (parsed != 0) {
+        // Neue Daten wurden verarbeitet
+        updateNavSatFixData();
+        
+        // GGA kommt bei u-blox nach RMC und schließt die Epoche ab
+        const NMEAFix& fix = nmea.getFix();
+        if ((parsed & NMEAParser::SENTENCE_GGA) && fix.timeValid) {
+            commitEpoch(fix.timeOfDay_ms());
+        }
+    }
+}
+
 bool GPSManager::hasValidFix() const {
-    return gps.location.isValid();
+    return fixValid;
 }
 
 const NavSatFixData& GPSManager::getNavSatFixData() const {
     return navSatData;
 }
 
+uint32_t GPSManager::getFixSequence() const {
+    return fixSequence;
+}
+
+uint32_t GPSManager::getEpochArrivalMicros() const {
+    return epochArrivalMicros;
+}
+
+const TimeSync::PPSEdge& GPSManager::getEpochPPS() const {
+    return epochPPS;
+}
+
+void GPSManager::setNewFixCallback(NewFixCallback callback) {
+    newFixCallback = callback;
+}
+
+void GPSManager::commitEpoch(uint32_t epochTime) {
+    // Dieselbe Epoche nicht doppelt melden
+    if (epochTime == lastEpochTime) {
+        return;
+    }
+    lastEpochTime = epochTime;
+    epochArrivalMicros = currentBurst.startMicros;
+    epochPPS = currentBurst.pps;
+    fixSequence++;
+    
+    if (newFixCallback != nullptr) {
+        newFixCallback(navSatData, fixSequence);
+    }
+}
+
+uint32_t GPSManager::getIngestOverflowCount() const {
+    return ingestBuffer.getOverflowCount();
+}
+
+uint32_t GPSManager::getIngestHighWaterMark() const {
+    return ingestBuffer.getHighWaterMark();
+}
+
+uint32_t GPSManager::getBytesReceived() const {
+    return serial_bytes_received;
+}
+
+uint32_t GPSManager::getChecksumErrorCount() const {
+    return nmea.getChecksumErrorCount() + ubx.getChecksumErrorCount();
+}
+
 void GPSManager::updateNavSatFixData() {
-    // Status setzen
-    if (gps.location.isValid()) {
-        navSatData.status = NavSatFixData::STATUS_FIX;
-    } else {
+    const NMEAFix& fix = nmea.getFix();
+    fixValid = fix.positionValid;
+    
+    // Status aus der GGA-Fix-Qualität, Systeme aus der letzten GSA-Gruppe
+    if (!fix.positionValid) {
         navSatData.status = NavSatFixData::STATUS_NO_FIX;
+    } else if (fix.fixQuality == 2) {
+        navSatData.status = NavSatFixData::STATUS_SBAS_FIX;
+    } else if (fix.fixQuality == 4 || fix.fixQuality == 5) {
+        navSatData.status = NavSatFixData::STATUS_GBAS_FIX;
+    } else {
+        navSatData.status = NavSatFixData::STATUS_FIX;
     }
+    navSatData.service = serviceFromNMEA(fix.systemsUsed);
     
-    // Positionsdaten
-    if (gps.location.isValid()) {
-        navSatData.latitude = gps.location.lat();
-        navSatData.longitude = gps.location.lng();
+    // Positionsdaten (Festkomma -> Grad)
+    if (fix.positionValid) {
+        navSatData.latitude = fix.latitude_e7 * 1e-7;
+        navSatData.longitude = fix.longitude_e7 * 1e-7;
     }
     
     // Höhe
-    if (gps.altitude.isValid()) {
-        navSatData.altitude = gps.altitude.meters();
+    if (fix.altitudeValid) {
+        navSatData.altitude = fix.altitude_mm * 1e-3;
     }
     
-    // Geschwindigkeit
-    if (gps.speed.isValid()) {
-        navSatData.speed_kmph = gps.speed.kmph();
+    // Geschwindigkeit (1 Knoten = 1.852 km/h)
+    if (fix.speedValid) {
+        navSatData.speed_kmph = fix.speed_mknots * 0.001852f;
     }
     
     // Kurs
-    if (gps.course.isValid()) {
-        navSatData.course_deg = gps.course.deg();
+    if (fix.courseValid) {
+        navSatData.course_deg = fix.course_cdeg * 0.01f;
     }
     
     // Satelliten
-    if (gps.satellites.isValid()) {
-        navSatData.satellites = gps.satellites.value();
+    navSatData.satellites = fix.satellites;
+    
+    // HDOP nur zur Anzeige
+    navSatData.hdop = fix.hdopValid ? fix.hdop_x100 / 100.0f : 0.0f;
+    
+    // Kovarianz bevorzugt aus der GST-Fehlerstatistik derselben Epoche
+    bool errorCurrent = fix.timeValid
+                     && timeOfDayDistance(fix.errorTime_ms, fix.timeOfDay_ms()) <= GPS_NMEA_ERROR_MAX_AGE_MS;
+    if (!fix.positionValid) {
+        navSatData.clearCovariance();
+    } else if (errorCurrent && fix.ellipseValid && fix.stdValid) {
+        navSatData.setCovarianceFromEllipse(fix.stdMajor_mm * 1e-3f, fix.stdMinor_mm * 1e-3f,
+                                            fix.orient_cdeg * 0.01f, fix.stdAlt_mm * 1e-3f);
+    } else if (errorCurrent && fix.stdValid) {
+        navSatData.setCovariance(fix.stdLon_mm * 1e-3f, fix.stdLat_mm * 1e-3f, fix.stdAlt_mm * 1e-3f,
+                                 NavSatFixData::COVARIANCE_TYPE_DIAGONAL_KNOWN);
+    } else if (fix.hdopValid && fix.vdop_x100 > 0) {
+        // DOP aus GSA mal Entfernungsfehler, HDOP verteilt sich auf beide Horizontalachsen
+        float uere = (errorCurrent && fix.rangeRmsValid) ? fix.rangeRms_mm * 1e-3f : GPS_NMEA_UERE_M;
+        float sigma_horizontal = fix.hdop_x100 * 0.01f * uere * (float)M_SQRT1_2;
+        navSatData.setCovariance(sigma_horizontal, sigma_horizontal, fix.vdop_x100 * 0.01f * uere,
+                                 NavSatFixData::COVARIANCE_TYPE_APPROXIMATED);
+    } else {
+        navSatData.clearCovariance();
     }
     
-    // HDOP-Wert für Genauigkeitsberechnung
-    if (gps.hdop.isValid()) {
-        navSatData.hdop = gps.hdop.value() / 100.0; // TinyGPSPlus gibt HDOP in Hundertstel zurück
+    // Zeitstempel
+    navSatData.time_valid = fix.dateValid && fix.timeValid;
+    if (navSatData.time_valid) {
+        navSatData.year = fix.year;
+        navSatData.month = fix.month;
+        navSatData.day = fix.day;
+        navSatData.hour = fix.hour;
+        navSatData.minute = fix.minute;
+        navSatData.second = fix.second;
+        navSatData.nanosecond = fix.millisecond * 1000000L;
+    }
+}
+
+void GPSManager::updateNavSatFixFromPVT() {
+    const UBXNavSolution& pvt = ubx.getSolution();
+    fixValid = pvt.gnssFixOK && pvt.fixType >= 2 && pvt.fixType <= 4;
+    
+    // Status setzen, Systeme aus dem letzten NAV-SAT
+    if (!fixValid) {
+        navSatData.status = NavSatFixData::STATUS_NO_FIX;
     } else {
-        // Wenn HDOP nicht verfügbar ist, verwenden wir einen Standardwert basierend auf der Anzahl der Satelliten
-        float hdop_value = 5.0; // Standardwert
-        
-        if (gps.satellites.isValid()) {
-            // Einfache Schätzung: Je mehr Satelliten, desto besser die Genauigkeit
-            if (gps.satellites.value() >= 10) hdop_value = 1.0;
-            else if (gps.satellites.value() >= 8) hdop_value = 1.5;
-            else if (gps.satellites.value() >= 6) hdop_value = 2.0;
-            else if (gps.satellites.value() >= 4) hdop_value = 3.0;
-        }
-        
-        navSatData.hdop = hdop_value;
+        navSatData.status = pvt.diffSoln ? NavSatFixData::STATUS_SBAS_FIX : NavSatFixData::STATUS_FIX;
     }
+    navSatData.service = serviceFromUBX(pvt.gnssUsedMask);
+    
+    // Position und Höhe über MSL
+    if (fixValid) {
+        navSatData.latitude = pvt.latitude_e7 * 1e-7;
+        navSatData.longitude = pvt.longitude_e7 * 1e-7;
+        navSatData.altitude = pvt.hMSL_mm * 1e-3;
+    }
+    
+    // Geschwindigkeit (mm/s -> km/h) und Kurs
+    navSatData.speed_kmph = pvt.gSpeed_mmps * 0.0036f;
+    navSatData.course_deg = pvt.headMot_e5 * 1e-5f;
     
-    // Kovarianzmatrix aktualisieren
-    navSatData.updateCovariance();
+    navSatData.satellites = pvt.numSV;
+    navSatData.hdop = (pvt.hDOP > 0 ? pvt.hDOP : pvt.pDOP) / 100.0f;
+    
+    // Genauigkeit direkt vom Empfänger, hAcc gilt für beide Horizontalachsen
+    if (fixValid) {
+        navSatData.setCovariance(pvt.hAcc_mm * 1e-3f, pvt.hAcc_mm * 1e-3f, pvt.vAcc_mm * 1e-3f,
+                                 NavSatFixData::COVARIANCE_TYPE_DIAGONAL_KNOWN);
+    } else {
+        navSatData.clearCovariance();
+    }
     
     // Zeitstempel
-    if (gps.date.isValid() && gps.time.isValid()) {
-        navSatData.year = gps.date.year();
-        navSatData.month = gps.date.month();
-        navSatData.day = gps.date.day();
-        navSatData.hour = gps.time.hour();
-        navSatData.minute = gps.time.minute();
-        navSatData.second = gps.time.second();
+    navSatData.time_valid = pvt.dateValid && pvt.timeValid;
+    if (navSatData.time_valid) {
+        navSatData.year = pvt.year;
+        navSatData.month = pvt.month;
+        navSatData.day = pvt.day;
+        navSatData.hour = pvt.hour;
+        navSatData.minute = pvt.minute;
+        navSatData.second = pvt.second;
+        navSatData.nanosecond = pvt.nano;
+    }
+}
+
+bool GPSManager::configureUBX() {
+    bool ok = true;
+    
+    // CFG-PRT: UART1, 8N1, Baudrate beibehalten, Eingang UBX+NMEA, Ausgang nur UBX
+    uint8_t prt[20] = {0};
+    prt[0] = 1;                          // portID = UART1
+    writeU4(prt + 4, 0x000008D0);        // mode: 8 Bit, keine Parität, 1 Stoppbit
+    writeU4(prt + 8, GPS_BAUD);          // baudRate
+    writeU2(prt + 12, 0x0003);           // inProtoMask: UBX + NMEA
+    writeU2(prt + 14, 0x0001);           // outProtoMask: UBX
+    ok &= sendUBX(UBX_CLASS_CFG, UBX_CFG_PRT, prt, sizeof(prt));
+    
+    // CFG-RATE: Messrate, jede Messung eine Lösung, Zeitbezug UTC
+    uint8_t rate[6] = {0};
+    writeU2(rate + 0, GPS_UBX_MEAS_RATE_MS);
+    writeU2(rate + 2, 1);
+    writeU2(rate + 4, 0);
+    ok &= sendUBX(UBX_CLASS_CFG, UBX_CFG_RATE, rate, sizeof(rate));
+    
+    // CFG-MSG: benötigte NAV-Nachrichten auf dem aktuellen Port aktivieren
+    const uint8_t messages[][3] = {
+        { UBX_CLASS_NAV, UBX_NAV_PVT, 1 },
+        { UBX_CLASS_NAV, UBX_NAV_DOP, 1 },
+        { UBX_CLASS_NAV, UBX_NAV_SAT, GPS_UBX_SAT_RATE }
+    };
+    for (const auto& msg : messages) {
+        ok &= sendUBX(UBX_CLASS_CFG, UBX_CFG_MSG, msg, sizeof(msg));
+    }
+    
+    return ok;
+}
+
+bool GPSManager::sendUBX(uint8_t msgClass, uint8_t msgId, const uint8_t* payload, uint16_t length) {
+    uint8_t frame[32];
+    uint16_t frameLength = UBXParser::buildFrame(msgClass, msgId, payload, length, frame, sizeof(frame));
+    if (frameLength == 0) {
+        return false;
+    }
+    ubx.clearAcknowledge();
+    gpsSerial->write(frame, frameLength);
+    gpsSerial->flush();
+    return waitForAck(msgClass, msgId, GPS_UBX_ACK_TIMEOUT_MS);
+}
+
+bool GPSManager::waitForAck(uint8_t msgClass, uint8_t msgId, unsigned long timeout_ms) {
+    // Wird nur aus begin() aufgerufen, bevor die Empfangs-ISR läuft
+    unsigned long start_time = millis();
+    while (millis() - start_time < timeout_ms) {
+        while (gpsSerial->available()) {
+            uint8_t c = gpsSerial->read();
+            ubx.feed(&c, 1);
+            if (ubx.isAcknowledged(msgClass, msgId)) {
+                return true;
+            }
+        }
     }
+    return false;
 }
 
 void GPSManager::checkSerialData() {
@@ -131,29 +433,9 @@ void GPSManager::checkSerialData() {
         navSatData.status = NavSatFixData::STATUS_NO_FIX;
     } else {
         // Daten werden empfangen, aber prüfe ob wir gültige NMEA-Daten bekommen
-        if (gps.charsProcessed() > 0 && !gps.location.isValid()) {
+        if ((nmea.getSentenceCount() > 0 || ubx.getMessageCount() > 0) && !fixValid) {
             // NMEA-Daten werden empfangen, aber noch kein Fix
             navSatData.status = NavSatFixData::STATUS_NO_FIX;
         }
     }
 }
-
-void GPSManager::handleNMEASentence(char c) {
-    // Store character in buffer
-    if (c == '$') {
-      // Start of a new sentence
-      nmea_idx = 0;
-    }
-    
-    if (nmea_idx < sizeof(nmea_buffer) - 1) {
-      nmea_buffer[nmea_idx++] = c;
-    }
-    
-    if (c == '\n') {
-      // End of sentence
-      nmea_buffer[nmea_idx] = '\0';
-      Serial.print("NMEA: ");
-      Serial.print(nmea_buffer);
-      nmea_idx = 0;
-    }
-  }
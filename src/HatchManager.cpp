@@ -1,27 +1,95 @@
 #include "HatchManager.h"
 
+HatchManager* HatchManager::isrInstance = nullptr;
+
 HatchManager::HatchManager(uint8_t leftPin, uint8_t rightPin)
-    : leftPin(leftPin)
-    , rightPin(rightPin)
-    , hatchOpen(false)
+    : hatches{{leftPin, false, 0}, {rightPin, false, 0}}
+    , changeSequence(0)
+    , lastChangeMicros(0)
 {
 }
 
 void HatchManager::begin() {
     // Setze Pins als Eingänge mit Pull-down-Widerständen
-    pinMode(leftPin, INPUT_PULLDOWN);
-    pinMode(rightPin, INPUT_PULLDOWN);
+    uint32_t now = micros();
+    for (uint8_t i = 0; i < HATCH_COUNT; i++) {
+        pinMode(hatches[i].pin, INPUT_PULLDOWN);
+        // HIGH bedeutet offen
+        hatches[i].open = digitalRead(hatches[i].pin) == HIGH;
+        hatches[i].lastChangeMicros = now - HATCH_DEBOUNCE_US;
+    }
+
+    // Flanken per Interrupt erfassen
+    isrInstance = this;
+    attachInterrupt(digitalPinToInterrupt(hatches[HATCH_LEFT].pin), leftISR, CHANGE);
+    attachInterrupt(digitalPinToInterrupt(hatches[HATCH_RIGHT].pin), rightISR, CHANGE);
+}
+
+void HatchManager::pushEdge(Hatch hatch) {
+    HatchManager* self = isrInstance;
+    if (self == nullptr) {
+        return;
+    }
+    EdgeEvent event;
+    event.micros = micros();
+    event.hatch = hatch;
+    event.level = digitalReadFast(self->hatches[hatch].pin);
+    self->events.push(event);
+}
+
+void HatchManager::leftISR() {
+    pushEdge(HATCH_LEFT);
+}
+
+void HatchManager::rightISR() {
+    pushEdge(HATCH_RIGHT);
 }
 
 void HatchManager::update() {
-    // Lese aktuelle Pin-Zustände
-    int currentLeftState = digitalRead(leftPin);
-    int currentRightState = digitalRead(rightPin);
-    
-    // Kombiniere die Zustände: HIGH bedeutet offen
-    hatchOpen = (currentLeftState == HIGH) || (currentRightState == HIGH);
+    // Erfasste Flanken in zeitlicher Reihenfolge auswerten
+    EdgeEvent event;
+    while (events.pop(event)) {
+        applyLevel(Hatch(event.hatch), event.level == HIGH, event.micros);
+    }
+
+    // Nach Ablauf der Sperrzeit den Pegel direkt prüfen, fängt Flanken während
+    // der Sperrzeit und verlorene Ereignisse ab
+    uint32_t now = micros();
+    for (uint8_t i = 0; i < HATCH_COUNT; i++) {
+        if (now - hatches[i].lastChangeMicros >= HATCH_DEBOUNCE_US) {
+            applyLevel(Hatch(i), digitalReadFast(hatches[i].pin) == HIGH, now);
+        }
+    }
+}
+
+void HatchManager::applyLevel(Hatch hatch, bool open, uint32_t timestamp) {
+    HatchState& state = hatches[hatch];
+    // Die erste Flanke gilt sofort, Prellen innerhalb der Sperrzeit wird ignoriert
+    if (open == state.open || timestamp - state.lastChangeMicros < HATCH_DEBOUNCE_US) {
+        return;
+    }
+    state.open = open;
+    state.lastChangeMicros = timestamp;
+    lastChangeMicros = timestamp;
+    changeSequence++;
 }
 
 bool HatchManager::isHatchOpen() const {
-    return hatchOpen;
+    return hatches[HATCH_LEFT].open || hatches[HATCH_RIGHT].open;
+}
+
+bool HatchManager::isHatchOpen(Hatch hatch) const {
+    return hatches[hatch].open;
+}
+
+uint32_t HatchManager::getChangeSequence() const {
+    return changeSequence;
+}
+
+uint32_t HatchManager::getLastChangeMicros() const {
+    return lastChangeMicros;
+}
+
+uint32_t HatchManager::getEventOverflowCount() const {
+    return events.getOverflowCount();
 }
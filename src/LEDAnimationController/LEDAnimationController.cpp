@@ -1,7 +1,10 @@
 #include "LEDAnimationController/LEDAnimationController.h"
-#define USE_WS2812SERIAL
 // Include the Animation header here to resolve the forward declaration
 
+bool AnimationBase::frameDirty = false;
+constexpr AnimationCommandTable AnimationRegistry::commandTable;
+constexpr AnimationFootprint AnimationRegistry::footprint[SLOT_COUNT];
+
 LEDAnimationController::LEDAnimationController() {
     
     // Initialize state
@@ -12,172 +15,219 @@ LEDAnimationController::LEDAnimationController() {
     feedbackCallback = nullptr;
     resultCallback = nullptr;
     
-    // Initialize animation pointers
-    currentAnimation = nullptr;
-
-}
-
-LEDAnimationController::~LEDAnimationController() {
-    
-    // Clean up all animations in the registry
-    for (Animation* anim : animationRegistry) {
-        delete anim;
+    // Layer stack, the base layer below the overlays
+    layers[0] = &baseLayer;
+    for (uint8_t i = 0; i < LED_OVERLAY_LAYERS; i++) {
+        layers[1 + i] = &overlayLayers[i];
     }
-    animationRegistry.clear();
+    // No command has been started yet
+    currentLayer = LED_LAYER_COUNT;
     
-    // Current animation is just a pointer to one in the registry, don't delete it separately
-    currentAnimation = nullptr;
+    // Initialize frame clock
+    frameTimer = 0;
+    frameCount = 0;
+    deferredFrameCount = 0;
+
 }
 
 void LEDAnimationController::begin() {
     // Initialize LED strip
-    FastLED.addLeds<WS2812SERIAL, DATA_PIN, RGB>(leds, context.numLeds);
-    fill_solid(leds, context.numLeds, CRGB::Black);
+    FastLED.addLeds(&ledDriver, leds, NUM_LEDS);
+    fill_solid(leds, NUM_LEDS, CRGB::Black);
     FastLED.show();
-    // Register all animations
-    registerAnimations();
-    UpdateStatus(status,STATUS_IDLE);
-}
-
-void LEDAnimationController::registerAnimations() {
-    // Create and register all animation types
-    ::registerAnimations(animationRegistry, leds,  &context);
-
-    // Initial Setup of all animations... e.g. Animation pre-calculation or filling patternArray etc.
-    for (Animation* anim : animationRegistry) {
-        anim->setup();
+    AnimationBase::clearFrameDirty();
+    // Initial Setup of all animations
+    for (AnimationLayer* layer : layers) {
+        layer->setup();
     }
-    
+    UpdateStatus(status,STATUS_IDLE);
 }
 
 void LEDAnimationController::startAnimation(uint32_t newCommandID, uint8_t* newParams) {
 
     uint8_t paraCpy[NUM_LEDS] = {};
     memcpy(paraCpy, newParams, PARAM_COUNT * sizeof(paraCpy[0]));
+
+    // Select the layer, unknown layers are an error
+    uint8_t layerIndex = layerOf(paraCpy);
+    if (layerIndex >= LED_LAYER_COUNT) {
+        ReportStatus(layerIndex, STATUS_REVOKED);
+        return;
+    }
+    AnimationLayer& layer = *layers[layerIndex];
+    AnimationContext& context = layer.getContext();
+
+    // Find the appropriate animation before touching the context, a revoked
+    // command leaves the running animation and its frame untouched
+    Animation* nextAnimation = layer.find(AnimationCommand(paraCpy[PARAM_CMD]));
+    // No supported Animation has been found --> Report Error
+    if (nextAnimation == nullptr) {       
+        // Trigger callbacks if registered
+        ReportStatus(layerIndex, STATUS_REVOKED);
+        return;
+    }
+    ReportStatus(layerIndex, STATUS_ACCEPTED);
        
-    // Set global brightness
-    FastLED.setBrightness(paraCpy[PARAM_BRIGHTNESS]);
+    // Set global brightness, overlays use it as their opacity
+    if (layerIndex == 0) {
+        FastLED.setBrightness(paraCpy[PARAM_BRIGHTNESS]);
+    }
 
     //Fill the new context
-    //Save old command
-    memcpy(&context.saved, &context.cmd, sizeof(CMD_struct));
+    //Save old command, its frame stays where it is
+    context.saved = context.cmd;
 
     //New command
     context.cmd.Animation = AnimationCommand(paraCpy[PARAM_CMD]);
     context.cmd.Color = CRGB(paraCpy[PARAM_RED],paraCpy[PARAM_GREEN],paraCpy[PARAM_BLUE]);
-    fill_solid(context.cmd.Frame, context.numLeds, context.cmd.Color);
+    context.cmd.Frame = layer.nextFrame();
+    if (context.cmd.Frame != nullptr) {
+        fill_solid(context.cmd.Frame, context.numLeds, context.cmd.Color);
+    }
     context.cmd.speed = paraCpy[PARAM_SPEED] > 0 ? paraCpy[PARAM_SPEED] : 20;
     context.cmd.MultiUseTag1 = paraCpy[PARAM_MULTIUSE1];
     //New command parameter
     context.cmd.para.reversDirection = (paraCpy[PARAM_MODIFIER] & PAR_DIRECTION_REVERSE) != 0;
     context.cmd.para.startFromBlack = (paraCpy[PARAM_MODIFIER] & PAR_START_FROM_BLACK) != 0;
     context.cmd.para.useHue = (paraCpy[PARAM_MODIFIER] & PAR_USE_HSV_COLOR) != 0;
+    context.cmd.para.easeInOut = (paraCpy[PARAM_MODIFIER] & PAR_EASE_IN_OUT) != 0;
+    context.cmd.para.gammaBlend = (paraCpy[PARAM_MODIFIER] & PAR_GAMMA_BLEND) != 0;
 
-     
-    // Find the appropriate animation based on command
-    currentAnimation = nullptr;    
-    for (Animation* anim : animationRegistry) {
-        if (anim->supportsCommand(context.cmd.Animation)) {
-            currentAnimation = anim;         
-            break;
+    // A new overlay starts transparent, a running one is replaced in place
+    if (layerIndex > 0) {
+        if (!layer.isActive()) {
+            layer.clear();
         }
+        layer.setBlend((paraCpy[PARAM_MODIFIER] & PAR_LAYER_OPAQUE) ? LAYER_BLEND_NORMAL : LAYER_BLEND_KEY,
+                       paraCpy[PARAM_BRIGHTNESS]);
     }
-    // No supported Animation has been found --> Report Error
-    if (currentAnimation == nullptr) {       
-        // Trigger callbacks if registered
-        ReportStatus(STATUS_REVOKED);
-        return;
-    }
-    ReportStatus(STATUS_ACCEPTED);
-    
 
-    // Cancel current animation if running
-    if (currentAnimation != nullptr && isAnimationRunning()) {
-        UpdateStatus(status, STATUS_CANCELED);
-        currentAnimation->cancel();
+    // Cancel the animation of this layer if running, the other layers continue
+    if (layer.replace(nextAnimation)) {
+        UpdateStatus(layerIndex, STATUS_CANCELED);
     }
+    currentLayer = layerIndex;
 
-    UpdateStatus(status,STATUS_STARTED);
+    UpdateStatus(layerIndex, STATUS_STARTED);
     
     // Trigger feedback callback if registered
     if (feedbackCallback != nullptr) {
-        feedbackCallback(0.0f, status);
+        feedbackCallback(layerIndex, 0.0f, layer.getStatus());
     }
 }
 
+uint8_t LEDAnimationController::layerOf(const uint8_t* params) {
+    return (params[PARAM_MODIFIER] & (PAR_LAYER_LOW | PAR_LAYER_HIGH)) >> PAR_LAYER_SHIFT;
+}
+
 void LEDAnimationController::update() {
-    // Skip if no animation is running
-    if (currentAnimation == nullptr || 
-        (status != STATUS_RUNNING && status != STATUS_STARTED && status != STATUS_RUNNING_CONTINUOUS)) {
-        return;
+    // Animationen laufen im festen Frame-Takt
+    bool frameTick = frameTimer >= LED_FRAME_INTERVAL_US;
+    if (frameTick) {
+        frameTimer = 0;
+        runAnimation();
     }
     
-    // Transition from STARTED to RUNNING
-    if (status == STATUS_STARTED) {
+    // Wartenden Frame starten, dann den nächsten geänderten Frame kodieren
+    ledDriver.poll();
+    presentFrame(frameTick);
+}
 
-        //Set the running event
-        UpdateStatus(status, (currentAnimation->getType() == ANIMATION_CONTINUOUS) ?  STATUS_RUNNING_CONTINUOUS : STATUS_RUNNING);       
-        currentAnimation->start();
+void LEDAnimationController::composeFrame() {
+    // Base layer first, then the overlays in ascending priority
+    memcpy(leds, layers[0]->getPixels(), sizeof(leds));
+    for (uint8_t i = 1; i < LED_LAYER_COUNT; i++) {
+        layers[i]->drawOver(leds, NUM_LEDS);
+    }
+}
 
-        // Trigger feedback callback if registered
-        if (feedbackCallback != nullptr) {
-            feedbackCallback(currentAnimation->getProgress(), status);
+void LEDAnimationController::presentFrame(bool frameTick) {
+    if (!AnimationBase::isFrameDirty()) {
+        return;
+    }
+    if (ledDriver.isBusy()) {
+        if (frameTick) {
+            deferredFrameCount++;
         }
+        return;
     }
-    
-    // Run the animation
+    composeFrame();
+    FastLED.show();
+    AnimationBase::clearFrameDirty();
+    frameCount++;
+}
+
+void LEDAnimationController::runAnimation() {
+    // Run all layers, overlays do not interrupt the base layer
     uint32_t currentTime = millis();
-    currentAnimation->run(currentTime);
+    for (uint8_t i = 0; i < LED_LAYER_COUNT; i++) {
+        runLayer(i, currentTime);
+    }
+}
+
+void LEDAnimationController::runLayer(uint8_t index, uint32_t currentTime) {
+    AnimationLayer& layer = *layers[index];
+    // Status and feedback of each layer follow its own command
+    bool tracked = layer.isRunning();
+    
+    // Transition from STARTED to RUNNING, the layer starts its animation in this tick
+    if (tracked && layer.getStatus() == STATUS_STARTED) {
+        //Set the running event
+        UpdateStatus(index, (layer.getType() == ANIMATION_CONTINUOUS) ?  STATUS_RUNNING_CONTINUOUS : STATUS_RUNNING);
+    }
+    
+    layer.run(currentTime);
+    
+    if (!tracked) {
+        return;
+    }
     
     // Provide feedback if registered
-    if (feedbackCallback != nullptr && (status == STATUS_RUNNING || status == STATUS_RUNNING_CONTINUOUS)) {
-        feedbackCallback(currentAnimation->getProgress(), status);
+    if (feedbackCallback != nullptr) {
+        feedbackCallback(index, layer.getProgress(), layer.getStatus());
     }
     
-    // Check for animation completion (only for non-continuous animations)
-    if (currentAnimation->isCompleted() && (currentAnimation->getType() != ANIMATION_CONTINUOUS)) {
-        UpdateStatus(status, STATUS_COMPLETED);
+    // Check for animation completion, the layer stops only non-continuous animations
+    if (!layer.isActive()) {
+        UpdateStatus(index, STATUS_COMPLETED);
     }
 }
 
-bool LEDAnimationController::stopCurrentAnimation() {
-    if (currentAnimation == nullptr || !isAnimationRunning()) {
+bool LEDAnimationController::cancelLayer(uint8_t index, bool clear) {
+    if (index >= LED_LAYER_COUNT || !layers[index]->isRunning()) {
         // Trigger result callback if registered
         // Error as there is no running Animation
-        ReportStatus(STATUS_REVOKED);
+        ReportStatus(index, STATUS_REVOKED);
         return false;
     }
 
-    // Force animation to stop
-    currentAnimation->cancel();
-
-    // Turn off all LEDs
-    fill_solid(leds, context.numLeds, CRGB::Black);
-    FastLED.show();
-    UpdateStatus(status, STATUS_CANCELED);
-    ReportStatus(STATUS_ACCEPTED);
-
-    return true;
-
-}
-
-bool LEDAnimationController::cancelCurrentAnimation() {
-    if (currentAnimation == nullptr || !isAnimationRunning()) {
-        // Trigger result callback if registered
-        // Error as there is no running Animation
-        ReportStatus(STATUS_REVOKED);
-        return false;
+    // Force animation to stop, an overlay disappears, the base layer keeps its last frame unless cleared
+    if (clear) {
+        layers[index]->stop();
+    } else {
+        layers[index]->cancel();
     }
-    // Force animation to stop
-    currentAnimation->cancel();   
-    UpdateStatus(status, STATUS_CANCELED);
+    UpdateStatus(index, STATUS_CANCELED);
     
     // Trigger result callback if registered
-    ReportStatus(STATUS_ACCEPTED);
+    ReportStatus(index, STATUS_ACCEPTED);
     
     return true;
 }
 
+bool LEDAnimationController::stopCurrentAnimation() {
+    // Force animation to stop and turn off the LEDs of its layer
+    return cancelLayer(currentLayer < LED_LAYER_COUNT ? currentLayer : 0, true);
+}
+
+bool LEDAnimationController::cancelCurrentAnimation() {
+    return cancelLayer(currentLayer < LED_LAYER_COUNT ? currentLayer : 0, false);
+}
+
+bool LEDAnimationController::cancelAnimation(uint8_t layer) {
+    return cancelLayer(layer, false);
+}
+
 void LEDAnimationController::setEventCallback(AnimationEventCallback callback) {
     eventCallback = callback;
 }
@@ -203,12 +253,35 @@ bool LEDAnimationController::isAnimationComplete() {
     return status == STATUS_COMPLETED;
 }
 
+uint32_t LEDAnimationController::getFrameCount() const {
+    return frameCount;
+}
+
+uint32_t LEDAnimationController::getDeferredFrameCount() const {
+    return deferredFrameCount;
+}
+
+void LEDAnimationController::printAnimationFootprint(Print& out) const {
+    baseLayer.printFootprint(out);
+    overlayLayers[0].printFootprint(out);
+    out.printf("  %-12s %5u B\n", "Basisebene", (unsigned)sizeof(BaseAnimationLayer));
+    out.printf("  %-12s %5u B x %u\n", "Überlagerung", (unsigned)sizeof(OverlayAnimationLayer), (unsigned)LED_OVERLAY_LAYERS);
+}
+
 float LEDAnimationController::getCurrentProgress() const {
-    if (currentAnimation != nullptr) {
-        return currentAnimation->getProgress();
+    if (currentLayer < LED_LAYER_COUNT) {
+        return layers[currentLayer]->getProgress();
     }
     return 0.0f;
 }
+
+AnimationStatus LEDAnimationController::getStatus(uint8_t layer) const {
+    return layer < LED_LAYER_COUNT ? layers[layer]->getStatus() : STATUS_ERROR;
+}
+
+float LEDAnimationController::getProgress(uint8_t layer) const {
+    return layer < LED_LAYER_COUNT ? layers[layer]->getProgress() : 0.0f;
+}
 // Parameter bit manipulation functions
 void LEDAnimationController::setPara(uint8_t &parabyte, ParameterBits parameter) {
     parabyte |= parameter;  // Set the bit using OR operation
@@ -0,0 +1,432 @@
+#include "NMEAParser.h"
+
+// Maximale Anzahl ausgewerteter Felder pro Satz (GSA hat 18 bzw. 19 Felder)
+#define NMEA_MAX_FIELDS 20
+
+namespace {
+
+// Ein Feld zeigt direkt in den Satzpuffer, es wird nichts kopiert
+struct Field {
+    const char* begin;
+    const char* end;
+
+    bool empty() const { return begin == end; }
+};
+
+// Zerlegt den Satzinhalt an den Kommas
+uint8_t splitFields(const char* p, const char* end, Field* fields, uint8_t maxFields) {
+    uint8_t count = 0;
+    const char* start = p;
+    while (count < maxFields) {
+        if (p == end || *p == ',') {
+            fields[count].begin = start;
+            fields[count].end = p;
+            count++;
+            if (p == end) {
+                break;
+            }
+            start = p + 1;
+        }
+        p++;
+    }
+    return count;
+}
+
+uint8_t hexValue(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    return 0xFF;
+}
+
+// Liest eine Dezimalzahl als Festkommawert mit 'decimals' Nachkommastellen.
+// Überzählige Nachkommastellen werden abgeschnitten.
+bool parseFixed(const Field& f, uint8_t decimals, int32_t& out) {
+    const char* p = f.begin;
+    if (p == f.end) {
+        return false;
+    }
+    bool negative = false;
+    if (*p == '-') {
+        negative = true;
+        p++;
+    }
+    int32_t value = 0;
+    bool digits = false;
+    while (p < f.end && *p >= '0' && *p <= '9') {
+        value = value * 10 + (*p - '0');
+        digits = true;
+        p++;
+    }
+    uint8_t frac = 0;
+    if (p < f.end && *p == '.') {
+        p++;
+        while (p < f.end && *p >= '0' && *p <= '9' && frac < decimals) {
+            value = value * 10 + (*p - '0');
+            digits = true;
+            frac++;
+            p++;
+        }
+    }
+    while (frac < decimals) {
+        value *= 10;
+        frac++;
+    }
+    out = negative ? -value : value;
+    return digits;
+}
+
+// Liest "hhmmss.sss"
+bool parseTime(const Field& f, NMEAFix& fix) {
+    if (f.end - f.begin < 6) {
+        return false;
+    }
+    // ".sss" -> Millisekunden
+    int32_t ms;
+    Field frac = { f.begin + 6, f.end };
+    if (!parseFixed(frac, 3, ms)) {
+        ms = 0;
+    }
+    const char* p = f.begin;
+    fix.hour = (p[0] - '0') * 10 + (p[1] - '0');
+    fix.minute = (p[2] - '0') * 10 + (p[3] - '0');
+    fix.second = (p[4] - '0') * 10 + (p[5] - '0');
+    fix.millisecond = (uint16_t)ms;
+    return fix.hour < 24 && fix.minute < 60 && fix.second < 61;
+}
+
+// Liest "ddmmyy"
+bool parseDate(const Field& f, NMEAFix& fix) {
+    if (f.end - f.begin != 6) {
+        return false;
+    }
+    const char* p = f.begin;
+    fix.day = (p[0] - '0') * 10 + (p[1] - '0');
+    fix.month = (p[2] - '0') * 10 + (p[3] - '0');
+    fix.year = 2000 + (p[4] - '0') * 10 + (p[5] - '0');
+    return fix.day >= 1 && fix.day <= 31 && fix.month >= 1 && fix.month <= 12;
+}
+
+// Liest "dddmm.mmmmm" plus Hemisphäre in Grad * 1e7
+bool parseCoordinate(const Field& value, const Field& hemisphere, uint8_t degreeDigits, int32_t& out_e7) {
+    if (value.end - value.begin < degreeDigits + 2 || hemisphere.empty()) {
+        return false;
+    }
+    int32_t degrees = 0;
+    for (uint8_t i = 0; i < degreeDigits; i++) {
+        degrees = degrees * 10 + (value.begin[i] - '0');
+    }
+    // Minuten mit 7 Nachkommastellen: max. 60e7, passt in int32_t
+    int32_t minutes_e7;
+    Field minutes = { value.begin + degreeDigits, value.end };
+    if (!parseFixed(minutes, 7, minutes_e7)) {
+        return false;
+    }
+    int32_t result = degrees * 10000000 + (minutes_e7 + 30) / 60;
+    char h = *hemisphere.begin;
+    out_e7 = (h == 'S' || h == 'W') ? -result : result;
+    return true;
+}
+
+// System-ID ab NMEA 4.10 (letztes GSA-Feld)
+uint8_t systemFromId(int32_t id) {
+    switch (id) {
+        case 1: return NMEA_SYSTEM_GPS;
+        case 2: return NMEA_SYSTEM_GLONASS;
+        case 3: return NMEA_SYSTEM_GALILEO;
+        case 4: return NMEA_SYSTEM_BEIDOU;
+        case 5: return NMEA_SYSTEM_QZSS;
+        default: return 0;
+    }
+}
+
+// Talker-ID, "GN" steht für kombinierte Lösungen und bleibt offen
+uint8_t systemFromTalker(const char* talker) {
+    if (talker[0] == 'G') {
+        switch (talker[1]) {
+            case 'P': return NMEA_SYSTEM_GPS;
+            case 'L': return NMEA_SYSTEM_GLONASS;
+            case 'A': return NMEA_SYSTEM_GALILEO;
+            case 'B': return NMEA_SYSTEM_BEIDOU;
+            case 'Q': return NMEA_SYSTEM_QZSS;
+            default: return 0;
+        }
+    }
+    if (talker[0] == 'B' && talker[1] == 'D') {
+        return NMEA_SYSTEM_BEIDOU;
+    }
+    return 0;
+}
+
+// Satellitennummer nach u-blox NMEA 4.0 (erweitert), SBAS zählt nicht
+uint8_t systemFromSatellite(int32_t sv) {
+    if (sv >= 1 && sv <= 32) return NMEA_SYSTEM_GPS;
+    if (sv >= 65 && sv <= 96) return NMEA_SYSTEM_GLONASS;
+    if (sv >= 193 && sv <= 202) return NMEA_SYSTEM_QZSS;
+    if (sv >= 301 && sv <= 336) return NMEA_SYSTEM_GALILEO;
+    if (sv >= 401 && sv <= 437) return NMEA_SYSTEM_BEIDOU;
+    return 0;
+}
+
+}  // namespace
+
+NMEAParser::NMEAParser()
+    : sentenceLength(0)
+    , inSentence(false)
+    , sentenceCount(0)
+    , checksumErrors(0)
+    , previousSentence(0)
+    , gsaSystems(0)
+{
+}
+
+const NMEAFix& NMEAParser::getFix() const {
+    return fix;
+}
+
+uint32_t NMEAParser::getSentenceCount() const {
+    return sentenceCount;
+}
+
+uint32_t NMEAParser::getChecksumErrorCount() const {
+    return checksumErrors;
+}
+
+uint8_t NMEAParser::computeChecksum(const char* data, uint32_t length) {
+    // Wortweise XOR-Verknüpfung, anschließend auf ein Byte falten
+    uint32_t acc = 0;
+    while (length >= 4) {
+        uint32_t word;
+        memcpy(&word, data, sizeof(word));
+        acc ^= word;
+        data += 4;
+        length -= 4;
+    }
+    acc ^= acc >> 16;
+    acc ^= acc >> 8;
+    uint8_t sum = (uint8_t)acc;
+    while (length--) {
+        sum ^= (uint8_t)*data++;
+    }
+    return sum;
+}
+
+uint8_t NMEAParser::feed(const uint8_t* data, uint32_t length) {
+    uint8_t parsed = 0;
+    const uint8_t* end = data + length;
+
+    while (data < end) {
+        if (!inSentence) {
+            // Satzanfang suchen
+            const uint8_t* start = (const uint8_t*)memchr(data, '$', end - data);
+            if (start == nullptr) {
+                break;
+            }
+            inSentence = true;
+            sentenceLength = 0;
+            data = start;
+        }
+
+        // Satzende suchen und den Abschnitt am Stück übernehmen
+        const uint8_t* lf = (const uint8_t*)memchr(data, '\n', end - data);
+        const uint8_t* spanEnd = (lf != nullptr) ? lf + 1 : end;
+        uint32_t spanLength = spanEnd - data;
+
+        // Ein neues '$' innerhalb des Abschnitts beginnt einen neuen Satz
+        const uint8_t* restart = (const uint8_t*)memchr(data + (sentenceLength == 0 ? 1 : 0), '$',
+                                                        spanLength - (sentenceLength == 0 ? 1 : 0));
+        if (restart != nullptr) {
+            sentenceLength = 0;
+            data = restart;
+            continue;
+        }
+
+        if (sentenceLength + spanLength > sizeof(sentence)) {
+            // Zu lang - Satz verwerfen
+            inSentence = false;
+            data = spanEnd;
+            continue;
+        }
+        memcpy(sentence + sentenceLength, data, spanLength);
+        sentenceLength += spanLength;
+        data = spanEnd;
+
+        if (lf != nullptr) {
+            inSentence = false;
+            parsed |= parseSentence();
+        }
+    }
+    return parsed;
+}
+
+uint8_t NMEAParser::parseSentence() {
+    // Erwartetes Format: $TTSSS,....*hh\r\n
+    const char* star = (const char*)memchr(sentence, '*', sentenceLength);
+    if (star == nullptr || (star - sentence) < 6 || (sentence + sentenceLength) - star < 3) {
+        checksumErrors++;
+        return 0;
+    }
+    uint8_t hi = hexValue(star[1]);
+    uint8_t lo = hexValue(star[2]);
+    if (hi > 0xF || lo > 0xF) {
+        checksumErrors++;
+        return 0;
+    }
+    const char* body = sentence + 1;
+    if (computeChecksum(body, star - body) != ((hi << 4) | lo)) {
+        checksumErrors++;
+        return 0;
+    }
+    sentenceCount++;
+
+    // Talker-ID (GP, GN, GL, ...) überspringen, nur den Satztyp vergleichen
+    const char* type = body + 2;
+    const char* fields = body + 5;
+    uint8_t parsed = 0;
+    if (*fields != ',') {
+        // Kein gültiger Satzkopf
+    } else if (memcmp(type, "GGA", 3) == 0) {
+        parseGGA(fields + 1, star);
+        parsed = SENTENCE_GGA;
+    } else if (memcmp(type, "RMC", 3) == 0) {
+        parseRMC(fields + 1, star);
+        parsed = SENTENCE_RMC;
+    } else if (memcmp(type, "GSA", 3) == 0) {
+        // Erster GSA-Satz einer Gruppe beginnt eine neue Systemliste
+        if (previousSentence != SENTENCE_GSA) {
+            gsaSystems = 0;
+        }
+        parseGSA(body, fields + 1, star);
+        parsed = SENTENCE_GSA;
+    } else if (memcmp(type, "GST", 3) == 0) {
+        parseGST(fields + 1, star);
+        parsed = SENTENCE_GST;
+    }
+    previousSentence = parsed;
+    return parsed;
+}
+
+void NMEAParser::parseGGA(const char* p, const char* end) {
+    // time,lat,N,lon,E,quality,numSV,HDOP,alt,M,sep,M,diffAge,diffStation
+    Field f[NMEA_MAX_FIELDS];
+    uint8_t n = splitFields(p, end, f, NMEA_MAX_FIELDS);
+    if (n < 10) {
+        return;
+    }
+    fix.timeValid = parseTime(f[0], fix);
+
+    int32_t value;
+    fix.fixQuality = parseFixed(f[5], 0, value) ? (uint8_t)value : 0;
+    fix.satellites = parseFixed(f[6], 0, value) ? (uint8_t)value : 0;
+    fix.hdopValid = parseFixed(f[7], 2, value);
+    if (fix.hdopValid) {
+        fix.hdop_x100 = (uint16_t)value;
+    }
+
+    if (fix.fixQuality == 0) {
+        fix.positionValid = false;
+        return;
+    }
+    fix.positionValid = parseCoordinate(f[1], f[2], 2, fix.latitude_e7)
+                     && parseCoordinate(f[3], f[4], 3, fix.longitude_e7);
+    fix.altitudeValid = parseFixed(f[8], 3, fix.altitude_mm);
+}
+
+void NMEAParser::parseRMC(const char* p, const char* end) {
+    // time,status,lat,N,lon,E,speed,course,date,magVar,magVarEW,mode
+    Field f[NMEA_MAX_FIELDS];
+    uint8_t n = splitFields(p, end, f, NMEA_MAX_FIELDS);
+    if (n < 9) {
+        return;
+    }
+    fix.timeValid = parseTime(f[0], fix);
+    fix.dateValid = parseDate(f[8], fix);
+
+    if (f[1].empty() || *f[1].begin != 'A') {
+        fix.positionValid = false;
+        return;
+    }
+    fix.positionValid = parseCoordinate(f[2], f[3], 2, fix.latitude_e7)
+                     && parseCoordinate(f[4], f[5], 3, fix.longitude_e7);
+
+    int32_t value;
+    fix.speedValid = parseFixed(f[6], 3, value);
+    if (fix.speedValid) {
+        fix.speed_mknots = (uint32_t)value;
+    }
+    fix.courseValid = parseFixed(f[7], 2, value);
+    if (fix.courseValid) {
+        fix.course_cdeg = (uint16_t)value;
+    }
+}
+
+void NMEAParser::parseGSA(const char* talker, const char* p, const char* end) {
+    // opMode,navMode,sv1..sv12,PDOP,HDOP,VDOP[,systemId]
+    Field f[NMEA_MAX_FIELDS];
+    uint8_t n = splitFields(p, end, f, NMEA_MAX_FIELDS);
+    if (n < 17) {
+        return;
+    }
+    int32_t value;
+    fix.fixMode = parseFixed(f[1], 0, value) ? (uint8_t)value : 1;
+    if (parseFixed(f[14], 2, value)) {
+        fix.pdop_x100 = (uint16_t)value;
+    }
+    if (parseFixed(f[15], 2, value)) {
+        fix.hdop_x100 = (uint16_t)value;
+        fix.hdopValid = true;
+    }
+    if (parseFixed(f[16], 2, value)) {
+        fix.vdop_x100 = (uint16_t)value;
+    }
+
+    // System aus der System-ID, dem Talker oder bei "GN" ohne ID aus den Satellitennummern
+    uint8_t system = 0;
+    if (n > 17 && parseFixed(f[17], 0, value)) {
+        system = systemFromId(value);
+    }
+    if (system == 0) {
+        system = systemFromTalker(talker);
+    }
+    for (uint8_t i = 2; i < 14; i++) {
+        if (parseFixed(f[i], 0, value)) {
+            gsaSystems |= (system != 0) ? system : systemFromSatellite(value);
+        }
+    }
+    fix.systemsUsed = gsaSystems;
+}
+
+void NMEAParser::parseGST(const char* p, const char* end) {
+    // time,rangeRms,stdMajor,stdMinor,orient,stdLat,stdLong,stdAlt
+    Field f[NMEA_MAX_FIELDS];
+    uint8_t n = splitFields(p, end, f, NMEA_MAX_FIELDS);
+    NMEAFix time;
+    if (n < 8 || !parseTime(f[0], time)) {
+        fix.rangeRmsValid = false;
+        fix.ellipseValid = false;
+        fix.stdValid = false;
+        return;
+    }
+    fix.errorTime_ms = time.timeOfDay_ms();
+
+    // Leere Felder oder 0 bedeuten "nicht unterstützt"
+    int32_t rms, major, minor, orient, lat, lon, alt;
+    fix.rangeRmsValid = parseFixed(f[1], 3, rms) && rms > 0;
+    fix.ellipseValid = parseFixed(f[2], 3, major) && parseFixed(f[3], 3, minor)
+                    && parseFixed(f[4], 2, orient) && major > 0 && minor > 0;
+    fix.stdValid = parseFixed(f[5], 3, lat) && parseFixed(f[6], 3, lon) && parseFixed(f[7], 3, alt)
+                && lat > 0 && lon > 0 && alt > 0;
+    if (fix.rangeRmsValid) {
+        fix.rangeRms_mm = (uint32_t)rms;
+    }
+    if (fix.ellipseValid) {
+        fix.stdMajor_mm = (uint32_t)major;
+        fix.stdMinor_mm = (uint32_t)minor;
+        fix.orient_cdeg = (uint16_t)(((orient % 36000) + 36000) % 36000);
+    }
+    if (fix.stdValid) {
+        fix.stdLat_mm = (uint32_t)lat;
+        fix.stdLon_mm = (uint32_t)lon;
+        fix.stdAlt_mm = (uint32_t)alt;
+    }
+}
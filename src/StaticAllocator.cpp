@@ -0,0 +1,172 @@
+#include "StaticAllocator.h"
+
+StaticAllocator::StaticAllocator(uint8_t* arenaBuffer, size_t size)
+    : arena(arenaBuffer)
+    , capacity(0)
+    , freeList(nullptr)
+    , used(0)
+    , highWaterMark(0)
+    , failedAllocations(0)
+{
+    // Arena auf die Blockausrichtung zuschneiden
+    uintptr_t start = ((uintptr_t)arenaBuffer + ALIGNMENT - 1) & ~(uintptr_t)(ALIGNMENT - 1);
+    size_t offset = start - (uintptr_t)arenaBuffer;
+    if (size > offset + HEADER_SIZE) {
+        arena = (uint8_t*)start;
+        capacity = (size - offset) & ~(ALIGNMENT - 1);
+        freeList = (Block*)arena;
+        freeList->size = capacity;
+        freeList->next = nullptr;
+    }
+}
+
+rcutils_allocator_t StaticAllocator::getAllocator() {
+    rcutils_allocator_t allocator = rcutils_get_zero_initialized_allocator();
+    allocator.allocate = allocateCallback;
+    allocator.deallocate = deallocateCallback;
+    allocator.reallocate = reallocateCallback;
+    allocator.zero_allocate = zeroAllocateCallback;
+    allocator.state = this;
+    return allocator;
+}
+
+void* StaticAllocator::allocate(size_t size) {
+    size_t needed = HEADER_SIZE + ((size + ALIGNMENT - 1) & ~(ALIGNMENT - 1));
+
+    // First-Fit über die nach Adresse sortierte Freiliste
+    Block** link = &freeList;
+    while (*link != nullptr && (*link)->size < needed) {
+        link = &(*link)->next;
+    }
+    Block* block = *link;
+    if (block == nullptr) {
+        failedAllocations++;
+        return nullptr;
+    }
+
+    if (block->size >= needed + HEADER_SIZE + ALIGNMENT) {
+        // Block teilen, der Rest bleibt an derselben Stelle der Liste
+        Block* rest = (Block*)((uint8_t*)block + needed);
+        rest->size = block->size - needed;
+        rest->next = block->next;
+        *link = rest;
+        block->size = needed;
+    } else {
+        *link = block->next;
+    }
+
+    used += block->size;
+    if (used > highWaterMark) {
+        highWaterMark = used;
+    }
+    return (uint8_t*)block + HEADER_SIZE;
+}
+
+void StaticAllocator::deallocate(void* ptr) {
+    if (ptr == nullptr) {
+        return;
+    }
+    Block* block = (Block*)((uint8_t*)ptr - HEADER_SIZE);
+    used -= block->size;
+    insertFree(block);
+}
+
+void StaticAllocator::insertFree(Block* block) {
+    Block* prev = nullptr;
+    Block* next = freeList;
+    while (next != nullptr && next < block) {
+        prev = next;
+        next = next->next;
+    }
+
+    // Mit dem Nachfolger zusammenfassen
+    if (next != nullptr && (uint8_t*)block + block->size == (uint8_t*)next) {
+        block->size += next->size;
+        block->next = next->next;
+    } else {
+        block->next = next;
+    }
+
+    // Mit dem Vorgänger zusammenfassen
+    if (prev != nullptr && (uint8_t*)prev + prev->size == (uint8_t*)block) {
+        prev->size += block->size;
+        prev->next = block->next;
+    } else if (prev != nullptr) {
+        prev->next = block;
+    } else {
+        freeList = block;
+    }
+}
+
+void* StaticAllocator::reallocate(void* ptr, size_t size) {
+    if (ptr == nullptr) {
+        return allocate(size);
+    }
+    Block* block = (Block*)((uint8_t*)ptr - HEADER_SIZE);
+    size_t available = block->size - HEADER_SIZE;
+    if (size <= available) {
+        return ptr;
+    }
+    void* moved = allocate(size);
+    if (moved == nullptr) {
+        return nullptr;
+    }
+    memcpy(moved, ptr, available);
+    deallocate(ptr);
+    return moved;
+}
+
+void* StaticAllocator::zeroAllocate(size_t count, size_t size) {
+    size_t total = count * size;
+    if (size != 0 && total / size != count) {
+        failedAllocations++;
+        return nullptr;
+    }
+    void* ptr = allocate(total);
+    if (ptr != nullptr) {
+        memset(ptr, 0, total);
+    }
+    return ptr;
+}
+
+size_t StaticAllocator::getCapacity() const {
+    return capacity;
+}
+
+size_t StaticAllocator::getUsed() const {
+    return used;
+}
+
+size_t StaticAllocator::getHighWaterMark() const {
+    return highWaterMark;
+}
+
+size_t StaticAllocator::getLargestFreeBlock() const {
+    size_t largest = 0;
+    for (const Block* block = freeList; block != nullptr; block = block->next) {
+        if (block->size > largest) {
+            largest = block->size;
+        }
+    }
+    return largest > HEADER_SIZE ? largest - HEADER_SIZE : 0;
+}
+
+uint32_t StaticAllocator::getFailedAllocations() const {
+    return failedAllocations;
+}
+
+void* StaticAllocator::allocateCallback(size_t size, void* state) {
+    return static_cast<StaticAllocator*>(state)->allocate(size);
+}
+
+void StaticAllocator::deallocateCallback(void* ptr, void* state) {
+    static_cast<StaticAllocator*>(state)->deallocate(ptr);
+}
+
+void* StaticAllocator::reallocateCallback(void* ptr, size_t size, void* state) {
+    return static_cast<StaticAllocator*>(state)->reallocate(ptr, size);
+}
+
+void* StaticAllocator::zeroAllocateCallback(size_t count, size_t size, void* state) {
+    return static_cast<StaticAllocator*>(state)->zeroAllocate(count, size);
+}
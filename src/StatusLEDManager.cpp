@@ -1,10 +1,15 @@
 #include "StatusLEDManager.h"
+#include "StatusLEDPatterns.h"
 #include <Wire.h>
 
+using StatusLEDPatterns::PATTERNS;
+using StatusLEDPatterns::frameDuration;
+using StatusLEDPatterns::patternDuration;
+
 StatusLEDManager::StatusLEDManager()
     : currentStatus(LED_STATUS_CONNECTING)
-    , ledState(false)
-    , blinkTimer(0)
+    , frameIndex(0)
+    , frameStart(0)
 {
 }
 
@@ -12,73 +17,65 @@ void StatusLEDManager::begin() {
     Wire.begin();
     rgbLED.begin();
     delay(100);
-    rgbLED.setColor(0, 0, 0);
-    delay(100);
+    startPattern();
+    rgbLED.flush();
 }
 
 void StatusLEDManager::setStatus(BeaconLEDStatus status) {
-    if (status != currentStatus) {
+    if (status != currentStatus && status < LED_STATUS_COUNT) {
         currentStatus = status;
-        ledState = true;  // Reset blink state
-        blinkTimer = 0;   // Reset timer
+        startPattern();
     }
 }
 
 void StatusLEDManager::update() {
-    updateStatusLED();
+    const StatusPattern& pattern = PATTERNS[currentStatus];
+    if (pattern.count > 1) {
+        uint32_t now = millis();
+        // Nach einer langen Pause ganze Durchläufe überspringen
+        uint32_t period = patternDuration(pattern);
+        if (now - frameStart >= period) {
+            frameStart += (now - frameStart) / period * period;
+        }
+        // Zum fälligen Schritt weiterschalten, Schritte beginnen planmäßig
+        bool advanced = false;
+        while (now - frameStart >= frameDuration(pattern.frames[frameIndex])) {
+            frameStart += frameDuration(pattern.frames[frameIndex]);
+            frameIndex = (frameIndex + 1) % pattern.count;
+            advanced = true;
+        }
+        if (advanced) {
+            applyKeyframe();
+        }
+    }
+    // Nur geänderte Register gehen auf den Bus
+    rgbLED.update();
+}
+
+void StatusLEDManager::printStats(Print& out) const {
+    out.printf("ncp5623    transfers %lu  skipped %lu  errors %lu\n",
+               (unsigned long)rgbLED.getTransferCount(),
+               (unsigned long)rgbLED.getSkippedCount(),
+               (unsigned long)rgbLED.getErrorCount());
 }
 
 void StatusLEDManager::setColor(uint8_t red, uint8_t green, uint8_t blue) {
     rgbLED.setColor(red, green, blue);
 }
 
-void StatusLEDManager::updateStatusLED() {
-    switch (currentStatus) {
-        case LED_STATUS_CONNECTING:
-            // Cyan blinkend
-            if (blinkTimer >= BLINK_INTERVAL_CONNECTING) {
-                ledState = !ledState;
-                blinkTimer = 0;
-            }
-            
-            if (ledState) {
-                rgbLED.setColor(LED_STATUS_CONNECTING_R, LED_STATUS_CONNECTING_G, LED_STATUS_CONNECTING_B);
-            } else {
-                rgbLED.setColor(0, 0, 0);
-            }
-            break;
-            
-        case LED_STATUS_CONNECTED_NO_FIX:
-            // Gelb blinkend
-            if (blinkTimer >= BLINK_INTERVAL_NO_FIX) {
-                ledState = !ledState;
-                blinkTimer = 0;
-            }
-            
-            if (ledState) {
-                rgbLED.setColor(LED_STATUS_CONNECTED_NO_FIX_R, LED_STATUS_CONNECTED_NO_FIX_G, LED_STATUS_CONNECTED_NO_FIX_B);
-            } else {
-                rgbLED.setColor(0, 0, 0);
-            }
-            break;
-            
-        case LED_STATUS_CONNECTED_FIX:
-            // Blau statisch
-            rgbLED.setColor(LED_STATUS_CONNECTED_FIX_R, LED_STATUS_CONNECTED_FIX_G, LED_STATUS_CONNECTED_FIX_B);
-            break;
-            
-        case LED_STATUS_ERROR:
-            // Rot blinkend
-            if (blinkTimer >= BLINK_INTERVAL_ERROR) {
-                ledState = !ledState;
-                blinkTimer = 0;
-            }
-            
-            if (ledState) {
-                rgbLED.setColor(LED_STATUS_ERROR_R, LED_STATUS_ERROR_G, LED_STATUS_ERROR_B);
-            } else {
-                rgbLED.setColor(0, 0, 0);
-            }
-            break;
+void StatusLEDManager::startPattern() {
+    frameIndex = 0;
+    frameStart = millis();
+    applyKeyframe();
+}
+
+void StatusLEDManager::applyKeyframe() {
+    const StatusKeyframe& frame = PATTERNS[currentStatus].frames[frameIndex];
+    rgbLED.setColor(frame.red, frame.green, frame.blue);
+    if (frame.rampMs > 0) {
+        // Der NCP5623 dimmt selbst, die Rampe kostet nur eine Übertragung
+        rgbLED.fadeCurrent(frame.current, frame.rampMs);
+    } else {
+        rgbLED.setCurrent(frame.current);
     }
 }
@@ -0,0 +1,243 @@
+#include "TaskScheduler.h"
+#include "CycleCounter.h"
+
+#define STATS_DUMP_VERSION 1
+#define STATS_DUMP_NAME_LENGTH 8
+
+namespace {
+
+// Schreibt little-endian und führt die Fletcher-Prüfsumme mit
+class FrameWriter {
+public:
+    explicit FrameWriter(Print& out) : out(out), ck_a(0), ck_b(0) {}
+
+    void u8(uint8_t value) {
+        out.write(value);
+        ck_a += value;
+        ck_b += ck_a;
+    }
+    void u16(uint16_t value) {
+        u8(value & 0xFF);
+        u8(value >> 8);
+    }
+    void u32(uint32_t value) {
+        u16(value & 0xFFFF);
+        u16(value >> 16);
+    }
+    void u64(uint64_t value) {
+        u32((uint32_t)value);
+        u32((uint32_t)(value >> 32));
+    }
+    void checksum() {
+        uint8_t a = ck_a;
+        uint8_t b = ck_b;
+        out.write(a);
+        out.write(b);
+    }
+
+private:
+    Print& out;
+    uint8_t ck_a;
+    uint8_t ck_b;
+};
+
+// Takte als µs mit einer Nachkommastelle
+void formatMicros(char* buffer, size_t size, uint64_t cycles) {
+    uint64_t tenths = cycles * 10 / CycleCounter::cyclesPerMicro();
+    snprintf(buffer, size, "%lu.%lu", (unsigned long)(tenths / 10), (unsigned long)(tenths % 10));
+}
+
+}  // namespace
+
+TaskScheduler::TaskScheduler()
+    : taskCount(0)
+{
+    CycleCounter::begin();
+}
+
+void TaskScheduler::clearStats(TaskStats& stats) {
+    stats.runs = 0;
+    stats.overruns = 0;
+    stats.missedDeadlines = 0;
+    stats.min_cycles = UINT32_MAX;
+    stats.max_cycles = 0;
+    stats.total_cycles = 0;
+    stats.maxLatency_us = 0;
+    stats.execution.reset();
+    stats.latency.reset();
+}
+
+int8_t TaskScheduler::addTask(const char* name, TaskFunction function, uint32_t period_us, uint32_t deadline_us, uint8_t priority) {
+    if (taskCount >= SCHEDULER_MAX_TASKS || function == nullptr) {
+        return -1;
+    }
+    Task& task = tasks[taskCount];
+    task.name = name;
+    task.function = function;
+    task.period_us = period_us;
+    task.deadline_us = deadline_us;
+    task.priority = priority;
+    task.release_us = micros();
+    clearStats(task.stats);
+    return taskCount++;
+}
+
+bool TaskScheduler::run() {
+    uint32_t now = micros();
+
+    // Earliest Deadline First unter allen freigegebenen Tasks
+    Task* next = nullptr;
+    int32_t nextSlack = 0;
+    for (uint8_t i = 0; i < taskCount; i++) {
+        Task& task = tasks[i];
+        if ((int32_t)(now - task.release_us) < 0) {
+            continue;
+        }
+        int32_t slack = (int32_t)(task.release_us + task.deadline_us - now);
+        if (next == nullptr || slack < nextSlack || (slack == nextSlack && task.priority > next->priority)) {
+            next = &task;
+            nextSlack = slack;
+        }
+    }
+    if (next == nullptr) {
+        return false;
+    }
+
+    if (nextSlack < 0) {
+        next->stats.missedDeadlines++;
+    }
+
+    uint32_t start = micros();
+    uint32_t startCycles = CycleCounter::now();
+    next->function();
+    uint32_t elapsed = CycleCounter::now() - startCycles;
+
+    TaskStats& stats = next->stats;
+    uint32_t latency_us = start - next->release_us;
+    stats.runs++;
+    stats.total_cycles += elapsed;
+    if (elapsed < stats.min_cycles) {
+        stats.min_cycles = elapsed;
+    }
+    if (elapsed > stats.max_cycles) {
+        stats.max_cycles = elapsed;
+    }
+    if (latency_us > stats.maxLatency_us) {
+        stats.maxLatency_us = latency_us;
+    }
+    stats.execution.add(CycleCounter::toMicros(elapsed));
+    stats.latency.add(latency_us);
+    if (elapsed > (uint64_t)next->deadline_us * CycleCounter::cyclesPerMicro()) {
+        stats.overruns++;
+    }
+
+    // Nächste Freigabe im festen Raster, nach langer Blockade nicht nachholen
+    next->release_us += next->period_us;
+    if ((int32_t)(start - next->release_us) > (int32_t)next->period_us) {
+        next->release_us = start + next->period_us;
+    }
+    return true;
+}
+
+uint8_t TaskScheduler::getTaskCount() const {
+    return taskCount;
+}
+
+const char* TaskScheduler::getTaskName(uint8_t id) const {
+    return tasks[id].name;
+}
+
+const TaskScheduler::TaskStats& TaskScheduler::getStats(uint8_t id) const {
+    return tasks[id].stats;
+}
+
+void TaskScheduler::resetStats() {
+    for (uint8_t i = 0; i < taskCount; i++) {
+        clearStats(tasks[i].stats);
+    }
+}
+
+void TaskScheduler::printStats(Print& out) const {
+    out.println("task        runs   min_us  avg_us  max_us  lat_us  overrun  missed");
+    for (uint8_t i = 0; i < taskCount; i++) {
+        const Task& task = tasks[i];
+        const TaskStats& stats = task.stats;
+        char min[24];
+        char avg[24];
+        char max[24];
+        formatMicros(min, sizeof(min), stats.runs > 0 ? stats.min_cycles : 0);
+        formatMicros(avg, sizeof(avg), stats.runs > 0 ? stats.total_cycles / stats.runs : 0);
+        formatMicros(max, sizeof(max), stats.max_cycles);
+        char line[128];
+        snprintf(line, sizeof(line), "%-10s %6lu %8s %7s %7s %7lu %8lu %7lu",
+                 task.name,
+                 (unsigned long)stats.runs,
+                 min,
+                 avg,
+                 max,
+                 (unsigned long)stats.maxLatency_us,
+                 (unsigned long)stats.overruns,
+                 (unsigned long)stats.missedDeadlines);
+        out.println(line);
+    }
+}
+
+void TaskScheduler::printHistograms(Print& out) const {
+    // Kopfzeile mit den unteren Klassengrenzen in µs
+    out.print("hist_us          ");
+    for (uint8_t b = 0; b < LatencyHistogram::BUCKETS; b++) {
+        out.printf(" %6lu", (unsigned long)LatencyHistogram::lowerBound(b));
+    }
+    out.println();
+    for (uint8_t i = 0; i < taskCount; i++) {
+        const Task& task = tasks[i];
+        const LatencyHistogram* histograms[] = {&task.stats.execution, &task.stats.latency};
+        const char* labels[] = {"exec", "lat"};
+        for (uint8_t h = 0; h < 2; h++) {
+            out.printf("%-10s %-5s ", task.name, labels[h]);
+            for (uint8_t b = 0; b < LatencyHistogram::BUCKETS; b++) {
+                out.printf(" %6lu", (unsigned long)histograms[h]->getCount(b));
+            }
+            out.println();
+        }
+    }
+}
+
+void TaskScheduler::dumpStats(Print& out) const {
+    const uint16_t taskSize = STATS_DUMP_NAME_LENGTH + 5 * 4 + 8 + 4 + 2 * LatencyHistogram::BUCKETS * 4;
+    const uint16_t length = 4 + 4 + 1 + 1 + taskCount * taskSize;
+
+    out.write('T');
+    out.write('S');
+    FrameWriter frame(out);
+    frame.u8(STATS_DUMP_VERSION);
+    frame.u16(length);
+    frame.u32(CycleCounter::cyclesPerMicro());
+    frame.u32(millis());
+    frame.u8(taskCount);
+    frame.u8(LatencyHistogram::BUCKETS);
+    for (uint8_t i = 0; i < taskCount; i++) {
+        const Task& task = tasks[i];
+        const TaskStats& stats = task.stats;
+        // Name auf feste Länge kürzen bzw. auffüllen
+        bool ended = false;
+        for (uint8_t c = 0; c < STATS_DUMP_NAME_LENGTH; c++) {
+            ended = ended || task.name[c] == '\0';
+            frame.u8(ended ? 0 : (uint8_t)task.name[c]);
+        }
+        frame.u32(stats.runs);
+        frame.u32(stats.overruns);
+        frame.u32(stats.missedDeadlines);
+        frame.u32(stats.runs > 0 ? stats.min_cycles : 0);
+        frame.u32(stats.max_cycles);
+        frame.u64(stats.total_cycles);
+        frame.u32(stats.maxLatency_us);
+        for (uint8_t b = 0; b < LatencyHistogram::BUCKETS; b++) {
+            frame.u32(stats.execution.getCount(b));
+        }
+        for (uint8_t b = 0; b < LatencyHistogram::BUCKETS; b++) {
+            frame.u32(stats.latency.getCount(b));
+        }
+    }
+    frame.checksum();
+}
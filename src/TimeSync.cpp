@@ -0,0 +1,219 @@
+#include "TimeSync.h"
+
+volatile uint32_t TimeSync::ppsMicros = 0;
+volatile uint32_t TimeSync::ppsCount = 0;
+
+// Maximal zulässige Gangabweichung, größere Schätzungen gelten als Ausreißer
+#define TIME_SYNC_MAX_DRIFT 0.0005   // 500 ppm
+
+ClockEstimator::ClockEstimator()
+    : rejectedSamples(0)
+{
+    reset();
+}
+
+void ClockEstimator::reset() {
+    count = 0;
+    next = 0;
+    outliers = 0;
+    baseLocal = 0;
+    baseReference = 0;
+    slope = 1000.0;
+}
+
+bool ClockEstimator::addSample(uint64_t local_us, int64_t reference_ns) {
+    // Stützpunkte weit neben der Schätzung verwerfen, etwa eine PPS-Flanke,
+    // die einer falschen UTC-Sekunde zugeordnet wurde
+    if (count > 0) {
+        int64_t residual = reference_ns - toReference(local_us);
+        if (residual > TIME_SYNC_MAX_RESIDUAL_NS || residual < -TIME_SYNC_MAX_RESIDUAL_NS) {
+            if (++outliers < TIME_SYNC_MAX_OUTLIERS) {
+                rejectedSamples++;
+                return false;
+            }
+            // Mehrere Ausreißer in Folge: die Referenz ist gesprungen
+            reset();
+        }
+    }
+    outliers = 0;
+
+    samples[next].local_us = local_us;
+    samples[next].reference_ns = reference_ns;
+    next = (next + 1) % TIME_SYNC_WINDOW;
+    if (count < TIME_SYNC_WINDOW) {
+        count++;
+    }
+    fit();
+    return true;
+}
+
+bool ClockEstimator::isValid() const {
+    return count > 0;
+}
+
+uint8_t ClockEstimator::getSampleCount() const {
+    return count;
+}
+
+uint32_t ClockEstimator::getRejectedSamples() const {
+    return rejectedSamples;
+}
+
+void ClockEstimator::fit() {
+    // Bezug auf den neuesten Stützpunkt, damit die Rechnung in double genau bleibt
+    const Sample& newest = samples[(next + TIME_SYNC_WINDOW - 1) % TIME_SYNC_WINDOW];
+    baseLocal = newest.local_us;
+
+    // Residuen gegenüber einer idealen Uhr (1000 ns pro µs)
+    double sumX = 0, sumY = 0, sumXX = 0, sumXY = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        double x = (double)(int64_t)(samples[i].local_us - baseLocal);
+        double y = (double)(samples[i].reference_ns - newest.reference_ns) - x * 1000.0;
+        sumX += x;
+        sumY += y;
+        sumXX += x * x;
+        sumXY += x * y;
+    }
+    double n = count;
+    double meanX = sumX / n;
+    double meanY = sumY / n;
+    double varX = sumXX - n * meanX * meanX;
+
+    double drift = 0.0;
+    if (count >= 2 && varX > 0.0) {
+        drift = (sumXY - n * meanX * meanY) / varX;
+        if (drift > TIME_SYNC_MAX_DRIFT * 1000.0 || drift < -TIME_SYNC_MAX_DRIFT * 1000.0) {
+            drift = 0.0;
+        }
+    }
+    double offset = meanY - drift * meanX;
+
+    baseReference = newest.reference_ns + (int64_t)offset;
+    slope = 1000.0 + drift;
+}
+
+int64_t ClockEstimator::toReference(uint64_t local_us) const {
+    double dx = (double)(int64_t)(local_us - baseLocal);
+    return baseReference + (int64_t)(dx * slope);
+}
+
+uint64_t ClockEstimator::toLocal(int64_t reference_ns) const {
+    double dy = (double)(reference_ns - baseReference);
+    return baseLocal + (int64_t)(dy / slope);
+}
+
+float ClockEstimator::getDriftPpm() const {
+    return (float)((slope - 1000.0) * 1000.0);
+}
+
+TimeSync::TimeSync()
+    : lastMicros(0)
+    , microsHigh(0)
+    , lastUsedPPSCount(0)
+    , rejectedAgentSamples(0)
+{
+}
+
+void TimeSync::begin(int ppsPin) {
+    lastMicros = micros();
+    if (ppsPin >= 0) {
+        pinMode(ppsPin, INPUT);
+        attachInterrupt(digitalPinToInterrupt(ppsPin), ppsISR, RISING);
+    }
+}
+
+void TimeSync::ppsISR() {
+    ppsMicros = micros();
+    ppsCount++;
+}
+
+uint64_t TimeSync::nowMicros() {
+    uint32_t now = micros();
+    if (now < lastMicros) {
+        microsHigh++;
+    }
+    lastMicros = now;
+    return ((uint64_t)microsHigh << 32) | now;
+}
+
+uint64_t TimeSync::extendMicros(uint32_t captured_us) {
+    // Der erfasste Wert liegt maximal ~71 Minuten in der Vergangenheit
+    uint64_t now = nowMicros();
+    return now - (uint32_t)(lastMicros - captured_us);
+}
+
+void TimeSync::addAgentSample(uint64_t local_us, int64_t agent_ns, uint32_t round_trip_us) {
+    // Stützpunkte mit langer Laufzeit sind ungenau
+    if (round_trip_us > TIME_SYNC_MAX_RTT_US) {
+        rejectedAgentSamples++;
+        return;
+    }
+    agentClock.addSample(local_us, agent_ns);
+}
+
+bool TimeSync::isAgentSynchronized() const {
+    return agentClock.isValid();
+}
+
+int64_t TimeSync::toAgentNanos(uint64_t local_us) const {
+    return agentClock.toReference(local_us);
+}
+
+void TimeSync::resetAgent() {
+    agentClock.reset();
+}
+
+TimeSync::PPSEdge TimeSync::latchPPS() {
+    // Ohne Interruptsperre, damit der Aufruf aus einer ISR sie nicht aufhebt:
+    // erneut lesen, falls die PPS-ISR zwischen den beiden Werten lief
+    PPSEdge edge;
+    do {
+        edge.count = ppsCount;
+        edge.micros = ppsMicros;
+    } while (edge.count != ppsCount);
+    return edge;
+}
+
+void TimeSync::addGnssEpoch(int64_t utc_ns, uint32_t arrival_us, const PPSEdge& pps) {
+    // Die Flanke stammt aus dem Burst der Epoche, nicht die neueste: beim
+    // Abarbeiten eines Rückstands wäre sie sonst um ganze Sekunden verschoben.
+    // Jede PPS-Flanke nur einmal verwenden, sie markiert den Beginn der UTC-Sekunde der Epoche
+    if (pps.count == 0 || pps.count == lastUsedPPSCount || utc_ns <= 0) {
+        return;
+    }
+    uint32_t age = arrival_us - pps.micros;
+    if (age > 1000000UL) {
+        return;
+    }
+    lastUsedPPSCount = pps.count;
+    int64_t second_ns = (utc_ns / 1000000000LL) * 1000000000LL;
+    ppsClock.addSample(extendMicros(pps.micros), second_ns);
+}
+
+bool TimeSync::isPPSDisciplined() const {
+    return ppsClock.getSampleCount() >= 2;
+}
+
+uint64_t TimeSync::timeOfValidity(int64_t utc_ns, uint32_t arrival_us) {
+    if (isPPSDisciplined() && utc_ns > 0) {
+        return ppsClock.toLocal(utc_ns);
+    }
+    // Ohne PPS: Beginn des Empfangs der Epoche
+    return extendMicros(arrival_us);
+}
+
+const ClockEstimator& TimeSync::getAgentClock() const {
+    return agentClock;
+}
+
+const ClockEstimator& TimeSync::getPPSClock() const {
+    return ppsClock;
+}
+
+uint32_t TimeSync::getPPSCount() const {
+    return ppsCount;
+}
+
+uint32_t TimeSync::getRejectedAgentSamples() const {
+    return rejectedAgentSamples;
+}
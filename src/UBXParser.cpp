@@ -0,0 +1,252 @@
+#include "UBXParser.h"
+
+namespace {
+
+// UBX ist little-endian
+inline uint16_t readU2(const uint8_t* p) {
+    return (uint16_t)p[0] | ((uint16_t)p[1] << 8);
+}
+
+inline uint32_t readU4(const uint8_t* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+inline int32_t readI4(const uint8_t* p) {
+    return (int32_t)readU4(p);
+}
+
+}  // namespace
+
+UBXParser::UBXParser()
+    : state(STATE_SYNC1)
+    , msgClass(0)
+    , msgId(0)
+    , payloadLength(0)
+    , payloadIndex(0)
+    , ckA(0)
+    , ckB(0)
+    , ackClass(0)
+    , ackId(0)
+    , ackReceived(false)
+    , messageCount(0)
+    , checksumErrors(0)
+{
+}
+
+const UBXNavSolution& UBXParser::getSolution() const {
+    return solution;
+}
+
+bool UBXParser::isAcknowledged(uint8_t cls, uint8_t id) const {
+    return ackReceived && ackClass == cls && ackId == id;
+}
+
+void UBXParser::clearAcknowledge() {
+    ackReceived = false;
+}
+
+uint32_t UBXParser::getMessageCount() const {
+    return messageCount;
+}
+
+uint32_t UBXParser::getChecksumErrorCount() const {
+    return checksumErrors;
+}
+
+uint16_t UBXParser::buildFrame(uint8_t cls, uint8_t id, const uint8_t* data, uint16_t length,
+                               uint8_t* frame, uint16_t frameSize) {
+    uint16_t total = length + 8;
+    if (total > frameSize) {
+        return 0;
+    }
+    frame[0] = UBX_SYNC_CHAR_1;
+    frame[1] = UBX_SYNC_CHAR_2;
+    frame[2] = cls;
+    frame[3] = id;
+    frame[4] = length & 0xFF;
+    frame[5] = length >> 8;
+    memcpy(frame + 6, data, length);
+
+    // 8-Bit Fletcher-Prüfsumme über Klasse, ID, Länge und Nutzdaten
+    uint8_t a = 0;
+    uint8_t b = 0;
+    for (uint16_t i = 2; i < length + 6; i++) {
+        a += frame[i];
+        b += a;
+    }
+    frame[length + 6] = a;
+    frame[length + 7] = b;
+    return total;
+}
+
+uint8_t UBXParser::feed(const uint8_t* data, uint32_t length) {
+    uint8_t parsed = 0;
+
+    for (uint32_t i = 0; i < length; i++) {
+        uint8_t c = data[i];
+
+        switch (state) {
+            case STATE_SYNC1:
+                if (c == UBX_SYNC_CHAR_1) {
+                    state = STATE_SYNC2;
+                } else {
+                    // Bis zum nächsten Sync-Zeichen überspringen
+                    const uint8_t* next = (const uint8_t*)memchr(data + i + 1, UBX_SYNC_CHAR_1, length - i - 1);
+                    if (next == nullptr) {
+                        return parsed;
+                    }
+                    i = (next - data) - 1;
+                }
+                break;
+            case STATE_SYNC2:
+                state = (c == UBX_SYNC_CHAR_2) ? STATE_CLASS : (c == UBX_SYNC_CHAR_1 ? STATE_SYNC2 : STATE_SYNC1);
+                break;
+            case STATE_CLASS:
+                msgClass = c;
+                ckA = c;
+                ckB = ckA;
+                state = STATE_ID;
+                break;
+            case STATE_ID:
+                msgId = c;
+                ckA += c;
+                ckB += ckA;
+                state = STATE_LENGTH1;
+                break;
+            case STATE_LENGTH1:
+                payloadLength = c;
+                ckA += c;
+                ckB += ckA;
+                state = STATE_LENGTH2;
+                break;
+            case STATE_LENGTH2:
+                payloadLength |= (uint16_t)c << 8;
+                ckA += c;
+                ckB += ckA;
+                payloadIndex = 0;
+                if (payloadLength > UBX_MAX_PAYLOAD) {
+                    // Zu groß für den Puffer - Rahmen verwerfen
+                    state = STATE_SYNC1;
+                } else {
+                    state = (payloadLength > 0) ? STATE_PAYLOAD : STATE_CK_A;
+                }
+                break;
+            case STATE_PAYLOAD: {
+                // Nutzdaten am Stück übernehmen
+                uint32_t chunk = payloadLength - payloadIndex;
+                if (chunk > length - i) {
+                    chunk = length - i;
+                }
+                for (uint32_t k = 0; k < chunk; k++) {
+                    uint8_t b = data[i + k];
+                    payload[payloadIndex + k] = b;
+                    ckA += b;
+                    ckB += ckA;
+                }
+                payloadIndex += chunk;
+                i += chunk - 1;
+                if (payloadIndex >= payloadLength) {
+                    state = STATE_CK_A;
+                }
+                break;
+            }
+            case STATE_CK_A:
+                if (c == ckA) {
+                    state = STATE_CK_B;
+                } else {
+                    checksumErrors++;
+                    state = STATE_SYNC1;
+                }
+                break;
+            case STATE_CK_B:
+                if (c == ckB) {
+                    messageCount++;
+                    parsed |= handleMessage();
+                } else {
+                    checksumErrors++;
+                }
+                state = STATE_SYNC1;
+                break;
+        }
+    }
+    return parsed;
+}
+
+uint8_t UBXParser::handleMessage() {
+    if (msgClass == UBX_CLASS_NAV) {
+        if (msgId == UBX_NAV_PVT && payloadLength >= 92) {
+            parseNavPVT();
+            return MESSAGE_NAV_PVT;
+        }
+        if (msgId == UBX_NAV_DOP && payloadLength >= 18) {
+            parseNavDOP();
+            return MESSAGE_NAV_DOP;
+        }
+        if (msgId == UBX_NAV_SAT && payloadLength >= 8) {
+            parseNavSAT();
+            return MESSAGE_NAV_SAT;
+        }
+    } else if (msgClass == UBX_CLASS_ACK && msgId == UBX_ACK_ACK && payloadLength >= 2) {
+        ackClass = payload[0];
+        ackId = payload[1];
+        ackReceived = true;
+        return MESSAGE_ACK;
+    }
+    return 0;
+}
+
+void UBXParser::parseNavPVT() {
+    const uint8_t* p = payload;
+    solution.iTOW = readU4(p + 0);
+    solution.year = readU2(p + 4);
+    solution.month = p[6];
+    solution.day = p[7];
+    solution.hour = p[8];
+    solution.minute = p[9];
+    solution.second = p[10];
+    solution.dateValid = (p[11] & 0x01) != 0;
+    solution.timeValid = (p[11] & 0x02) != 0;
+    solution.nano = readI4(p + 16);
+    solution.fixType = p[20];
+    solution.gnssFixOK = (p[21] & 0x01) != 0;
+    solution.diffSoln = (p[21] & 0x02) != 0;
+    solution.numSV = p[23];
+    solution.longitude_e7 = readI4(p + 24);
+    solution.latitude_e7 = readI4(p + 28);
+    solution.hMSL_mm = readI4(p + 36);
+    solution.hAcc_mm = readU4(p + 40);
+    solution.vAcc_mm = readU4(p + 44);
+    solution.gSpeed_mmps = readI4(p + 60);
+    solution.headMot_e5 = readI4(p + 64);
+    solution.pDOP = readU2(p + 76);
+}
+
+void UBXParser::parseNavDOP() {
+    const uint8_t* p = payload;
+    solution.pDOP = readU2(p + 6);
+    solution.vDOP = readU2(p + 10);
+    solution.hDOP = readU2(p + 12);
+}
+
+void UBXParser::parseNavSAT() {
+    const uint8_t* p = payload;
+    uint8_t numSvs = p[5];
+    if (payloadLength < 8 + numSvs * 12) {
+        return;
+    }
+    uint8_t used = 0;
+    uint8_t mask = 0;
+    for (uint8_t i = 0; i < numSvs; i++) {
+        const uint8_t* sv = p + 8 + i * 12;
+        uint8_t gnssId = sv[0];
+        uint32_t flags = readU4(sv + 8);
+        if (flags & 0x08) {  // svUsed
+            used++;
+            if (gnssId < 8) {
+                mask |= (1 << gnssId);
+            }
+        }
+    }
+    solution.numSvsUsed = used;
+    solution.gnssUsedMask = mask;
+}
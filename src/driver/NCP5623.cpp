@@ -11,11 +11,22 @@ NCP5623::NCP5623() {
     _red = 0;
     _green = 1;
     _blue = 2;
+    memset(shadow, 0, sizeof(shadow));
+    validMask = 0;  // Inhalt des Bausteins unbekannt, der erste Schreibzugriff geht immer raus
+    dirtyMask = 0;
+    transferMask = 0;
+    txLength = 0;
+    txIndex = 0;
+    transferActive = false;
+    transferCount = 0;
+    skippedCount = 0;
+    errorCount = 0;
 }
 
 void NCP5623::begin() {
     setCurrent(30); // this is reset to zero for some reason
     setColor(0,0,0);
+    flush();
 }
 
 void NCP5623::setColor(uint8_t red, uint8_t green, uint8_t blue) {
@@ -40,10 +51,137 @@ void NCP5623::setChannel(uint8_t channel, uint8_t value) {
     writeReg(NCP5623_REG_CHANNEL_BASE+channel, value);
 }
 
-void NCP5623::writeReg(uint8_t reg, uint8_t value) {
+void NCP5623::writeReg(uint8_t reg, uint8_t value, bool force) {
+    reg &= 0x7;
+    value &= 0x1f;
+    uint8_t bit = 1 << reg;
+    // Der Baustein hat den Wert bereits oder bekommt ihn mit einer anstehenden Übertragung
+    if (!force && shadow[reg] == value && ((validMask | dirtyMask | transferMask) & bit)) {
+        skippedCount++;
+        return;
+    }
+    shadow[reg] = value;
+    validMask &= ~bit;
+    dirtyMask |= bit;
+}
+
+void NCP5623::update() {
+    if (transferActive) {
+        pollTransfer();
+    }
+    if (!transferActive && dirtyMask != 0) {
+        startTransfer();
+    }
+}
+
+void NCP5623::flush() {
+    elapsedMicros waitTimer;
+    while (isBusy() && waitTimer < 4 * NCP5623_TRANSFER_TIMEOUT_US) {
+        update();
+    }
+}
+
+bool NCP5623::isBusy() const {
+    return transferActive || dirtyMask != 0;
+}
+
+void NCP5623::startTransfer() {
+    // Alle geänderten Register in einer Übertragung, aufsteigend nach Register
+    txLength = 0;
+    for (uint8_t reg = 0; reg < NCP5623_REG_COUNT; reg++) {
+        if (dirtyMask & (1 << reg)) {
+            txBuffer[txLength++] = (reg << 5) | shadow[reg]; // rrrvvvvv
+        }
+    }
+    transferMask = dirtyMask;
+    dirtyMask = 0;
+    transferCount++;
+
+#if NCP5623_ASYNC_I2C
+    // Wire.begin() hat LPI2C1 konfiguriert, hier werden nur Befehle in den FIFO gelegt
+    LPI2C1_MSR = LPI2C_MSR_NDF | LPI2C_MSR_ALF | LPI2C_MSR_FEF | LPI2C_MSR_SDF;
+    txIndex = 0;
+    transferActive = true;
+    transferTimer = 0;
+    pollTransfer();
+#else
     Wire.beginTransmission(_addr);
-    Wire.write(((reg&0x7)<<5)|(value&0x1f)); // rrrvvvvv
-    Wire.endTransmission();
+    Wire.write(txBuffer, txLength);
+    finishTransfer(Wire.endTransmission() == 0);
+#endif
+}
+
+void NCP5623::pollTransfer() {
+#if NCP5623_ASYNC_I2C
+    if (LPI2C1_MSR & (LPI2C_MSR_NDF | LPI2C_MSR_ALF | LPI2C_MSR_FEF)) {
+        abortTransfer();
+        return;
+    }
+
+    // START mit Adresse, ein Byte je Register, STOP; der FIFO fasst 4 Wörter
+    uint8_t words = txLength + 2;
+    uint8_t queued = txIndex;
+    while (txIndex < words && (LPI2C1_MFSR & 0x07) < 4) {
+        if (txIndex == 0) {
+            LPI2C1_MTDR = LPI2C_MTDR_CMD_START | (_addr << 1);
+        } else if (txIndex <= txLength) {
+            LPI2C1_MTDR = LPI2C_MTDR_CMD_TRANSMIT | txBuffer[txIndex - 1];
+        } else {
+            LPI2C1_MTDR = LPI2C_MTDR_CMD_STOP;
+        }
+        txIndex++;
+    }
+    if (txIndex != queued) {
+        transferTimer = 0;
+    }
+
+    // Abschluss vor der Zeitüberwachung prüfen, update() läuft seltener als die Übertragung dauert
+    if (txIndex == words && (LPI2C1_MSR & LPI2C_MSR_SDF)) {
+        LPI2C1_MSR = LPI2C_MSR_SDF;
+        finishTransfer(true);
+        return;
+    }
+
+    // Der Bus nimmt seit dem letzten Aufruf nichts mehr ab
+    if (transferTimer > NCP5623_TRANSFER_TIMEOUT_US) {
+        abortTransfer();
+    }
+#endif
+}
+
+void NCP5623::abortTransfer() {
+#if NCP5623_ASYNC_I2C
+    // FIFOs leeren, der Controller beendet die Übertragung selbst
+    LPI2C1_MCR |= LPI2C_MCR_RTF | LPI2C_MCR_RRF;
+    LPI2C1_MSR = LPI2C_MSR_NDF | LPI2C_MSR_ALF | LPI2C_MSR_FEF | LPI2C_MSR_SDF;
+#endif
+    finishTransfer(false);
+}
+
+void NCP5623::finishTransfer(bool success) {
+    transferActive = false;
+    if (success) {
+        // Während der Übertragung erneut geänderte Register bleiben ungültig
+        validMask |= transferMask & ~dirtyMask;
+    } else {
+        // Inhalt unbekannt, beim nächsten update() erneut schreiben
+        errorCount++;
+        validMask &= ~transferMask;
+        dirtyMask |= transferMask;
+    }
+    transferMask = 0;
+}
+
+uint32_t NCP5623::getTransferCount() const {
+    return transferCount;
+}
+
+uint32_t NCP5623::getSkippedCount() const {
+    return skippedCount;
+}
+
+uint32_t NCP5623::getErrorCount() const {
+    return errorCount;
 }
 
 void NCP5623::setCurrent(uint8_t iled) {
@@ -51,6 +189,31 @@ void NCP5623::setCurrent(uint8_t iled) {
     writeReg(NCP5623_REG_ILED, NCP5623_ILED_MAP[iled]);
 }
 
+void NCP5623::fadeCurrent(uint8_t iled, uint16_t duration_ms) {
+    iled = (iled>30)?30:iled;
+    uint8_t from = shadow[NCP5623_REG_ILED];
+    uint8_t to = NCP5623_ILED_MAP[iled];
+    if (from == to || duration_ms == 0) {
+        writeReg(NCP5623_REG_ILED, to);
+        return;
+    }
+
+    // Der Baustein dimmt eine Registerstufe je Stufenzeit
+    uint8_t steps = (to > from) ? (to - from) : (from - to);
+    uint16_t stepTime = (duration_ms + steps * NCP5623_DIMMING_STEP_MS / 2) / (steps * NCP5623_DIMMING_STEP_MS);
+    stepTime = constrain(stepTime, 1, 31);
+    // Das zuletzt geschriebene Zielregister legt die Richtung fest, daher beide immer schreiben.
+    // Jeder Aufruf startet die Rampe genau einmal, nur eine gescheiterte Übertragung wiederholt sie
+    writeReg(to > from ? NCP5623_REG_UPWARD : NCP5623_REG_DOWNWARD, to, true);
+    writeReg(NCP5623_REG_DIMMING, stepTime, true);
+
+    // Nach dem Dimmen steht der Zielwert im Stromregister, ohne es zu schreiben
+    uint8_t bit = 1 << NCP5623_REG_ILED;
+    shadow[NCP5623_REG_ILED] = to;
+    dirtyMask &= ~bit;
+    validMask |= bit;
+}
+
 void NCP5623::mapColors(uint8_t red, uint8_t green, uint8_t blue) {
     _red = red;
     _green = green;
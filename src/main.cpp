@@ -6,20 +6,30 @@
 #include "GPSManager.h"
 #include "StatusLEDManager.h"
 #include "BeaconMicroROSInterface.h"
+#include "TimeSync.h"
+#include "TaskScheduler.h"
 
 // Manager-Instanzen
 HatchManager hatchManager(HATCH_LEFT_PIN, HATCH_RIGHT_PIN);
 GPSManager gpsManager;
+TimeSync timeSync;
 StatusLEDManager statusLED;
 LEDAnimationController ledAnimationController;
 
-// MicroROS-Interface (enthält den LED-Strip Controller)
-BeaconMicroROSInterface rosInterface(&hatchManager, &gpsManager);
+TaskScheduler scheduler;
+
+// MicroROS-Interface (enthält den LED-Strip Controller, meldet die Task-Statistik als Diagnose)
+BeaconMicroROSInterface rosInterface(&hatchManager, &gpsManager, &timeSync, &ledAnimationController, &scheduler);
 
 // Status-Tracking
 bool rosConnected = false;
 bool previousRosConnected = false;
 
+// Jede neue GNSS-Epoche diszipliniert die lokale Uhr über die PPS-Flanke
+void onNewFix(const NavSatFixData& data, uint32_t sequence) {
+    timeSync.addGnssEpoch(data.getUnixTimeNanos(), gpsManager.getEpochArrivalMicros(), gpsManager.getEpochPPS());
+}
+
 void setup() {
     Serial.begin(115200);
     // Initialisiere Hardware-Manager
@@ -29,6 +39,8 @@ void setup() {
     ledAnimationController.begin();
 
     hatchManager.begin();
+    timeSync.begin(GPS_PPS_PIN);
+    gpsManager.setNewFixCallback(onNewFix);
     gpsManager.begin(GPS_SERIAL, GPS_BAUD);
     delay(5000);
     
@@ -40,30 +52,84 @@ void setup() {
     
     // Warte kurz für die Initialisierung
     delay(1000);
-}
-
-void loop() {
-
-    // Aktualisiere LED-Strip Animation (nicht-blockierend)
-    ledAnimationController.update();
-
-    // Aktualisiere Hardware-Manager (nicht-blockierend)
-    hatchManager.update();
-    gpsManager.update();
-
-
-    // Überprüfe MicroROS-Verbindung
-    rosInterface.update();
     
-    if (rosInterface.getConnectionState()==BeaconMicroROSInterface::WAITING_AGENT) {
-        statusLED.setStatus(LED_STATUS_ERROR);
-    } else {
-        if (gpsManager.hasValidFix()) {
-            statusLED.setStatus(LED_STATUS_CONNECTED_FIX);
-        } else {
+    // Tasks registrieren (alle non-blocking)
+    scheduler.addTask("hatch", []() {
+        hatchManager.update();
+    }, TASK_HATCH_PERIOD_US, TASK_HATCH_DEADLINE_US, TASK_HATCH_PRIORITY);
+    
+    scheduler.addTask("gps", []() {
+        // 64-Bit-Zeitbasis aktuell halten
+        timeSync.nowMicros();
+        gpsManager.update();
+    }, TASK_GPS_PERIOD_US, TASK_GPS_DEADLINE_US, TASK_GPS_PRIORITY);
+    
+    scheduler.addTask("led", []() {
+        ledAnimationController.update();
+    }, TASK_LED_PERIOD_US, TASK_LED_DEADLINE_US, TASK_LED_PRIORITY);
+    
+    scheduler.addTask("ros", []() {
+        rosInterface.update();
+    }, TASK_ROS_PERIOD_US, TASK_ROS_DEADLINE_US, TASK_ROS_PRIORITY);
+    
+    scheduler.addTask("status", []() {
+        // Wichtigster Zustand zuerst
+        if (rosInterface.getConnectionState()==BeaconMicroROSInterface::WAITING_AGENT) {
+            statusLED.setStatus(LED_STATUS_ERROR);
+        } else if (rosInterface.isLinkDegraded()) {
+            statusLED.setStatus(LED_STATUS_ROS_DEGRADED);
+        } else if (hatchManager.isHatchOpen()) {
+            statusLED.setStatus(LED_STATUS_HATCH_OPEN);
+        } else if (!gpsManager.hasValidFix()) {
             statusLED.setStatus(LED_STATUS_CONNECTED_NO_FIX);
+        } else if (gpsManager.getNavSatFixData().satellites < STATUS_LED_LOW_SATELLITES) {
+            statusLED.setStatus(LED_STATUS_LOW_SATELLITES);
+        } else {
+            statusLED.setStatus(LED_STATUS_CONNECTED_FIX);
+        }
+        statusLED.update();
+    }, TASK_STATUS_PERIOD_US, TASK_STATUS_DEADLINE_US, TASK_STATUS_PRIORITY);
+    
+    scheduler.addTask("stats", []() {
+        // Laufzeitstatistik auf Anfrage oder periodisch ausgeben:
+        // 's' Tabelle, 'h' Histogramme, 'b' Binärframe (TaskScheduler::dumpStats), 'r' zurücksetzen
+        bool print = false;
+        while (Serial.available()) {
+            switch (Serial.read()) {
+                case 's':
+                    print = true;
+                    break;
+                case 'h':
+                    scheduler.printHistograms(Serial);
+                    break;
+                case 'b':
+                    scheduler.dumpStats(Serial);
+                    break;
+                case 'r':
+                    scheduler.resetStats();
+                    break;
+                default:
+                    break;
+            }
+        }
+#if SCHEDULER_STATS_PRINT_MS > 0
+        static elapsedMillis lastPrint;
+        if (lastPrint >= SCHEDULER_STATS_PRINT_MS) {
+            lastPrint = 0;
+            print = true;
+        }
+#endif
+        if (print) {
+            scheduler.printStats(Serial);
+            ledAnimationController.printAnimationFootprint(Serial);
+            statusLED.printStats(Serial);
         }
-    } 
+    }, TASK_STATS_PERIOD_US, TASK_STATS_DEADLINE_US, TASK_STATS_PRIORITY);
     
-    statusLED.update();
+    // GNSS-Empfang erst jetzt starten, während der Wartezeiten oben liefe der Ringpuffer über
+    gpsManager.start();
+}
+
+void loop() {
+    scheduler.run();
 }
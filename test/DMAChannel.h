@@ -0,0 +1,89 @@
+#pragma once
+#include <Arduino.h>
+
+/**
+ * DMA- und UART-Ersatz für die WS2812Serial-Bibliothek in Tests (env:native)
+ *
+ * Gibt sich als Teensy 3.x (KINETISK) aus, damit WS2812Serial.cpp unverändert
+ * übersetzt. enable() setzt wie die Hardware das Bit des Kanals in DMA_ERQ,
+ * solange es steht, läuft die Übertragung. Der Test beendet sie mit
+ * complete() und prüft den übergebenen Puffer.
+ */
+
+#define KINETISK
+
+struct KINETISK_UART_t {
+    uint8_t BDH, BDL, C1, C2, C3, C4, C5, PFIFO;
+    uint8_t D;
+};
+
+inline KINETISK_UART_t KINETISK_UART0;
+inline KINETISK_UART_t KINETISK_UART1;
+inline KINETISK_UART_t KINETISK_UART2;
+inline uint32_t SIM_SCGC4;
+inline uint32_t DMA_ERQ;
+inline uint32_t portConfig[64];
+
+#define portConfigRegister(pin) (&portConfig[(pin)])
+#define BAUD2DIV(baud) (((96000000 * 2) + ((baud) >> 1)) / (baud))
+#define BAUD2DIV2(baud) (((48000000 * 2) + ((baud) >> 1)) / (baud))
+#define BAUD2DIV3(baud) (((48000000 * 2) + ((baud) >> 1)) / (baud))
+#define PORT_PCR_SRE 0x04
+#define PORT_PCR_DSE 0x40
+#define PORT_PCR_MUX(n) (((n) & 7) << 8)
+#define DMAMUX_SOURCE_UART0_TX 3
+#define DMAMUX_SOURCE_UART1_TX 5
+#define DMAMUX_SOURCE_UART2_TX 7
+#define SIM_SCGC4_UART0 0x0400
+#define SIM_SCGC4_UART1 0x0800
+#define SIM_SCGC4_UART2 0x1000
+#define UART_C2_TE 0x08
+#define UART_C2_TIE 0x80
+#define UART_C3_TXINV 0x10
+#define UART_C5_TDMAS 0x80
+
+class DMAChannel {
+public:
+    DMAChannel() : channel(allocated++) {
+        last = this;
+    }
+
+    void destination(volatile uint8_t& target) {
+        this->target = &target;
+    }
+    void triggerAtHardwareEvent(uint8_t source) {
+        trigger = source;
+    }
+    void sourceBuffer(const uint8_t* buffer, uint32_t length) {
+        source = buffer;
+        this->length = length;
+    }
+    void transferSize(uint32_t size) {}
+    void transferCount(uint32_t count) {
+        this->count = count;
+    }
+    void disableOnCompletion() {}
+    void enable() {
+        DMA_ERQ |= 1UL << channel;
+        transfers++;
+    }
+
+    // Test: laufende Übertragung abschließen
+    void complete() {
+        DMA_ERQ &= ~(1UL << channel);
+    }
+    bool active() const {
+        return (DMA_ERQ & (1UL << channel)) != 0;
+    }
+
+    uint8_t channel;
+    volatile uint8_t* target = nullptr;
+    uint8_t trigger = 0;
+    const uint8_t* source = nullptr;
+    uint32_t length = 0;
+    uint32_t count = 0;
+    uint32_t transfers = 0;
+
+    static inline uint8_t allocated = 0;
+    static inline DMAChannel* last = nullptr;    // Zuletzt angelegter Kanal
+};
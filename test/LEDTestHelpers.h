@@ -0,0 +1,36 @@
+#pragma once
+#include <Arduino.h>
+#include <unity.h>
+#include "LEDAnimationController/LEDAnimationController.h"
+
+/**
+ * Gemeinsame Hilfen der Tests für den LEDAnimationController (env:native)
+ *
+ * Befehlsparameter wie aus der Action und das Bild am LED-Treiber, so wie
+ * es nach FastLED.show() ausgegeben wird.
+ */
+
+// Ausgabe des Controllers; die globalen Objekte aus main.cpp legen ebenfalls
+// Treiber an, nur begin() verbindet einen davon mit einem LED-Array
+inline const CRGB* output() {
+    for (int i = 0; i < FastLED.count(); i++) {
+        if (FastLED[i].leds() != nullptr) {
+            return FastLED[i].leds();
+        }
+    }
+    TEST_FAIL_MESSAGE("Kein LED-Array registriert");
+    return nullptr;
+}
+
+// Parameter eines Befehls, nicht genannte Werte sind 0 (Basisebene, Standardgeschwindigkeit)
+inline void makeParams(uint8_t* params, uint8_t cmd, CRGB color, uint8_t brightness = 255,
+                       uint8_t speed = 0, uint8_t tag = 0) {
+    memset(params, 0, PARAM_COUNT);
+    params[PARAM_RED] = color.r;
+    params[PARAM_GREEN] = color.g;
+    params[PARAM_BLUE] = color.b;
+    params[PARAM_BRIGHTNESS] = brightness;
+    params[PARAM_CMD] = cmd;
+    params[PARAM_SPEED] = speed;
+    params[PARAM_MULTIUSE1] = tag;
+}
@@ -0,0 +1,151 @@
+#pragma once
+#include <Arduino.h>
+#include "BeaconSim.h"
+
+/**
+ * LPI2C1-Ersatz für den asynchronen Pfad des NCP5623-Treibers in Tests (env:native)
+ *
+ * Nachgebildet sind die Register, die der Treiber benutzt: MTDR legt Wörter
+ * in einen FIFO mit 4 Plätzen, MFSR liefert dessen Füllstand, MSR hat
+ * Write-1-to-clear-Flags, MCR leert mit RTF den FIFO. Der Bus läuft nur,
+ * wenn der Test transmit() aufruft; dann werden alle Wörter im FIFO
+ * gesendet, ein STOP setzt SDF und schließt einen Frame im Protokoll ab.
+ * Mit autoTransmit sendet der Bus bei jedem Lesen eines Statusregisters,
+ * etwa für das blockierende flush().
+ */
+
+#define LPI2C_MSR_SDF ((uint32_t)(1 << 9))
+#define LPI2C_MSR_NDF ((uint32_t)(1 << 10))
+#define LPI2C_MSR_ALF ((uint32_t)(1 << 11))
+#define LPI2C_MSR_FEF ((uint32_t)(1 << 12))
+#define LPI2C_MCR_RTF ((uint32_t)(1 << 8))
+#define LPI2C_MCR_RRF ((uint32_t)(1 << 9))
+#define LPI2C_MTDR_CMD_TRANSMIT ((uint32_t)(0 << 8))
+#define LPI2C_MTDR_CMD_STOP ((uint32_t)(2 << 8))
+#define LPI2C_MTDR_CMD_START ((uint32_t)(4 << 8))
+
+#define LPI2C_FIFO_SIZE 4
+#define LPI2C_MAX_FRAMES 256
+#define LPI2C_MAX_FRAME_LENGTH 12
+
+class LPI2CStub {
+public:
+    struct Frame {
+        uint64_t time_us;                       // Zeitpunkt des STOP
+        uint8_t length;                         // Adressbyte plus Daten
+        uint8_t data[LPI2C_MAX_FRAME_LENGTH];
+    };
+
+    struct StatusRegister {
+        uint32_t flags = 0;
+        operator uint32_t() const {
+            LPI2C1.autoRun();
+            return flags;
+        }
+        StatusRegister& operator=(uint32_t clear) {
+            flags &= ~clear;
+            return *this;
+        }
+    };
+
+    struct ControlRegister {
+        uint32_t value = 0;
+        ControlRegister& operator|=(uint32_t bits) {
+            if (bits & LPI2C_MCR_RTF) {
+                LPI2C1.fifoCount = 0;
+                LPI2C1.aborts++;
+            }
+            value |= bits & ~(LPI2C_MCR_RTF | LPI2C_MCR_RRF);
+            return *this;
+        }
+    };
+
+    struct FifoStatusRegister {
+        operator uint32_t() const {
+            LPI2C1.autoRun();
+            return LPI2C1.fifoCount;
+        }
+    };
+
+    struct TransmitDataRegister {
+        TransmitDataRegister& operator=(uint32_t word) {
+            if (LPI2C1.fifoCount < LPI2C_FIFO_SIZE) {
+                LPI2C1.fifo[LPI2C1.fifoCount++] = word;
+            } else {
+                LPI2C1.MSR.flags |= LPI2C_MSR_FEF;
+            }
+            return *this;
+        }
+    };
+
+    StatusRegister MSR;
+    ControlRegister MCR;
+    FifoStatusRegister MFSR;
+    TransmitDataRegister MTDR;
+
+    // Test: Bus sendet den FIFO-Inhalt
+    void transmit() {
+        for (uint8_t i = 0; i < fifoCount; i++) {
+            uint32_t word = fifo[i];
+            uint32_t cmd = word & 0x0700;
+            if (cmd == LPI2C_MTDR_CMD_START) {
+                open = true;
+                current = Frame{};
+                if ((uint8_t)(word >> 1) == nackAddress) {
+                    MSR.flags |= LPI2C_MSR_NDF;
+                }
+            } else if (cmd == LPI2C_MTDR_CMD_STOP) {
+                if (open && frameCount < LPI2C_MAX_FRAMES && !(MSR.flags & LPI2C_MSR_NDF)) {
+                    current.time_us = BeaconSim::now();
+                    frames[frameCount++] = current;
+                }
+                open = false;
+                MSR.flags |= LPI2C_MSR_SDF;
+                continue;
+            }
+            if (open && current.length < LPI2C_MAX_FRAME_LENGTH) {
+                current.data[current.length++] = word & 0xFF;
+            }
+        }
+        fifoCount = 0;
+    }
+
+    void reset() {
+        MSR.flags = 0;
+        MCR.value = 0;
+        fifoCount = 0;
+        frameCount = 0;
+        aborts = 0;
+        nackAddress = 0;
+        autoTransmit = false;
+        open = false;
+    }
+
+    uint32_t fifo[LPI2C_FIFO_SIZE] = {};
+    uint8_t fifoCount = 0;
+    Frame frames[LPI2C_MAX_FRAMES] = {};
+    uint32_t frameCount = 0;                    // Vollständig gesendete Frames
+    uint32_t aborts = 0;                        // FIFO durch den Treiber geleert
+    uint8_t nackAddress = 0;                    // Test: diese Adresse antwortet nicht
+    bool autoTransmit = false;                  // Test: Bus sendet bei jedem Statuszugriff
+
+    static LPI2CStub LPI2C1;                    // Einziger Controller, wie Wire auf dem Teensy
+
+private:
+    Frame current = {};
+    bool open = false;
+
+    void autoRun() {
+        if (autoTransmit) {
+            transmit();
+        }
+    }
+};
+
+inline LPI2CStub LPI2CStub::LPI2C1;
+
+#define LPI2C1 (LPI2CStub::LPI2C1)
+#define LPI2C1_MSR (LPI2C1.MSR)
+#define LPI2C1_MCR (LPI2C1.MCR)
+#define LPI2C1_MFSR (LPI2C1.MFSR)
+#define LPI2C1_MTDR (LPI2C1.MTDR)
@@ -0,0 +1,19 @@
+#pragma once
+
+/**
+ * NCP5623-Treiber mit dem asynchronen LPI2C-Pfad des Teensy 4 für Tests (env:native)
+ *
+ * Der Host-Build linkt den Treiber mit Wire, hier wird er als NCP5623HW
+ * gegen den LPI2C-Ersatz aus test/LPI2C.h übersetzt. StatusLEDManagerHW
+ * benutzt diesen Treiber. Vor diesem Header darf driver/NCP5623.h nicht
+ * eingebunden sein.
+ */
+#include "LPI2C.h"
+
+#define NCP5623_ASYNC_I2C 1
+#define NCP5623 NCP5623HW
+#define StatusLEDManager StatusLEDManagerHW
+#include "../src/driver/NCP5623.cpp"
+#include "../src/StatusLEDManager.cpp"
+#undef StatusLEDManager
+#undef NCP5623
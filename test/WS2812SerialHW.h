@@ -0,0 +1,14 @@
+#pragma once
+
+/**
+ * Die WS2812Serial-Bibliothek aus lib/ für Tests (env:native)
+ *
+ * Der Host-Build linkt den Ersatz aus sim/ mit demselben Klassennamen, die
+ * Bibliothek wird deshalb hier als WS2812SerialHW in die Test-Übersetzungs-
+ * einheit übernommen. DMA und UART kommen aus test/DMAChannel.h.
+ */
+#include "DMAChannel.h"
+
+#define WS2812Serial WS2812SerialHW
+#include "../lib/WS2812Serial-master/WS2812Serial.cpp"
+#undef WS2812Serial
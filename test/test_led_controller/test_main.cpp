@@ -0,0 +1,168 @@
+#include <Arduino.h>
+#include <unity.h>
+#include "BeaconSim.h"
+#include "LEDAnimationController/LEDAnimationController.h"
+#include "LEDTestHelpers.h"
+
+/**
+ * LEDAnimationController auf dem Host: Befehle über startAnimation(), die
+ * Frames laufen mit der simulierten Uhr, geprüft wird das zusammengesetzte
+ * Bild am LED-Treiber.
+ */
+
+#define CMD_UNKNOWN 77
+
+namespace {
+
+// Nur ein Controller für alle Tests, FastLED behält den registrierten Treiber
+LEDAnimationController controller;
+uint32_t results;
+bool lastSuccess;
+uint8_t lastResultLayer;
+AnimationStatus feedbackStatus[LED_LAYER_COUNT];
+uint32_t feedbacks[LED_LAYER_COUNT];
+
+void onResult(uint8_t layer, bool success, AnimationStatus) {
+    results++;
+    lastSuccess = success;
+    lastResultLayer = layer;
+}
+
+void onFeedback(uint8_t layer, float, AnimationStatus status) {
+    TEST_ASSERT_LESS_THAN_UINT8(LED_LAYER_COUNT, layer);
+    feedbackStatus[layer] = status;
+    feedbacks[layer]++;
+}
+
+// Controller für die angegebene Zeit im Frame-Takt laufen lassen
+void runFor(uint32_t duration_us) {
+    for (uint32_t t = 0; t < duration_us; t += LED_FRAME_INTERVAL_US / 2) {
+        BeaconSim::advance(LED_FRAME_INTERVAL_US / 2);
+        controller.update();
+    }
+}
+
+}  // namespace
+
+void setUp(void) {
+    results = 0;
+    lastSuccess = false;
+    lastResultLayer = 0xFF;
+    memset(feedbacks, 0, sizeof(feedbacks));
+    controller.setResultCallback(onResult);
+    controller.setFeedbackCallback(onFeedback);
+}
+
+void tearDown(void) {}
+
+void test_revoked_command_keeps_running_animation(void) {
+    // Rot blinkend, 50 Wiederholungen mit je 200 ms
+    uint8_t params[PARAM_COUNT];
+    makeParams(params, CMD_BLINK, CRGB::Red, 200);
+    params[PARAM_MULTIUSE1] = 50;
+    controller.startAnimation(1, params);
+    TEST_ASSERT_TRUE(lastSuccess);
+    runFor(300000);
+    AnimationStatus running = controller.getStatus();
+
+    // Unbekannter Befehl mit anderer Farbe und Helligkeit
+    makeParams(params, CMD_UNKNOWN, CRGB::Blue, 10);
+    controller.startAnimation(2, params);
+    TEST_ASSERT_EQUAL_UINT32(2, results);
+    TEST_ASSERT_FALSE(lastSuccess);
+    TEST_ASSERT_EQUAL_UINT8(200, FastLED.getBrightness());
+    TEST_ASSERT_EQUAL(running, controller.getStatus());
+
+    // Die laufende Animation zeigt weiter nur ihre eigene Farbe
+    bool sawRed = false;
+    for (uint32_t frame = 0; frame < 100; frame++) {
+        runFor(LED_FRAME_INTERVAL_US);
+        const CRGB* leds = output();
+        for (uint16_t i = 0; i < NUM_LEDS; i++) {
+            TEST_ASSERT_EQUAL_UINT8_MESSAGE(0, leds[i].b, "Farbe des abgelehnten Befehls sichtbar");
+            TEST_ASSERT_EQUAL_UINT8(0, leds[i].g);
+            sawRed |= leds[i].r > 0;
+        }
+    }
+    TEST_ASSERT_TRUE(sawRed);
+}
+
+void test_unknown_layer_is_revoked(void) {
+    uint8_t params[PARAM_COUNT];
+    makeParams(params, CMD_SET_COLOR, CRGB::Green, 50);
+    params[PARAM_MODIFIER] = PAR_LAYER_LOW | PAR_LAYER_HIGH;   // Ebene 3 gibt es nicht
+    controller.startAnimation(1, params);
+    TEST_ASSERT_EQUAL_UINT32(1, results);
+    TEST_ASSERT_FALSE(lastSuccess);
+
+    // Überlagerungen haben nur Animationen ohne eigene Frames
+    makeParams(params, CMD_ALL_FADE_IN, CRGB::Green, 50);
+    params[PARAM_MODIFIER] = PAR_LAYER_LOW;
+    controller.startAnimation(2, params);
+    TEST_ASSERT_EQUAL_UINT32(2, results);
+    TEST_ASSERT_FALSE(lastSuccess);
+    TEST_ASSERT_FALSE(controller.cancelAnimation(1));
+
+    TEST_ASSERT_EQUAL_UINT8(200, FastLED.getBrightness());
+
+    // Die Blink-Animation des vorigen Tests läuft weiter, Grün taucht nicht auf
+    for (uint32_t frame = 0; frame < 20; frame++) {
+        runFor(LED_FRAME_INTERVAL_US);
+        const CRGB* leds = output();
+        for (uint16_t i = 0; i < NUM_LEDS; i++) {
+            TEST_ASSERT_EQUAL_UINT8(0, leds[i].g);
+        }
+    }
+}
+
+void test_overlay_status_is_separate_from_base(void) {
+    // Regenbogen auf der Basisebene, darüber dreimal Blau blinkend (300 ms)
+    uint8_t params[PARAM_COUNT];
+    makeParams(params, CMD_RGB_RAINBOW, CRGB::Black, 200);
+    controller.startAnimation(1, params);
+    TEST_ASSERT_EQUAL_UINT8(0, lastResultLayer);
+    runFor(100000);
+    TEST_ASSERT_EQUAL(STATUS_RUNNING_CONTINUOUS, controller.getStatus(0));
+
+    makeParams(params, CMD_BLINK, CRGB::Blue, 255);
+    params[PARAM_SPEED] = 10;
+    params[PARAM_MODIFIER] = PAR_LAYER_LOW;
+    params[PARAM_MULTIUSE1] = 3;
+    controller.startAnimation(2, params);
+    TEST_ASSERT_TRUE(lastSuccess);
+    TEST_ASSERT_EQUAL_UINT8(1, lastResultLayer);
+    TEST_ASSERT_EQUAL(STATUS_STARTED, controller.getStatus(1));
+    TEST_ASSERT_EQUAL(STATUS_RUNNING_CONTINUOUS, controller.getStatus(0));
+    runFor(100000);
+    TEST_ASSERT_EQUAL(STATUS_RUNNING, controller.getStatus(1));
+    TEST_ASSERT_EQUAL(STATUS_RUNNING, feedbackStatus[1]);
+    TEST_ASSERT_EQUAL(STATUS_RUNNING_CONTINUOUS, feedbackStatus[0]);
+
+    // Die Überlagerung ist fertig, der Regenbogen läuft weiter und meldet sich weiter
+    runFor(400000);
+    TEST_ASSERT_EQUAL(STATUS_COMPLETED, controller.getStatus(1));
+    TEST_ASSERT_EQUAL(STATUS_COMPLETED, controller.getStatus());
+    TEST_ASSERT_EQUAL(STATUS_RUNNING_CONTINUOUS, controller.getStatus(0));
+    uint32_t baseFeedbacks = feedbacks[0];
+    uint32_t overlayFeedbacks = feedbacks[1];
+    runFor(200000);
+    TEST_ASSERT_GREATER_THAN_UINT32(baseFeedbacks + 10, feedbacks[0]);
+    TEST_ASSERT_EQUAL_UINT32(overlayFeedbacks, feedbacks[1]);
+
+    // Abbrechen trifft nur die angegebene Ebene
+    TEST_ASSERT_FALSE(controller.cancelAnimation(1));
+    TEST_ASSERT_EQUAL(STATUS_RUNNING_CONTINUOUS, controller.getStatus(0));
+    TEST_ASSERT_TRUE(controller.cancelAnimation(0));
+    TEST_ASSERT_EQUAL_UINT8(0, lastResultLayer);
+    TEST_ASSERT_EQUAL(STATUS_CANCELED, controller.getStatus(0));
+    TEST_ASSERT_EQUAL(STATUS_COMPLETED, controller.getStatus(1));
+}
+
+int main(int argc, char** argv) {
+    controller.begin();
+    UNITY_BEGIN();
+    RUN_TEST(test_revoked_command_keeps_running_animation);
+    RUN_TEST(test_unknown_layer_is_revoked);
+    RUN_TEST(test_overlay_status_is_separate_from_base);
+    return UNITY_END();
+}
@@ -0,0 +1,161 @@
+#include <Arduino.h>
+#include <unity.h>
+#include <new>
+#include <stdlib.h>
+#include "BeaconSim.h"
+#include "LEDAnimationController/LEDAnimationController.h"
+
+/**
+ * Dauertest für Blink und FadeBlink: tausende Befehle, ein Teil davon vor
+ * dem Ende durch den nächsten abgebrochen, dazwischen Stillstände der
+ * Hauptschleife. Nach begin() darf dabei kein einziges new stattfinden.
+ * Gezählt wird über die globalen Operatoren in dieser Datei.
+ */
+
+#define SOAK_COMMANDS 5000
+
+namespace {
+
+uint32_t allocations;
+
+}  // namespace
+
+void* operator new(size_t size) {
+    allocations++;
+    void* p = malloc(size ? size : 1);
+    if (p == nullptr) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* p) noexcept {
+    free(p);
+}
+
+void operator delete[](void* p) noexcept {
+    free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    free(p);
+}
+
+void operator delete[](void* p, size_t) noexcept {
+    free(p);
+}
+
+namespace {
+
+LEDAnimationController controller;
+uint32_t lcgState;
+uint32_t completedEvents;
+uint32_t canceledEvents;
+
+uint32_t random32() {
+    lcgState = lcgState * 1664525UL + 1013904223UL;
+    return lcgState >> 8;
+}
+
+void onEvent(AnimationStatus status) {
+    if (status == STATUS_COMPLETED) {
+        completedEvents++;
+    } else if (status == STATUS_CANCELED) {
+        canceledEvents++;
+    }
+}
+
+void startBlink(uint8_t cmd, uint8_t speed, uint8_t repeats) {
+    uint8_t params[PARAM_COUNT] = {};
+    params[PARAM_RED] = random32() & 0xFF;
+    params[PARAM_GREEN] = random32() & 0xFF;
+    params[PARAM_BLUE] = random32() & 0xFF;
+    params[PARAM_BRIGHTNESS] = 255;
+    params[PARAM_CMD] = cmd;
+    params[PARAM_SPEED] = speed;
+    params[PARAM_MULTIUSE1] = repeats;
+    controller.startAnimation(1, params);
+}
+
+// Hauptschleife mit 2 ms Takt, gelegentlich steht sie bis zu 300 ms
+void runFor(uint32_t duration_ms) {
+    uint64_t end = BeaconSim::now() + (uint64_t)duration_ms * 1000;
+    while (BeaconSim::now() < end) {
+        BeaconSim::advance((random32() % 64) == 0 ? random32() % 300000 : 2000);
+        controller.update();
+    }
+}
+
+}  // namespace
+
+void setUp(void) {
+    lcgState = 4711;
+    completedEvents = 0;
+    canceledEvents = 0;
+    controller.setEventCallback(onEvent);
+}
+
+void tearDown(void) {}
+
+void test_composite_fixed_capacity(void) {
+    CompositeAnimation sequence;
+    allocations = 0;
+    for (uint8_t round = 0; round < 3; round++) {
+        sequence.clear();
+        for (uint8_t i = 0; i < COMPOSITE_MAX_STEPS; i++) {
+            TEST_ASSERT_TRUE(sequence.addWait(10));
+        }
+        TEST_ASSERT_FALSE(sequence.addWait(10));
+        TEST_ASSERT_FALSE(sequence.addAnimation(&sequence));
+
+        uint32_t start = millis();
+        TEST_ASSERT_TRUE(sequence.startAt(start));
+        sequence.run(start + 35);
+        TEST_ASSERT_FALSE(sequence.isCompleted());
+        // Ein später Aufruf schließt alle fälligen Wartezeiten auf dem Plan ab
+        sequence.run(start + COMPOSITE_MAX_STEPS * 10 + 500);
+        TEST_ASSERT_TRUE(sequence.isCompleted());
+        TEST_ASSERT_EQUAL_UINT32(start + COMPOSITE_MAX_STEPS * 10, sequence.getEndTime());
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, allocations);
+}
+
+void test_blink_soak_without_allocation(void) {
+    allocations = 0;
+    for (uint32_t i = 0; i < SOAK_COMMANDS; i++) {
+        // Blink: Zyklus 10 * speed ms, FadeBlink: je 150 Schritte ein- und ausblenden
+        bool fade = (i & 1) != 0;
+        uint8_t speed = fade ? 1 + random32() % 4 : 2 + random32() % 10;
+        uint8_t repeats = 1 + random32() % 3;
+        startBlink(fade ? CMD_FADE_BLINK : CMD_BLINK, speed, repeats);
+
+        // Etwa jeder vierte Befehl wird vor seinem Ende abgelöst
+        uint32_t cycle_ms = fade ? 2 * 150 * speed : 2 * speed * 5;
+        uint32_t duration_ms = repeats * cycle_ms * 2 + 50;
+        runFor((random32() % 4) == 0 ? random32() % cycle_ms : duration_ms);
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, allocations);
+
+    // Jeder Befehl endet genau einmal, abgebrochen oder abgeschlossen
+    runFor(5000);
+    TEST_ASSERT_EQUAL(STATUS_COMPLETED, controller.getStatus());
+    TEST_ASSERT_EQUAL_UINT32(SOAK_COMMANDS, completedEvents + canceledEvents);
+    TEST_ASSERT_GREATER_THAN_UINT32(SOAK_COMMANDS / 2, completedEvents);
+
+    char line[96];
+    snprintf(line, sizeof(line), "%u Befehle: %u abgeschlossen, %u abgebrochen, 0 Allokationen",
+             SOAK_COMMANDS, (unsigned)completedEvents, (unsigned)canceledEvents);
+    TEST_MESSAGE(line);
+}
+
+int main(int argc, char** argv) {
+    controller.begin();
+    UNITY_BEGIN();
+    RUN_TEST(test_composite_fixed_capacity);
+    RUN_TEST(test_blink_soak_without_allocation);
+    return UNITY_END();
+}
@@ -0,0 +1,170 @@
+#include <Arduino.h>
+#include <unity.h>
+#include "BeaconSim.h"
+#include "LEDAnimationController/LEDAnimationController.h"
+#include "LEDTestHelpers.h"
+
+/**
+ * Zeitbasierte Animationsschritte: jeder Befehl läuft einmal im festen
+ * Frame-Takt und einmal mit einem Stillstand der Hauptschleife. Nach dem
+ * Stillstand muss das Bild dem ungestörten Lauf zur selben Zeit entsprechen,
+ * ohne dass versäumte Frames nachgeholt werden. Fortschritt und Ende folgen
+ * der verstrichenen Zeit.
+ */
+
+#define MAX_FRAMES 160
+#define NO_STALL 0xFFFFFFFF
+
+namespace {
+
+struct Run {
+    uint32_t elapsed[MAX_FRAMES];     // ms seit dem ersten Frame der Animation
+    CRGB pixels[MAX_FRAMES][NUM_LEDS];
+    float progress[MAX_FRAMES];
+    uint32_t count;
+    int32_t completedAt;              // ms, -1 solange nicht abgeschlossen
+};
+
+LEDAnimationController controller;
+Run steady;
+Run stalled;
+float lastProgress;
+
+void onFeedback(uint8_t, float progress, AnimationStatus) {
+    lastProgress = progress;
+}
+
+void tick(uint32_t step_us) {
+    BeaconSim::advance(step_us);
+    controller.update();
+}
+
+// Befehl von Schwarz aus ausführen, im Frame stallFrame steht die Schleife stall_ms lang
+void record(Run& run, uint8_t* params, uint32_t frames, uint32_t stallFrame, uint32_t stall_ms) {
+    uint8_t black[PARAM_COUNT];
+    makeParams(black, CMD_SET_COLOR, CRGB::Black);
+    controller.startAnimation(1, black);
+    for (uint8_t i = 0; i < 10; i++) {
+        tick(LED_FRAME_INTERVAL_US);
+    }
+
+    controller.startAnimation(2, params);
+    tick(LED_FRAME_INTERVAL_US);            // Die Animation startet in diesem Frame
+    uint32_t start = millis();
+    run.count = 0;
+    run.completedAt = -1;
+
+    for (uint32_t frame = 0; frame < frames && run.count < MAX_FRAMES; frame++) {
+        uint32_t framesBefore = controller.getFrameCount();
+        uint32_t deferredBefore = controller.getDeferredFrameCount();
+        tick(frame == stallFrame ? stall_ms * 1000 : LED_FRAME_INTERVAL_US);
+
+        // Höchstens ein Frame je Durchlauf, auch direkt nach dem Stillstand
+        TEST_ASSERT_LESS_OR_EQUAL_UINT32(framesBefore + 1, controller.getFrameCount());
+        TEST_ASSERT_EQUAL_UINT32(deferredBefore, controller.getDeferredFrameCount());
+
+        uint32_t i = run.count++;
+        run.elapsed[i] = millis() - start;
+        memcpy(run.pixels[i], output(), sizeof(run.pixels[i]));
+        run.progress[i] = lastProgress;
+        if (run.completedAt < 0 && controller.getStatus() == STATUS_COMPLETED) {
+            run.completedAt = run.elapsed[i];
+        }
+    }
+}
+
+// Frames beider Läufe mit gleicher verstrichener Zeit müssen gleich aussehen
+uint32_t compareAfter(uint32_t from_ms) {
+    uint32_t compared = 0;
+    for (uint32_t i = 0; i < stalled.count; i++) {
+        if (stalled.elapsed[i] < from_ms) {
+            continue;
+        }
+        for (uint32_t j = 0; j < steady.count; j++) {
+            if (steady.elapsed[j] == stalled.elapsed[i]) {
+                TEST_ASSERT_EQUAL_MEMORY_MESSAGE(steady.pixels[j], stalled.pixels[i], sizeof(steady.pixels[j]),
+                                                 "Bild nach dem Stillstand weicht ab");
+                compared++;
+                break;
+            }
+        }
+    }
+    return compared;
+}
+
+void assertCompletedNear(const Run& run, uint32_t plannedEnd_ms) {
+    TEST_ASSERT_TRUE_MESSAGE(run.completedAt >= 0, "Animation nicht abgeschlossen");
+    TEST_ASSERT_GREATER_OR_EQUAL_INT32(plannedEnd_ms, run.completedAt);
+    TEST_ASSERT_LESS_OR_EQUAL_INT32(plannedEnd_ms + LED_FRAME_INTERVAL_US / 1000 + 1, run.completedAt);
+}
+
+}  // namespace
+
+void setUp(void) {
+    lastProgress = 0.0f;
+    controller.setFeedbackCallback(onFeedback);
+}
+
+void tearDown(void) {}
+
+void test_fade_after_stall_matches_timeline(void) {
+    // 100 Schritte zu 10 ms
+    uint8_t params[PARAM_COUNT];
+    makeParams(params, CMD_ALL_FADE_IN, CRGB(200, 80, 10), 255, 10, 100);
+    record(steady, params, 120, NO_STALL, 0);
+    record(stalled, params, 90, 30, 300);
+
+    TEST_ASSERT_GREATER_THAN_UINT32(25, compareAfter(320));
+    assertCompletedNear(steady, 1000);
+    assertCompletedNear(stalled, 1000);
+}
+
+void test_cyclone_after_stall_matches_timeline(void) {
+    // Ein Durchlauf über alle LEDs, 20 ms je Schritt
+    uint8_t params[PARAM_COUNT];
+    makeParams(params, CMD_CYCLONE, CRGB::Blue, 255, 20, 40);
+    record(steady, params, 100, NO_STALL, 0);
+    record(stalled, params, 85, 20, 150);
+
+    TEST_ASSERT_GREATER_THAN_UINT32(25, compareAfter(170));
+    assertCompletedNear(steady, NUM_LEDS * 20);
+    assertCompletedNear(stalled, NUM_LEDS * 20);
+}
+
+void test_blink_stall_longer_than_cycle(void) {
+    // 5 Zyklen zu 100 ms, der Stillstand überspringt mehr als zwei davon
+    uint8_t params[PARAM_COUNT];
+    makeParams(params, CMD_BLINK, CRGB::Green, 255, 10, 5);
+    record(stalled, params, 60, 10, 250);
+
+    assertCompletedNear(stalled, 500);
+    for (uint32_t i = 0; i < stalled.count; i++) {
+        if ((int32_t)stalled.elapsed[i] >= stalled.completedAt) {
+            break;
+        }
+        TEST_ASSERT_FLOAT_WITHIN(0.05f, stalled.elapsed[i] / 500.0f, stalled.progress[i]);
+    }
+}
+
+void test_cubic_easing_reaches_target_monotonic(void) {
+    // Kurz vor dem Ende darf der Anteil nicht über 0xFFFF hinaus auf 0 zurückspringen
+    Crossfade crossfade;
+    crossfade.setEasing(EASE_IN_OUT_CUBIC);
+    uint16_t previous = 0;
+    for (uint32_t step = 0; step <= 0xFFFF; step++) {
+        uint16_t amount = crossfade.fraction(step, 0xFFFF);
+        TEST_ASSERT_GREATER_OR_EQUAL_UINT16(previous, amount);
+        previous = amount;
+    }
+    TEST_ASSERT_EQUAL_HEX16(0xFFFF, previous);
+}
+
+int main(int argc, char** argv) {
+    controller.begin();
+    UNITY_BEGIN();
+    RUN_TEST(test_fade_after_stall_matches_timeline);
+    RUN_TEST(test_cyclone_after_stall_matches_timeline);
+    RUN_TEST(test_blink_stall_longer_than_cycle);
+    RUN_TEST(test_cubic_easing_reaches_target_monotonic);
+    return UNITY_END();
+}
@@ -0,0 +1,234 @@
+#include <Arduino.h>
+#include <unity.h>
+#include "BeaconSim.h"
+#include "NCP5623HW.h"
+
+/**
+ * NCP5623 über den asynchronen LPI2C-Pfad: update() läuft wie im Status-Task
+ * nur alle TASK_STATUS_PERIOD_US, der Bus sendet zwischen zwei Aufrufen.
+ * Eine normal abgeschlossene Übertragung darf dabei nicht als Zeitüberschreitung
+ * gelten und nicht wiederholt werden. Die Muster des StatusLEDManager müssen
+ * je Schritt genau eine Übertragung erzeugen, Rampen mit passender Stufenzeit.
+ */
+
+#define NCP_ADDR_BYTE (NCP5623_DEFAULT_ADDR << 1)
+#define POLL_MS (TASK_STATUS_PERIOD_US / 1000)
+
+namespace {
+
+// Treiber anlegen und mit sofort sendendem Bus initialisieren
+void beginDriver(NCP5623HW& led) {
+    LPI2C1.reset();
+    LPI2C1.autoTransmit = true;
+    led.begin();
+    TEST_ASSERT_FALSE(led.isBusy());
+    LPI2C1.autoTransmit = false;
+    LPI2C1.frameCount = 0;
+}
+
+// Ein Durchlauf des Status-Tasks, danach läuft der Bus bis zum nächsten
+void poll(NCP5623HW& led) {
+    led.update();
+    BeaconSim::advance(TASK_STATUS_PERIOD_US);
+    LPI2C1.transmit();
+}
+
+uint8_t command(uint8_t reg, uint8_t value) {
+    return (reg << 5) | value;
+}
+
+bool frameContains(const LPI2CStub::Frame& frame, uint8_t byte) {
+    for (uint8_t i = 1; i < frame.length; i++) {
+        if (frame.data[i] == byte) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Muster über den asynchronen Pfad abspielen und den I2C-Verlauf gegen die Schritte prüfen
+void checkPatternStream(BeaconLEDStatus status, uint32_t duration_ms) {
+    StatusLEDManagerHW manager;
+    LPI2C1.reset();
+    LPI2C1.autoTransmit = true;
+    manager.begin();
+    LPI2C1.autoTransmit = false;
+
+    // Von statischem Blau mit vollem Strom aus starten
+    manager.setStatus(LED_STATUS_CONNECTED_FIX);
+    for (uint8_t i = 0; i < 5; i++) {
+        manager.update();
+        BeaconSim::advance(TASK_STATUS_PERIOD_US);
+        LPI2C1.transmit();
+    }
+    LPI2C1.frameCount = 0;
+    uint8_t level = NCP5623_ILED_MAP[StatusLEDPatterns::MAX_CURRENT];
+
+    uint32_t start = millis();
+    manager.setStatus(status);
+    while (millis() - start < duration_ms) {
+        manager.update();
+        BeaconSim::advance(TASK_STATUS_PERIOD_US);
+        LPI2C1.transmit();
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, LPI2C1.aborts);
+
+    // Jeder Schritt: höchstens eine Übertragung kurz nach seinem Beginn
+    const StatusPattern& pattern = StatusLEDPatterns::PATTERNS[status];
+    uint32_t frameIndex = 0;
+    uint32_t keyframes = 0;
+    uint32_t ramps = 0;
+    for (uint32_t t = 0; t + 2 * POLL_MS < duration_ms; keyframes++) {
+        const StatusKeyframe& key = pattern.frames[keyframes % pattern.count];
+        uint64_t from_us = (uint64_t)(start + t) * 1000;
+        uint64_t until_us = from_us + 2 * TASK_STATUS_PERIOD_US;
+        uint32_t inWindow = 0;
+        uint32_t match = frameIndex;
+        while (frameIndex < LPI2C1.frameCount && LPI2C1.frames[frameIndex].time_us < until_us) {
+            TEST_ASSERT_TRUE_MESSAGE(LPI2C1.frames[frameIndex].time_us >= from_us, "Übertragung außerhalb eines Schritts");
+            inWindow++;
+            frameIndex++;
+        }
+        TEST_ASSERT_LESS_OR_EQUAL_UINT32(1, inWindow);
+
+        uint8_t to = NCP5623_ILED_MAP[key.current];
+        if (key.rampMs > 0 && to != level) {
+            // Rampe: Zielregister für die Richtung und Stufenzeit, die das Dimmen startet
+            uint8_t steps = (to > level) ? (to - level) : (level - to);
+            uint16_t stepTime = (key.rampMs + steps * NCP5623_DIMMING_STEP_MS / 2) / (steps * NCP5623_DIMMING_STEP_MS);
+            TEST_ASSERT_EQUAL_UINT32_MESSAGE(1, inWindow, "Rampe ohne Übertragung");
+            const LPI2CStub::Frame& frame = LPI2C1.frames[match];
+            TEST_ASSERT_TRUE(frameContains(frame, command(to > level ? NCP5623_REG_UPWARD : NCP5623_REG_DOWNWARD, to)));
+            TEST_ASSERT_TRUE(frameContains(frame, command(NCP5623_REG_DIMMING, constrain(stepTime, 1, 31))));
+            ramps++;
+        }
+        level = to;
+        t += StatusLEDPatterns::frameDuration(key);
+    }
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(frameIndex, LPI2C1.frameCount, "Wiederholte Übertragung innerhalb eines Schritts");
+    TEST_ASSERT_GREATER_THAN_UINT32(2, ramps);
+
+    char line[96];
+    snprintf(line, sizeof(line), "Muster %u: %lu Schritte, %lu Übertragungen, %lu Rampen",
+             status, (unsigned long)keyframes, (unsigned long)LPI2C1.frameCount, (unsigned long)ramps);
+    TEST_MESSAGE(line);
+}
+
+}  // namespace
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+void test_transfer_completes_between_polls(void) {
+    NCP5623HW led;
+    beginDriver(led);
+    uint32_t transfers = led.getTransferCount();
+
+    led.setRed(255);
+    for (uint8_t i = 0; i < 10; i++) {
+        poll(led);
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(0, led.getErrorCount());
+    TEST_ASSERT_EQUAL_UINT32(transfers + 1, led.getTransferCount());
+    TEST_ASSERT_EQUAL_UINT32(1, LPI2C1.frameCount);
+    TEST_ASSERT_FALSE(led.isBusy());
+    const uint8_t expected[] = { NCP_ADDR_BYTE, command(NCP5623_REG_CHANNEL_BASE, 31) };
+    TEST_ASSERT_EQUAL_UINT8(sizeof(expected), LPI2C1.frames[0].length);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, LPI2C1.frames[0].data, sizeof(expected));
+}
+
+void test_transfer_longer_than_fifo(void) {
+    NCP5623HW led;
+    beginDriver(led);
+
+    // Strom und drei Kanäle: START, 4 Bytes, STOP passen nicht in einen FIFO mit 4 Wörtern
+    led.setCurrent(10);
+    led.setColor(255, 128, 64);
+    for (uint8_t i = 0; i < 10; i++) {
+        poll(led);
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(0, led.getErrorCount());
+    TEST_ASSERT_EQUAL_UINT32(1, LPI2C1.frameCount);
+    const uint8_t expected[] = {
+        NCP_ADDR_BYTE,
+        command(NCP5623_REG_ILED, 28),
+        command(NCP5623_REG_CHANNEL_BASE + 0, 31),
+        command(NCP5623_REG_CHANNEL_BASE + 1, 16),
+        command(NCP5623_REG_CHANNEL_BASE + 2, 8),
+    };
+    TEST_ASSERT_EQUAL_UINT8(sizeof(expected), LPI2C1.frames[0].length);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, LPI2C1.frames[0].data, sizeof(expected));
+}
+
+void test_stalled_bus_times_out_and_retries(void) {
+    NCP5623HW led;
+    beginDriver(led);
+
+    // Der Bus nimmt nichts ab: Abbruch nach der Zeitüberwachung, nicht früher
+    led.setGreen(255);
+    led.update();
+    BeaconSim::advance(NCP5623_TRANSFER_TIMEOUT_US / 2);
+    led.update();
+    TEST_ASSERT_EQUAL_UINT32(0, led.getErrorCount());
+    BeaconSim::advance(NCP5623_TRANSFER_TIMEOUT_US);
+    led.update();
+    TEST_ASSERT_EQUAL_UINT32(1, led.getErrorCount());
+    TEST_ASSERT_EQUAL_UINT32(1, LPI2C1.aborts);
+
+    // Der Abbruch startet die Wiederholung sofort, danach läuft der Bus wieder
+    for (uint8_t i = 0; i < 10; i++) {
+        poll(led);
+    }
+    TEST_ASSERT_EQUAL_UINT32(1, led.getErrorCount());
+    TEST_ASSERT_EQUAL_UINT32(1, LPI2C1.frameCount);
+    TEST_ASSERT_EQUAL_HEX8(command(NCP5623_REG_CHANNEL_BASE + 1, 31), LPI2C1.frames[0].data[1]);
+    TEST_ASSERT_FALSE(led.isBusy());
+}
+
+void test_nack_retries_until_acknowledged(void) {
+    NCP5623HW led;
+    beginDriver(led);
+
+    LPI2C1.nackAddress = NCP5623_DEFAULT_ADDR;
+    led.setBlue(255);
+    poll(led);
+    poll(led);
+    TEST_ASSERT_EQUAL_UINT32(1, led.getErrorCount());
+    TEST_ASSERT_TRUE(led.isBusy());
+
+    // Die laufende Wiederholung scheitert noch, die nächste kommt an
+    LPI2C1.nackAddress = 0;
+    for (uint8_t i = 0; i < 10; i++) {
+        poll(led);
+    }
+    TEST_ASSERT_EQUAL_UINT32(2, led.getErrorCount());
+    TEST_ASSERT_EQUAL_UINT32(1, LPI2C1.frameCount);
+    TEST_ASSERT_FALSE(led.isBusy());
+}
+
+void test_connecting_pulse_stream(void) {
+    checkPatternStream(LED_STATUS_CONNECTING, 3000);
+}
+
+void test_low_satellites_pulse_stream(void) {
+    checkPatternStream(LED_STATUS_LOW_SATELLITES, 5000);
+}
+
+void test_ros_degraded_pulse_stream(void) {
+    checkPatternStream(LED_STATUS_ROS_DEGRADED, 3000);
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_transfer_completes_between_polls);
+    RUN_TEST(test_transfer_longer_than_fifo);
+    RUN_TEST(test_stalled_bus_times_out_and_retries);
+    RUN_TEST(test_nack_retries_until_acknowledged);
+    RUN_TEST(test_connecting_pulse_stream);
+    RUN_TEST(test_low_satellites_pulse_stream);
+    RUN_TEST(test_ros_degraded_pulse_stream);
+    return UNITY_END();
+}
@@ -0,0 +1,245 @@
+#include <Arduino.h>
+#include <unity.h>
+#include <chrono>
+#include <string>
+#include "NMEAParser.h"
+
+#if __has_include(<TinyGPS++.h>)
+#include <TinyGPS++.h>
+#define HAVE_TINYGPSPLUS 1
+#else
+#define HAVE_TINYGPSPLUS 0
+#endif
+
+/**
+ * NMEAParser: Feldauswertung, Prüfsumme, Satzgrenzen über Blockgrenzen hinweg
+ * und ein Durchsatzvergleich mit TinyGPSPlus (sofern in lib_deps vorhanden)
+ * auf einem synthetischen Mitschnitt.
+ */
+
+namespace {
+
+const char GGA[] = "$GNGGA,120000.00,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*79\r\n";
+const char RMC[] = "$GNRMC,120000.00,A,4807.038,N,01131.000,E,0.5,84.4,161026,,,A*7E\r\n";
+
+uint8_t feed(NMEAParser& parser, const char* text) {
+    return parser.feed((const uint8_t*)text, strlen(text));
+}
+
+// Hängt "*hh\r\n" an den Satzinhalt an
+void appendSentence(std::string& out, const char* body) {
+    char tail[8];
+    snprintf(tail, sizeof(tail), "*%02X\r\n", NMEAParser::computeChecksum(body, strlen(body)));
+    out += '$';
+    out += body;
+    out += tail;
+}
+
+// Mitschnitt mit RMC, GSA und GGA je Epoche, Position und Zeit ändern sich
+std::string makeCapture(uint32_t epochs) {
+    std::string capture;
+    char body[NMEA_MAX_SENTENCE_LENGTH];
+    for (uint32_t i = 0; i < epochs; i++) {
+        uint32_t t = 120000 + (i / 60) * 100 + i % 60;
+        uint32_t lat = 7038 + i % 1000;
+        uint32_t lon = 31000 + (i * 7) % 1000;
+        snprintf(body, sizeof(body), "GNRMC,%06lu.00,A,48%02lu.%03lu,N,011%02lu.%03lu,E,0.5,84.4,161026,,,A",
+                 (unsigned long)t, (unsigned long)(lat / 1000), (unsigned long)(lat % 1000),
+                 (unsigned long)(lon / 1000), (unsigned long)(lon % 1000));
+        appendSentence(capture, body);
+        appendSentence(capture, "GNGSA,A,3,04,05,09,12,24,25,29,,,,,,1.8,0.9,1.5,1");
+        snprintf(body, sizeof(body), "GNGGA,%06lu.00,48%02lu.%03lu,N,011%02lu.%03lu,E,1,08,0.9,545.4,M,46.9,M,,",
+                 (unsigned long)t, (unsigned long)(lat / 1000), (unsigned long)(lat % 1000),
+                 (unsigned long)(lon / 1000), (unsigned long)(lon % 1000));
+        appendSentence(capture, body);
+    }
+    return capture;
+}
+
+}  // namespace
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_checksum(void) {
+    // Satzinhalt zwischen '$' und '*'
+    const char* body = GGA + 1;
+    uint32_t length = strchr(GGA, '*') - body;
+    TEST_ASSERT_EQUAL_HEX8(0x79, NMEAParser::computeChecksum(body, length));
+    // Restlängen 1 bis 3 hinter den ganzen Wörtern
+    TEST_ASSERT_EQUAL_HEX8('A', NMEAParser::computeChecksum("A", 1));
+    TEST_ASSERT_EQUAL_HEX8('A' ^ 'B' ^ 'C', NMEAParser::computeChecksum("ABC", 3));
+    TEST_ASSERT_EQUAL_HEX8('A' ^ 'B' ^ 'C' ^ 'D' ^ 'E', NMEAParser::computeChecksum("ABCDE", 5));
+}
+
+void test_gga(void) {
+    NMEAParser parser;
+    TEST_ASSERT_EQUAL_UINT8(NMEAParser::SENTENCE_GGA, feed(parser, GGA));
+    const NMEAFix& fix = parser.getFix();
+    TEST_ASSERT_TRUE(fix.positionValid);
+    TEST_ASSERT_EQUAL_INT32(481173000, fix.latitude_e7);   // 48° 7,038'
+    TEST_ASSERT_EQUAL_INT32(115166667, fix.longitude_e7);  // 11° 31', gerundet
+    TEST_ASSERT_TRUE(fix.altitudeValid);
+    TEST_ASSERT_EQUAL_INT32(545400, fix.altitude_mm);
+    TEST_ASSERT_EQUAL_UINT8(1, fix.fixQuality);
+    TEST_ASSERT_EQUAL_UINT8(8, fix.satellites);
+    TEST_ASSERT_EQUAL_UINT16(90, fix.hdop_x100);
+    TEST_ASSERT_EQUAL_UINT32(12UL * 3600000UL, fix.timeOfDay_ms());
+}
+
+void test_rmc(void) {
+    NMEAParser parser;
+    TEST_ASSERT_EQUAL_UINT8(NMEAParser::SENTENCE_RMC, feed(parser, RMC));
+    const NMEAFix& fix = parser.getFix();
+    TEST_ASSERT_TRUE(fix.positionValid);
+    TEST_ASSERT_EQUAL_UINT32(500, fix.speed_mknots);
+    TEST_ASSERT_EQUAL_UINT16(8440, fix.course_cdeg);
+    TEST_ASSERT_TRUE(fix.dateValid);
+    TEST_ASSERT_EQUAL_UINT16(2026, fix.year);
+    TEST_ASSERT_EQUAL_UINT8(10, fix.month);
+    TEST_ASSERT_EQUAL_UINT8(16, fix.day);
+}
+
+void test_southern_western_hemisphere(void) {
+    NMEAParser parser;
+    std::string s;
+    appendSentence(s, "GPGGA,235959.50,3351.000,S,15112.600,W,2,10,1.2,-12.5,M,,M,,");
+    TEST_ASSERT_EQUAL_UINT8(NMEAParser::SENTENCE_GGA, feed(parser, s.c_str()));
+    const NMEAFix& fix = parser.getFix();
+    TEST_ASSERT_EQUAL_INT32(-338500000, fix.latitude_e7);
+    TEST_ASSERT_EQUAL_INT32(-1512100000, fix.longitude_e7);
+    TEST_ASSERT_EQUAL_INT32(-12500, fix.altitude_mm);
+    TEST_ASSERT_EQUAL_UINT16(500, fix.millisecond);
+}
+
+void test_checksum_error(void) {
+    NMEAParser parser;
+    std::string s(GGA);
+    s[20] = '9';  // Inhalt ändern, Prüfsumme bleibt
+    TEST_ASSERT_EQUAL_UINT8(0, feed(parser, s.c_str()));
+    TEST_ASSERT_EQUAL_UINT32(1, parser.getChecksumErrorCount());
+    TEST_ASSERT_FALSE(parser.getFix().positionValid);
+}
+
+void test_split_feed(void) {
+    // Byteweise eingespeist muss dasselbe herauskommen wie am Stück
+    NMEAParser whole, bytewise;
+    std::string capture = makeCapture(20);
+    whole.feed((const uint8_t*)capture.data(), capture.size());
+    for (char c : capture) {
+        bytewise.feed((const uint8_t*)&c, 1);
+    }
+    TEST_ASSERT_EQUAL_UINT32(60, whole.getSentenceCount());
+    TEST_ASSERT_EQUAL_UINT32(whole.getSentenceCount(), bytewise.getSentenceCount());
+    TEST_ASSERT_EQUAL_UINT32(0, bytewise.getChecksumErrorCount());
+    TEST_ASSERT_EQUAL_INT32(whole.getFix().latitude_e7, bytewise.getFix().latitude_e7);
+    TEST_ASSERT_EQUAL_INT32(whole.getFix().longitude_e7, bytewise.getFix().longitude_e7);
+    TEST_ASSERT_EQUAL_UINT32(whole.getFix().timeOfDay_ms(), bytewise.getFix().timeOfDay_ms());
+}
+
+void test_garbage_between_sentences(void) {
+    NMEAParser parser;
+    std::string s = "\xB5\x62\x01\x07 noise $GN";  // UBX-Rest und abgebrochener Satz
+    s += GGA;
+    TEST_ASSERT_EQUAL_UINT8(NMEAParser::SENTENCE_GGA, feed(parser, s.c_str()));
+    TEST_ASSERT_TRUE(parser.getFix().positionValid);
+}
+
+void test_gsa_systems(void) {
+    NMEAParser parser;
+    std::string s;
+    appendSentence(s, "GNGSA,A,3,04,05,09,,,,,,,,,,1.8,0.9,1.5,1");
+    appendSentence(s, "GNGSA,A,3,301,305,,,,,,,,,,,1.8,0.9,1.5,3");
+    feed(parser, s.c_str());
+    const NMEAFix& fix = parser.getFix();
+    TEST_ASSERT_EQUAL_UINT8(NMEA_SYSTEM_GPS | NMEA_SYSTEM_GALILEO, fix.systemsUsed);
+    TEST_ASSERT_EQUAL_UINT8(3, fix.fixMode);
+    TEST_ASSERT_EQUAL_UINT16(180, fix.pdop_x100);
+    TEST_ASSERT_EQUAL_UINT16(150, fix.vdop_x100);
+
+    // Ein anderer Satz dazwischen beginnt eine neue Gruppe
+    feed(parser, GGA);
+    s.clear();
+    appendSentence(s, "GLGSA,A,3,65,66,,,,,,,,,,,1.8,0.9,1.5");
+    feed(parser, s.c_str());
+    TEST_ASSERT_EQUAL_UINT8(NMEA_SYSTEM_GLONASS, parser.getFix().systemsUsed);
+}
+
+void test_gst(void) {
+    NMEAParser parser;
+    std::string s;
+    appendSentence(s, "GNGST,120000.00,1.2,3.4,2.1,45.5,2.5,3.0,4.5");
+    TEST_ASSERT_EQUAL_UINT8(NMEAParser::SENTENCE_GST, feed(parser, s.c_str()));
+    const NMEAFix& fix = parser.getFix();
+    TEST_ASSERT_EQUAL_UINT32(12UL * 3600000UL, fix.errorTime_ms);
+    TEST_ASSERT_TRUE(fix.rangeRmsValid);
+    TEST_ASSERT_EQUAL_UINT32(1200, fix.rangeRms_mm);
+    TEST_ASSERT_TRUE(fix.ellipseValid);
+    TEST_ASSERT_EQUAL_UINT32(3400, fix.stdMajor_mm);
+    TEST_ASSERT_EQUAL_UINT32(2100, fix.stdMinor_mm);
+    TEST_ASSERT_EQUAL_UINT16(4550, fix.orient_cdeg);
+    TEST_ASSERT_TRUE(fix.stdValid);
+    TEST_ASSERT_EQUAL_UINT32(4500, fix.stdAlt_mm);
+
+    // Leere Felder: nicht unterstützt
+    s.clear();
+    appendSentence(s, "GNGST,120001.00,1.2,,,,2.5,3.0,4.5");
+    feed(parser, s.c_str());
+    TEST_ASSERT_FALSE(parser.getFix().ellipseValid);
+    TEST_ASSERT_TRUE(parser.getFix().stdValid);
+}
+
+void test_benchmark(void) {
+    const uint32_t epochs = 3600;
+    const uint32_t block = 64;  // Wie beim Leeren des Ringpuffers
+    std::string capture = makeCapture(epochs);
+    const uint8_t* data = (const uint8_t*)capture.data();
+    char line[128];
+
+    NMEAParser parser;
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t offset = 0; offset < capture.size(); offset += block) {
+        uint32_t length = capture.size() - offset < block ? capture.size() - offset : block;
+        parser.feed(data + offset, length);
+    }
+    std::chrono::duration<double, std::nano> parserTime = std::chrono::steady_clock::now() - start;
+    TEST_ASSERT_EQUAL_UINT32(epochs * 3, parser.getSentenceCount());
+    TEST_ASSERT_EQUAL_UINT32(0, parser.getChecksumErrorCount());
+    snprintf(line, sizeof(line), "NMEAParser: %u Bytes, %.1f ns/Byte, %.0f ns/Satz",
+             (unsigned)capture.size(), parserTime.count() / capture.size(), parserTime.count() / (epochs * 3));
+    TEST_MESSAGE(line);
+
+#if HAVE_TINYGPSPLUS
+    TinyGPSPlus gps;
+    start = std::chrono::steady_clock::now();
+    for (char c : capture) {
+        gps.encode(c);
+    }
+    std::chrono::duration<double, std::nano> tinyTime = std::chrono::steady_clock::now() - start;
+    TEST_ASSERT_EQUAL_UINT32(0, gps.failedChecksum());
+    TEST_ASSERT_EQUAL_UINT32(epochs * 3, gps.passedChecksum());
+    // Gleiche Endposition bis auf die Rundung der letzten Stelle
+    TEST_ASSERT_INT_WITHIN(1, parser.getFix().latitude_e7, (int32_t)lround(gps.location.lat() * 1e7));
+    TEST_ASSERT_INT_WITHIN(1, parser.getFix().longitude_e7, (int32_t)lround(gps.location.lng() * 1e7));
+    snprintf(line, sizeof(line), "TinyGPSPlus: %.1f ns/Byte, %.0f ns/Satz",
+             tinyTime.count() / capture.size(), tinyTime.count() / (epochs * 3));
+    TEST_MESSAGE(line);
+#else
+    TEST_MESSAGE("TinyGPSPlus nicht gefunden, kein Vergleich");
+#endif
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_checksum);
+    RUN_TEST(test_gga);
+    RUN_TEST(test_rmc);
+    RUN_TEST(test_southern_western_hemisphere);
+    RUN_TEST(test_checksum_error);
+    RUN_TEST(test_split_feed);
+    RUN_TEST(test_garbage_between_sentences);
+    RUN_TEST(test_gsa_systems);
+    RUN_TEST(test_gst);
+    RUN_TEST(test_benchmark);
+    return UNITY_END();
+}
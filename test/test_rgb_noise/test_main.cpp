@@ -0,0 +1,201 @@
+#include <Arduino.h>
+#include <unity.h>
+#include <chrono>
+#include <math.h>
+#include "LEDAnimationController/LEDAnimationController.h"
+#include "LEDAnimationController/animations/RGBNoiseAnimation.h"
+
+/**
+ * RGBNoise: Mikro-Benchmark der Frame-Berechnung gegen die frühere
+ * Fließkomma-Variante (cos/sin je LED in double, drei inoise16, CHSV) bei
+ * 36, 300 und 1000 LEDs. Beide Varianten nutzen dieselben Rauschfelder, die
+ * Farben dürfen nur durch die Rundung der Kreisposition abweichen.
+ * Auf dem Host dominiert inoise16, das Ergebnis sagt wenig über den Teensy.
+ */
+
+#define BENCHMARK_LED_STEPS 144000   // LED-Berechnungen je Runde, unabhängig von der Streifenlänge
+#define BENCHMARK_ROUNDS 5
+#define REFERENCE_MAX_LEDS 1000
+
+namespace {
+
+CRGB leds[REFERENCE_MAX_LEDS];
+CRGB referenceLeds[REFERENCE_MAX_LEDS];
+float referenceCos[REFERENCE_MAX_LEDS];
+float referenceSin[REFERENCE_MAX_LEDS];
+
+void referenceSetup(uint16_t count) {
+    for (int i = 0; i < count; i++) {
+        float angle = i * 2 * M_PI / count;
+        referenceCos[i] = cos(angle);
+        referenceSin[i] = sin(angle);
+    }
+}
+
+// Frühere Berechnung, Ergebnis direkt als CHSV
+void referenceRender(uint32_t now, uint16_t count) {
+    double angle_offset = double(now) / 32000.0 * 2 * M_PI;
+    now = now << 5;
+    for (int i = 0; i < count; i++) {
+        float x = referenceCos[i] * cos(angle_offset) - referenceSin[i] * sin(angle_offset);
+        float y = referenceCos[i] * sin(angle_offset) + referenceSin[i] * cos(angle_offset);
+        x *= 0xffff * 4;
+        y *= 0xffff * 4;
+        uint16_t noise = inoise16(x, y, now);
+        uint16_t noise2 = inoise16(x, y, 0xfff + now);
+        uint16_t noise3 = inoise16(x, y, 0xffff + now) >> 8;
+        int16_t noise4 = (int16_t)(noise3 * 319 / 255) - 64;
+        if (noise4 < 0) {
+            noise4 = 0;
+        }
+        referenceLeds[i] = CHSV(noise >> 8, MAX(128, noise2 >> 8), noise4);
+    }
+}
+
+AnimationContext makeContext(uint16_t count = NUM_LEDS) {
+    AnimationContext context;
+    context.cmd.Animation = CMD_RGB_NOISE;
+    context.cmd.speed = 10;
+    context.numLeds = count;
+    return context;
+}
+
+bool allBlack(const CRGB* frame, uint16_t count = NUM_LEDS) {
+    for (int i = 0; i < count; i++) {
+        if (frame[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+void setUp(void) {
+    memset(leds, 0, sizeof(leds));
+}
+
+void tearDown(void) {}
+
+void test_frame_depends_only_on_time(void) {
+    AnimationContext context = makeContext();
+    RGBNoiseAnimation noise(leds, &context);
+    TEST_ASSERT_TRUE(noise.setup());
+    TEST_ASSERT_TRUE(noise.startAt(0));
+
+    CRGB first[NUM_LEDS];
+    noise.run(5000);
+    TEST_ASSERT_FALSE(allBlack(leds));
+    memcpy(first, leds, sizeof(first));
+
+    // Ein späterer Frame sieht anders aus
+    noise.run(6000);
+    TEST_ASSERT_FALSE(memcmp(first, leds, sizeof(first)) == 0);
+
+    // Gleiche Zeit ergibt das gleiche Bild, unabhängig vom Verlauf davor
+    RGBNoiseAnimation other(leds, &context);
+    TEST_ASSERT_TRUE(other.setup());
+    TEST_ASSERT_TRUE(other.startAt(0));
+    other.run(5000);
+    TEST_ASSERT_EQUAL_MEMORY(first, leds, sizeof(first));
+}
+
+void test_step_duration_limits_rendering(void) {
+    AnimationContext context = makeContext();
+    RGBNoiseAnimation noise(leds, &context);
+    noise.setup();
+    noise.startAt(1000);
+    noise.run(1000 + context.cmd.speed);
+    CRGB frame[NUM_LEDS];
+    memcpy(frame, leds, sizeof(frame));
+
+    // Innerhalb der Schrittdauer wird nicht neu gezeichnet
+    memset(leds, 0, sizeof(leds));
+    noise.run(1000 + context.cmd.speed + 1);
+    TEST_ASSERT_TRUE(allBlack(leds));
+    noise.run(1000 + 3 * context.cmd.speed);
+    TEST_ASSERT_FALSE(allBlack(leds));
+}
+
+void test_matches_former_rendering(void) {
+    AnimationContext context = makeContext();
+    RGBNoiseAnimation noise(leds, &context);
+    noise.setup();
+    noise.startAt(0);
+    referenceSetup(NUM_LEDS);
+
+    // Über eine ganze Umdrehung, die Position weicht nur in der Rundung ab
+    int maxDiff = 0;
+    uint32_t sumDiff = 0;
+    uint32_t frames = 0;
+    for (uint32_t now = 10; now < 32000; now += 170, frames++) {
+        noise.run(now);
+        referenceRender(now, NUM_LEDS);
+        for (int i = 0; i < NUM_LEDS; i++) {
+            for (uint8_t c = 0; c < 3; c++) {
+                int diff = abs((int)leds[i].raw[c] - (int)referenceLeds[i].raw[c]);
+                maxDiff = max(maxDiff, diff);
+                sumDiff += diff;
+            }
+        }
+    }
+    char line[96];
+    snprintf(line, sizeof(line), "Abweichung zur Fließkomma-Variante: max. %d, Mittel %.3f",
+             maxDiff, (double)sumDiff / (frames * NUM_LEDS * 3));
+    TEST_MESSAGE(line);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(2 * frames * NUM_LEDS * 3, sumDiff);
+}
+
+template <uint16_t COUNT>
+void benchmark() {
+    static_assert(COUNT <= REFERENCE_MAX_LEDS, "Referenzpuffer zu klein");
+    AnimationContext context = makeContext(COUNT);
+    RGBNoiseAnimationN<COUNT> noise(leds, &context);
+    noise.setup();
+    noise.startAt(0);
+    referenceSetup(COUNT);
+    const uint32_t frames = BENCHMARK_LED_STEPS / COUNT;
+
+    // Beide Varianten abwechselnd in mehreren Runden, je Variante zählt die
+    // schnellste Runde, damit Störungen auf dem Host nicht eine Seite treffen
+    double fixedTime = 1e18;
+    double referenceTime = 1e18;
+    for (uint8_t round = 0; round < BENCHMARK_ROUNDS; round++) {
+        noise.startAt(0);
+        auto start = std::chrono::steady_clock::now();
+        for (uint32_t frame = 1; frame <= frames; frame++) {
+            noise.run(frame * context.cmd.speed);
+        }
+        std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+        fixedTime = min(fixedTime, elapsed.count());
+
+        start = std::chrono::steady_clock::now();
+        for (uint32_t frame = 1; frame <= frames; frame++) {
+            referenceRender(frame * context.cmd.speed, COUNT);
+        }
+        elapsed = std::chrono::steady_clock::now() - start;
+        referenceTime = min(referenceTime, elapsed.count());
+    }
+    TEST_ASSERT_FALSE(allBlack(leds, COUNT));
+    TEST_ASSERT_FALSE(allBlack(referenceLeds, COUNT));
+
+    char line[128];
+    snprintf(line, sizeof(line), "%4u LEDs: Festkomma %7.2f us/Frame, Fließkomma %7.2f us/Frame",
+             COUNT, fixedTime / frames / 1000.0, referenceTime / frames / 1000.0);
+    TEST_MESSAGE(line);
+}
+
+void test_benchmark(void) {
+    benchmark<36>();
+    benchmark<300>();
+    benchmark<1000>();
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_frame_depends_only_on_time);
+    RUN_TEST(test_step_duration_limits_rendering);
+    RUN_TEST(test_matches_former_rendering);
+    RUN_TEST(test_benchmark);
+    return UNITY_END();
+}
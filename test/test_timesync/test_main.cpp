@@ -0,0 +1,271 @@
+#include <Arduino.h>
+#include <unity.h>
+#include "BeaconSim.h"
+#include "TimeSync.h"
+
+/**
+ * Simulation von Gangabweichung und Jitter für ClockEstimator und die
+ * PPS-Disziplinierung in TimeSync. Die lokale Uhr ist die simulierte Uhr,
+ * der Empfänger erzeugt seine PPS-Flanken nach einer eigenen Uhr mit
+ * vorgegebener Drift und zufälligem Jitter (reproduzierbar per LCG).
+ */
+
+#define PPS_TEST_PIN 20
+
+namespace {
+
+uint32_t lcgState = 12345;
+
+// Gleichverteilter Jitter in [-amplitude, +amplitude] µs
+int32_t jitter(int32_t amplitude) {
+    lcgState = lcgState * 1664525UL + 1013904223UL;
+    return (int32_t)(lcgState >> 8) % (2 * amplitude + 1) - amplitude;
+}
+
+// Lokaler Zeitpunkt der UTC-Sekunde k bei Gangabweichung drift_ppm (positiv = lokale Uhr geht vor)
+uint64_t localAt(uint64_t start_us, uint32_t k, double drift_ppm) {
+    return start_us + (uint64_t)(k * 1000000.0 * (1.0 + drift_ppm * 1e-6));
+}
+
+}  // namespace
+
+void setUp(void) {
+    lcgState = 12345;
+}
+
+void tearDown(void) {}
+
+void test_estimator_drift_and_offset(void) {
+    ClockEstimator clock;
+    const double drift_ppm = 50.0;           // Lokale Uhr geht 50 ppm vor
+    const int64_t utc0_ns = 1760000000LL * 1000000000LL;
+    const uint64_t start_us = 5000000;
+
+    TEST_ASSERT_FALSE(clock.isValid());
+    for (uint32_t k = 0; k < 3 * TIME_SYNC_WINDOW; k++) {
+        clock.addSample(localAt(start_us, k, drift_ppm) + jitter(2), utc0_ns + (int64_t)k * 1000000000LL);
+    }
+    TEST_ASSERT_EQUAL_UINT8(TIME_SYNC_WINDOW, clock.getSampleCount());
+
+    // Positiv = lokale Uhr zu langsam, hier also negativ
+    TEST_ASSERT_FLOAT_WITHIN(0.5, -drift_ppm, clock.getDriftPpm());
+
+    // Vorhersage eine Sekunde über den letzten Stützpunkt hinaus, ohne Jitter
+    uint32_t k = 3 * TIME_SYNC_WINDOW;
+    uint64_t local = localAt(start_us, k, drift_ppm);
+    int64_t expected_ns = utc0_ns + (int64_t)k * 1000000000LL;
+    TEST_ASSERT_INT64_WITHIN(2000, expected_ns, clock.toReference(local));
+    TEST_ASSERT_INT64_WITHIN(2, local, clock.toLocal(expected_ns));
+}
+
+void test_estimator_rejects_implausible_drift(void) {
+    ClockEstimator clock;
+    // 1000 ppm liegt über TIME_SYNC_MAX_DRIFT, die Schätzung fällt auf 0 zurück
+    for (uint32_t k = 0; k < 8; k++) {
+        clock.addSample(localAt(0, k, -1000.0), (int64_t)k * 1000000000LL);
+    }
+    TEST_ASSERT_FLOAT_WITHIN(0.001, 0.0, clock.getDriftPpm());
+}
+
+void test_estimator_single_sample(void) {
+    ClockEstimator clock;
+    clock.addSample(1000, 7000000);
+    TEST_ASSERT_TRUE(clock.isValid());
+    TEST_ASSERT_FLOAT_WITHIN(0.001, 0.0, clock.getDriftPpm());
+    TEST_ASSERT_EQUAL_INT64(8000000, clock.toReference(2000));
+}
+
+void test_pps_disciplined_time_of_validity(void) {
+    TimeSync timeSync;
+    timeSync.begin(PPS_TEST_PIN);
+
+    const double drift_ppm = -30.0;          // Lokale Uhr geht 30 ppm nach
+    const int64_t utc0_ns = 1760000000LL * 1000000000LL;
+    const uint64_t start_us = BeaconSim::now() + 1000000;
+    const uint32_t seconds = 40;
+    int64_t maxError_us = 0;
+
+    for (uint32_t k = 0; k < seconds; k++) {
+        // PPS-Flanke mit ±3 µs Jitter, 100 ms Pulsbreite
+        uint64_t edge = localAt(start_us, k, drift_ppm) + jitter(3);
+        BeaconSim::setPin(PPS_TEST_PIN, HIGH, edge);
+        BeaconSim::setPin(PPS_TEST_PIN, LOW, edge + 100000);
+
+        // 5 Epochen pro Sekunde, die Daten kommen 80 ms nach der Gültigkeit an
+        for (uint32_t epoch = 0; epoch < 5; epoch++) {
+            int64_t utc_ns = utc0_ns + (int64_t)k * 1000000000LL + epoch * 200000000LL;
+            uint64_t valid = localAt(start_us, k, drift_ppm) + (uint64_t)(epoch * 200000 * (1.0 + drift_ppm * 1e-6));
+            BeaconSim::advanceTo(valid + 80000);
+            uint32_t arrival = micros();
+            timeSync.addGnssEpoch(utc_ns, arrival, TimeSync::latchPPS());
+
+            if (timeSync.getPPSClock().getSampleCount() >= TIME_SYNC_WINDOW) {
+                int64_t error = (int64_t)(timeSync.timeOfValidity(utc_ns, arrival) - valid);
+                if (error < 0) {
+                    error = -error;
+                }
+                if (error > maxError_us) {
+                    maxError_us = error;
+                }
+            }
+        }
+    }
+
+    TEST_ASSERT_TRUE(timeSync.isPPSDisciplined());
+    TEST_ASSERT_EQUAL_UINT32(seconds, timeSync.getPPSCount());
+    TEST_ASSERT_FLOAT_WITHIN(0.5, -drift_ppm, timeSync.getPPSClock().getDriftPpm());
+    // Jitter der Flanke plus 1 µs für den Uhrzugriff in der ISR
+    TEST_ASSERT_LESS_OR_EQUAL(4, maxError_us);
+
+    char line[96];
+    snprintf(line, sizeof(line), "Drift %.3f ppm, max. Fehler der Gültigkeitszeit %ld us",
+             timeSync.getPPSClock().getDriftPpm(), (long)maxError_us);
+    TEST_MESSAGE(line);
+}
+
+void test_estimator_rejects_outliers(void) {
+    ClockEstimator clock;
+    const int64_t utc0_ns = 1760000000LL * 1000000000LL;
+    for (uint32_t k = 0; k < 8; k++) {
+        TEST_ASSERT_TRUE(clock.addSample(localAt(0, k, 20.0), utc0_ns + (int64_t)k * 1000000000LL));
+    }
+    float drift = clock.getDriftPpm();
+
+    // Eine Sekunde daneben, z.B. Flanke der falschen UTC-Sekunde zugeordnet
+    TEST_ASSERT_FALSE(clock.addSample(localAt(0, 8, 20.0), utc0_ns + 7 * 1000000000LL));
+    TEST_ASSERT_EQUAL_UINT32(1, clock.getRejectedSamples());
+    TEST_ASSERT_EQUAL_UINT8(8, clock.getSampleCount());
+    TEST_ASSERT_FLOAT_WITHIN(0.001, drift, clock.getDriftPpm());
+    TEST_ASSERT_TRUE(clock.addSample(localAt(0, 9, 20.0), utc0_ns + 9 * 1000000000LL));
+
+    // Springt die Referenz dauerhaft, beginnt die Schätzung nach TIME_SYNC_MAX_OUTLIERS neu
+    const int64_t jump_ns = 3600LL * 1000000000LL;
+    for (uint32_t k = 10; k < 10 + TIME_SYNC_MAX_OUTLIERS - 1; k++) {
+        TEST_ASSERT_FALSE(clock.addSample(localAt(0, k, 20.0), utc0_ns + jump_ns + (int64_t)k * 1000000000LL));
+    }
+    uint32_t k = 10 + TIME_SYNC_MAX_OUTLIERS - 1;
+    TEST_ASSERT_TRUE(clock.addSample(localAt(0, k, 20.0), utc0_ns + jump_ns + (int64_t)k * 1000000000LL));
+    TEST_ASSERT_EQUAL_UINT8(1, clock.getSampleCount());
+    TEST_ASSERT_EQUAL_INT64(utc0_ns + jump_ns + (int64_t)k * 1000000000LL, clock.toReference(localAt(0, k, 20.0)));
+}
+
+// Epochen laufen im Empfangspuffer auf und werden erst nach einer Blockade
+// am Stück übergeben, wie GPSManager::update() einen Rückstand abarbeitet
+void runBacklog(TimeSync& timeSync, bool latchPerBurst, int64_t& maxError_us) {
+    const double drift_ppm = 40.0;
+    const int64_t utc0_ns = 1760000000LL * 1000000000LL;
+    const uint64_t start_us = BeaconSim::now() + 1000000;
+    const uint32_t seconds = 40;
+    const uint32_t backlog = 6;          // Sekunden ohne update()
+
+    struct Pending {
+        int64_t utc_ns;
+        uint32_t arrival;
+        TimeSync::PPSEdge pps;
+        uint64_t valid;
+    } pending[backlog];
+    uint32_t pendingCount = 0;
+    maxError_us = 0;
+
+    for (uint32_t k = 0; k < seconds; k++) {
+        uint64_t edge = localAt(start_us, k, drift_ppm);
+        BeaconSim::setPin(PPS_TEST_PIN, HIGH, edge);
+        BeaconSim::setPin(PPS_TEST_PIN, LOW, edge + 100000);
+
+        // Eine Epoche pro Sekunde, Burst 80 ms nach der Gültigkeit; die Empfangs-ISR erfasst die Flanke
+        BeaconSim::advanceTo(edge + 80000);
+        pending[pendingCount++] = {utc0_ns + (int64_t)k * 1000000000LL, micros(), TimeSync::latchPPS(), edge};
+
+        // Ab Sekunde 20 blockiert die Hauptschleife jeweils für backlog Sekunden
+        if (k >= 20 && pendingCount < backlog) {
+            continue;
+        }
+        const Pending& newest = pending[pendingCount - 1];
+        for (uint32_t i = 0; i < pendingCount; i++) {
+            const Pending& p = pending[i];
+            if (latchPerBurst) {
+                timeSync.addGnssEpoch(p.utc_ns, p.arrival, p.pps);
+            } else {
+                timeSync.addGnssEpoch(p.utc_ns, newest.arrival, newest.pps);
+            }
+            if (timeSync.isPPSDisciplined()) {
+                int64_t error = (int64_t)(timeSync.timeOfValidity(p.utc_ns, p.arrival) - p.valid);
+                if (error < 0) {
+                    error = -error;
+                }
+                if (error > maxError_us) {
+                    maxError_us = error;
+                }
+            }
+        }
+        pendingCount = 0;
+    }
+}
+
+void test_pps_backlog_keeps_epoch_pairing(void) {
+    TimeSync timeSync;
+    timeSync.begin(PPS_TEST_PIN);
+    int64_t maxError_us;
+    runBacklog(timeSync, true, maxError_us);
+
+    TEST_ASSERT_EQUAL_UINT32(0, timeSync.getPPSClock().getRejectedSamples());
+    TEST_ASSERT_FLOAT_WITHIN(0.5, -40.0, timeSync.getPPSClock().getDriftPpm());
+    TEST_ASSERT_LESS_OR_EQUAL(2, maxError_us);
+}
+
+void test_pps_newest_edge_is_rejected_in_backlog(void) {
+    // Neueste Flanke und neuester Burst für alle Epochen: die älteste Epoche
+    // ist um ganze Sekunden verschoben, die Ausreißerprüfung verwirft sie
+    TimeSync timeSync;
+    timeSync.begin(PPS_TEST_PIN);
+    int64_t maxError_us;
+    runBacklog(timeSync, false, maxError_us);
+
+    TEST_ASSERT_GREATER_THAN_UINT32(0, timeSync.getPPSClock().getRejectedSamples());
+    TEST_ASSERT_FLOAT_WITHIN(0.5, -40.0, timeSync.getPPSClock().getDriftPpm());
+    TEST_ASSERT_LESS_OR_EQUAL(2, maxError_us);
+}
+
+void test_without_pps_uses_arrival(void) {
+    TimeSync timeSync;
+    timeSync.begin(-1);
+    uint32_t arrival = micros();
+    uint64_t arrivalTime = BeaconSim::now();
+    BeaconSim::advance(5000);
+    TEST_ASSERT_FALSE(timeSync.isPPSDisciplined());
+    TEST_ASSERT_EQUAL_UINT64(arrivalTime, timeSync.timeOfValidity(1000000000LL, arrival));
+}
+
+void test_micros_extension_across_wrap(void) {
+    TimeSync timeSync;
+    timeSync.begin(-1);
+    // Bis kurz vor den Überlauf von micros(), dabei regelmäßig lesen
+    uint64_t wrap = (BeaconSim::now() | 0xFFFFFFFFULL) + 1;
+    while (BeaconSim::now() + 600000000ULL < wrap) {
+        BeaconSim::advance(600000000ULL);
+        timeSync.nowMicros();
+    }
+    BeaconSim::advanceTo(wrap - 100);
+    uint32_t captured = micros();
+    uint64_t before = timeSync.nowMicros();
+    BeaconSim::advance(200);
+    uint64_t after = timeSync.nowMicros();
+    TEST_ASSERT_EQUAL_UINT64(BeaconSim::now(), after);
+    TEST_ASSERT_TRUE(before < wrap);
+    TEST_ASSERT_TRUE(after > wrap);
+    TEST_ASSERT_EQUAL_UINT64(wrap - 100 + 1, timeSync.extendMicros(captured));
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_estimator_drift_and_offset);
+    RUN_TEST(test_estimator_rejects_implausible_drift);
+    RUN_TEST(test_estimator_single_sample);
+    RUN_TEST(test_pps_disciplined_time_of_validity);
+    RUN_TEST(test_estimator_rejects_outliers);
+    RUN_TEST(test_pps_backlog_keeps_epoch_pairing);
+    RUN_TEST(test_pps_newest_edge_is_rejected_in_backlog);
+    RUN_TEST(test_without_pps_uses_arrival);
+    RUN_TEST(test_micros_extension_across_wrap);
+    return UNITY_END();
+}
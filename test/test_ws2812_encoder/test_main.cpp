@@ -0,0 +1,162 @@
+#include <Arduino.h>
+#include <unity.h>
+#include <chrono>
+#include "BeaconSim.h"
+#include "WS2812SerialHW.h"
+
+/**
+ * Tabellengestützter WS2812-Kodierer gegen die bitweise Kodierung der
+ * ursprünglichen Bibliothek: gleiche Ausgabe für alle Farbwerte, mit und
+ * ohne Helligkeit, dazu ein Zeitvergleich auf dem Host für Streifen mit
+ * 36 bis 4096 LEDs.
+ *
+ * Diese Kopie der Bibliothek setzt config fest auf 3 (GBR), getestet wird
+ * daher diese Reihenfolge.
+ */
+
+#define ENCODER_LEDS 300
+#define BENCHMARK_MAX_LEDS 4096
+#define BENCHMARK_LED_STEPS 600000   // Kodierte LEDs je Größe und Verfahren
+
+namespace {
+
+// Für den Zeitvergleich groß genug für den längsten Streifen, die Vergleiche nutzen ENCODER_LEDS
+uint8_t drawBuffer[BENCHMARK_MAX_LEDS * 3];
+uint8_t frameBuffer[BENCHMARK_MAX_LEDS * 12];
+uint8_t referenceBuffer[BENCHMARK_MAX_LEDS * 12];
+
+// Bitweise Kodierung wie vor der Tabelle: Kanäle in Sendereihenfolge
+// zu einem Wort zusammensetzen, dann je 2 Bit ein UART-Byte
+void referenceEncode(const uint8_t* draw, uint16_t leds, uint8_t brightness, uint8_t* fb) {
+    const uint32_t mult = brightness + 1;
+    for (uint16_t i = 0; i < leds; i++) {
+        uint8_t b = draw[i * 3 + 0];
+        uint8_t g = draw[i * 3 + 1];
+        uint8_t r = draw[i * 3 + 2];
+        if (brightness != 255) {
+            r = (r * mult) >> 8;
+            g = (g * mult) >> 8;
+            b = (b * mult) >> 8;
+        }
+        uint32_t n = (g << 16) | (b << 8) | r;    // WS2812_GBR
+        for (uint8_t k = 0; k < 12; k++) {
+            uint8_t x = 0x08;
+            if (!(n & 0x00800000)) x |= 0x07;
+            if (!(n & 0x00400000)) x |= 0xE0;
+            n <<= 2;
+            *fb++ = x;
+        }
+    }
+}
+
+// Kodiert über den öffentlichen Weg (tryShow), der DMA-Ersatz liefert den Puffer
+const uint8_t* encodeWithLibrary(WS2812SerialHW& leds, uint16_t count = ENCODER_LEDS) {
+    DMAChannel::last->complete();
+    BeaconSim::advance(count * 30 + 300 + 1);
+    TEST_ASSERT_TRUE(leds.tryShow());
+    return DMAChannel::last->source;
+}
+
+// Zeichenpuffer mit allen Bytewerten in jeder Kanalposition
+void fillAllValues() {
+    for (uint32_t i = 0; i < sizeof(drawBuffer); i++) {
+        drawBuffer[i] = (uint8_t)(i * 7 + i / 256);
+    }
+}
+
+}  // namespace
+
+void setUp(void) {
+    DMA_ERQ = 0;
+    fillAllValues();
+}
+
+void tearDown(void) {}
+
+void test_full_brightness_matches_reference(void) {
+    WS2812SerialHW leds(ENCODER_LEDS, frameBuffer, drawBuffer, 1, WS2812_GBR);
+    TEST_ASSERT_TRUE(leds.begin());
+    fillAllValues();    // begin() löscht den Zeichenpuffer
+    const uint8_t* wire = encodeWithLibrary(leds);
+    referenceEncode(drawBuffer, ENCODER_LEDS, 255, referenceBuffer);
+    TEST_ASSERT_EQUAL_MEMORY(referenceBuffer, wire, ENCODER_LEDS * 12);
+}
+
+void test_brightness_matches_reference(void) {
+    WS2812SerialHW leds(ENCODER_LEDS, frameBuffer, drawBuffer, 1, WS2812_GBR);
+    TEST_ASSERT_TRUE(leds.begin());
+    const uint8_t levels[] = { 0, 1, 64, 128, 200, 254 };
+    for (uint8_t level : levels) {
+        fillAllValues();
+        leds.setBrightness(level);
+        const uint8_t* wire = encodeWithLibrary(leds);
+        referenceEncode(drawBuffer, ENCODER_LEDS, level, referenceBuffer);
+        TEST_ASSERT_EQUAL_MEMORY_MESSAGE(referenceBuffer, wire, ENCODER_LEDS * 12, "Helligkeit");
+    }
+}
+
+void test_zero_and_full_bytes(void) {
+    // 0x00 -> vier Bytes 0xEF, 0xFF -> vier Bytes 0x08 (invertierte UART-Leitung)
+    WS2812SerialHW leds(1, frameBuffer, drawBuffer, 1, WS2812_GBR);
+    TEST_ASSERT_TRUE(leds.begin());
+    leds.setPixel(0, 0x00FF00);   // Grün voll, Rot und Blau aus
+    const uint8_t* wire = encodeWithLibrary(leds);
+    const uint8_t expected[12] = {
+        0x08, 0x08, 0x08, 0x08,   // G
+        0xEF, 0xEF, 0xEF, 0xEF,   // B
+        0xEF, 0xEF, 0xEF, 0xEF    // R
+    };
+    TEST_ASSERT_EQUAL_MEMORY(expected, wire, sizeof(expected));
+}
+
+// Zeitvergleich für einen Streifen mit count LEDs, gleiche Zahl kodierter LEDs für jede Größe
+void benchmark(uint16_t count) {
+    WS2812SerialHW leds(count, frameBuffer, drawBuffer, 1, WS2812_GBR);
+    TEST_ASSERT_TRUE(leds.begin());
+    const uint32_t frames = BENCHMARK_LED_STEPS / count;
+    const uint8_t levels[] = { 255, 128 };
+    char line[128];
+
+    for (uint8_t level : levels) {
+        fillAllValues();
+        leds.setBrightness(level);
+
+        // Enthält je Frame auch tryShow(), das Abschließen der DMA und die Uhr der Simulation
+        auto start = std::chrono::steady_clock::now();
+        for (uint32_t frame = 0; frame < frames; frame++) {
+            drawBuffer[frame % (count * 3)]++;
+            encodeWithLibrary(leds, count);
+        }
+        std::chrono::duration<double, std::nano> tableTime = std::chrono::steady_clock::now() - start;
+        referenceEncode(drawBuffer, count, level, referenceBuffer);
+        TEST_ASSERT_EQUAL_MEMORY(referenceBuffer, DMAChannel::last->source, count * 12);
+
+        start = std::chrono::steady_clock::now();
+        for (uint32_t frame = 0; frame < frames; frame++) {
+            drawBuffer[frame % (count * 3)]++;
+            referenceEncode(drawBuffer, count, level, referenceBuffer);
+        }
+        std::chrono::duration<double, std::nano> referenceTime = std::chrono::steady_clock::now() - start;
+
+        snprintf(line, sizeof(line), "Helligkeit %u, %u LEDs: Tabelle %.2f ns/LED, bitweise %.2f ns/LED",
+                 level, count, tableTime.count() / (frames * count),
+                 referenceTime.count() / (frames * count));
+        TEST_MESSAGE(line);
+    }
+}
+
+void test_benchmark(void) {
+    const uint16_t counts[] = { 36, 144, 1024, BENCHMARK_MAX_LEDS };
+    for (uint16_t count : counts) {
+        benchmark(count);
+    }
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_full_brightness_matches_reference);
+    RUN_TEST(test_brightness_matches_reference);
+    RUN_TEST(test_zero_and_full_bytes);
+    RUN_TEST(test_benchmark);
+    return UNITY_END();
+}
@@ -0,0 +1,145 @@
+#include <Arduino.h>
+#include <unity.h>
+#include "BeaconSim.h"
+#include "WS2812SerialHW.h"
+
+/**
+ * WS2812Serial: nicht blockierendes tryShow() mit einfachem und doppeltem
+ * Frame-Puffer gegen einen DMA-Ersatz. Die Übertragung läuft, bis der Test
+ * sie abschließt, danach gilt die Reset-Pause der LEDs (30 µs je LED + 300 µs).
+ */
+
+#define TEST_LEDS 16
+#define TEST_PIN 1              // Serial1
+
+namespace {
+
+uint8_t drawBuffer[TEST_LEDS * 3];
+uint8_t frameBuffer[TEST_LEDS * 12];
+uint8_t backBuffer[TEST_LEDS * 12];
+
+// Übertragung beenden und die Reset-Pause abwarten
+void finishFrame() {
+    DMAChannel::last->complete();
+    BeaconSim::advance(TEST_LEDS * 30 + 300 + 1);
+}
+
+// Vier UART-Bytes zurück in ein Farbbyte, Umkehrung der Kodierung
+uint8_t decodeByte(const uint8_t* p) {
+    uint8_t value = 0;
+    for (uint8_t i = 0; i < 4; i++) {
+        value <<= 2;
+        if ((p[i] & 0x07) == 0) value |= 0x02;
+        if ((p[i] & 0xE0) == 0) value |= 0x01;
+    }
+    return value;
+}
+
+}  // namespace
+
+void setUp(void) {
+    memset(frameBuffer, 0, sizeof(frameBuffer));
+    memset(backBuffer, 0, sizeof(backBuffer));
+    DMA_ERQ = 0;
+    BeaconSim::advance(100000);
+}
+
+void tearDown(void) {}
+
+void test_begin_configures_dma(void) {
+    WS2812SerialHW leds(TEST_LEDS, frameBuffer, drawBuffer, TEST_PIN, WS2812_GRB);
+    TEST_ASSERT_TRUE(leds.begin());
+    TEST_ASSERT_NOT_NULL(DMAChannel::last);
+    TEST_ASSERT_EQUAL_UINT8(DMAMUX_SOURCE_UART0_TX, DMAChannel::last->trigger);
+    TEST_ASSERT_TRUE(DMAChannel::last->target == &KINETISK_UART0.D);
+    TEST_ASSERT_FALSE(DMAChannel::last->active());
+
+    WS2812SerialHW unsupported(TEST_LEDS, frameBuffer, drawBuffer, 2, WS2812_GRB);
+    TEST_ASSERT_FALSE(unsupported.begin());
+}
+
+void test_single_buffer_rejects_while_busy(void) {
+    WS2812SerialHW leds(TEST_LEDS, frameBuffer, drawBuffer, TEST_PIN, WS2812_GRB);
+    TEST_ASSERT_TRUE(leds.begin());
+    DMAChannel* dma = DMAChannel::last;
+
+    leds.setPixel(0, 0x102030);
+    TEST_ASSERT_TRUE(leds.tryShow());
+    TEST_ASSERT_EQUAL_UINT32(1, dma->transfers);
+    TEST_ASSERT_TRUE(dma->source == frameBuffer);
+    TEST_ASSERT_EQUAL_UINT32(TEST_LEDS * 12, dma->count);
+
+    // DMA läuft: der einzige Frame-Puffer darf nicht überschrieben werden
+    TEST_ASSERT_FALSE(leds.tryShow());
+    dma->complete();
+    // Reset-Pause noch nicht vorbei
+    TEST_ASSERT_FALSE(leds.tryShow());
+    BeaconSim::advance(TEST_LEDS * 30 + 300 + 1);
+    TEST_ASSERT_TRUE(leds.tryShow());
+    TEST_ASSERT_EQUAL_UINT32(2, dma->transfers);
+}
+
+void test_double_buffer_queues_one_frame(void) {
+    WS2812SerialHW leds(TEST_LEDS, frameBuffer, backBuffer, drawBuffer, TEST_PIN, WS2812_GRB);
+    TEST_ASSERT_TRUE(leds.begin());
+    DMAChannel* dma = DMAChannel::last;
+
+    // Frame A geht sofort auf die Leitung
+    leds.setPixel(0, 0x0000AA);
+    TEST_ASSERT_TRUE(leds.tryShow());
+    TEST_ASSERT_FALSE(leds.framePending());
+    TEST_ASSERT_EQUAL_UINT32(1, dma->transfers);
+    const uint8_t* wireA = dma->source;
+    uint8_t copyA[TEST_LEDS * 12];
+    memcpy(copyA, wireA, sizeof(copyA));
+
+    // Frame B wird während der Übertragung kodiert und wartet
+    leds.setPixel(0, 0x0000BB);
+    TEST_ASSERT_TRUE(leds.tryShow());
+    TEST_ASSERT_TRUE(leds.framePending());
+    TEST_ASSERT_EQUAL_UINT32(1, dma->transfers);
+    TEST_ASSERT_EQUAL_MEMORY(copyA, wireA, sizeof(copyA));
+
+    // Für Frame C ist kein Puffer frei, nichts wird verworfen
+    leds.setPixel(0, 0x0000CC);
+    TEST_ASSERT_FALSE(leds.tryShow());
+    TEST_ASSERT_FALSE(leds.poll());
+
+    finishFrame();
+    TEST_ASSERT_TRUE(leds.poll());
+    TEST_ASSERT_FALSE(leds.framePending());
+    TEST_ASSERT_EQUAL_UINT32(2, dma->transfers);
+    TEST_ASSERT_TRUE(dma->source != wireA);
+    // Blau ist bei GBR das zweite Byte auf der Leitung
+    TEST_ASSERT_EQUAL_HEX8(0xBB, decodeByte(dma->source + 4));
+
+    // Jetzt ist wieder Platz für Frame C
+    TEST_ASSERT_TRUE(leds.tryShow());
+    TEST_ASSERT_TRUE(leds.framePending());
+    finishFrame();
+    TEST_ASSERT_TRUE(leds.poll());
+    TEST_ASSERT_EQUAL_HEX8(0xCC, decodeByte(dma->source + 4));
+}
+
+void test_try_show_does_not_wait(void) {
+    WS2812SerialHW leds(TEST_LEDS, frameBuffer, backBuffer, drawBuffer, TEST_PIN, WS2812_GRB);
+    TEST_ASSERT_TRUE(leds.begin());
+    TEST_ASSERT_TRUE(leds.tryShow());
+    TEST_ASSERT_TRUE(leds.tryShow());
+
+    // Belegte Leitung und voller Puffer: sofort zurück, nur Uhrzugriffe kosten Zeit
+    uint64_t start = BeaconSim::now();
+    for (uint8_t i = 0; i < 100; i++) {
+        TEST_ASSERT_FALSE(leds.tryShow());
+    }
+    TEST_ASSERT_LESS_OR_EQUAL(100 * 4 * SIM_CLOCK_READ_US, (uint32_t)(BeaconSim::now() - start));
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_begin_configures_dma);
+    RUN_TEST(test_single_buffer_rejects_while_busy);
+    RUN_TEST(test_double_buffer_queues_one_frame);
+    RUN_TEST(test_try_show_does_not_wait);
+    return UNITY_END();
+}